@@ -83,6 +83,15 @@ android {
     // 仅影响 testDebugUnitTest，对 instrumented test 和运行时无任何作用。
     testOptions {
         unitTests.isReturnDefaultValues = true
+        // CHelperCoreNativeTest 在电脑的 JVM 上加载 CHelperAndroid，需要先用 CHelper-Core 的 CMake 编译它（非安卓平台会使用 include_android 中的头文件），
+        // 并用 CHelperResourceGenerator 生成资源包，缺少任何一个都会跳过这个测试。
+        unitTests.all {
+            it.systemProperty(
+                "java.library.path",
+                System.getenv("CHELPER_HOST_LIBRARY_DIR") ?: rootProject.file("../CHelper-Core/cmake-build-release").absolutePath
+            )
+            it.systemProperty("chelper.cpackDir", rootProject.file("../CHelper-Resource/generated/cpack").absolutePath)
+        }
     }
 
     ndkVersion = "29.0.14206865"
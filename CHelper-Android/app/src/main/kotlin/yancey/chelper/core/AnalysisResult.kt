@@ -0,0 +1,169 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package yancey.chelper.core
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * c++内核一次性写入的分析结果，格式见c++的AnalysisBuffer
+ * 读取时才解码，只在下一次调用analyze或关闭内核之前有效，失效后读取会抛出IllegalStateException
+ *
+ * @param isValid 缓冲区是否还没有被覆盖或释放
+ */
+class AnalysisResult(buffer: ByteBuffer, private val isValid: () -> Boolean = { true }) {
+    private val buffer: ByteBuffer = buffer.order(ByteOrder.nativeOrder())
+
+    /**
+     * 数据格式的版本
+     */
+    val version: Int
+        get() {
+            checkValid()
+            return buffer.getInt(0)
+        }
+
+    /**
+     * 缓冲区中包含的结果
+     */
+    val flags: Int
+        get() {
+            checkValid()
+            return buffer.getInt(4)
+        }
+
+    /**
+     * 当前命令的语法结构，没有请求时为null
+     */
+    val structure: String?
+        get() = readStringSection(SECTION_STRUCTURE)
+
+    /**
+     * 当前命令参数的介绍，没有请求时为null
+     */
+    val paramHint: String?
+        get() = readStringSection(SECTION_PARAM_HINT)
+
+    /**
+     * 错误原因的数量
+     */
+    val errorReasonCount: Int
+        get() = readCount(SECTION_ERROR_REASONS)
+
+    /**
+     * 获取其中一个错误原因
+     *
+     * @param which 第几个错误原因，从0开始
+     */
+    fun getErrorReason(which: Int): ErrorReason {
+        val record = recordOffset(SECTION_ERROR_REASONS, which, errorReasonCount)
+        return ErrorReason().apply {
+            start = buffer.getInt(record)
+            end = buffer.getInt(record + 4)
+            errorReason = readString(buffer.getInt(record + 8), buffer.getInt(record + 12))
+        }
+    }
+
+    /**
+     * 补全提示的数量
+     */
+    val suggestionCount: Int
+        get() = readCount(SECTION_SUGGESTIONS)
+
+    /**
+     * 获取其中一个补全提示
+     *
+     * @param which 第几个补全提示，从0开始
+     */
+    fun getSuggestion(which: Int): Suggestion {
+        val record = recordOffset(SECTION_SUGGESTIONS, which, suggestionCount)
+        return Suggestion().apply {
+            name = readString(buffer.getInt(record), buffer.getInt(record + 4))
+            // 缓冲区中没有介绍和介绍为空都写成长度为0的字符串
+            description = readString(buffer.getInt(record + 8), buffer.getInt(record + 12))
+        }
+    }
+
+    /**
+     * 每个字符的类型，没有请求时为null
+     */
+    val syntaxTokens: IntArray?
+        get() {
+            val offset = sectionOffset(SECTION_SYNTAX_TOKENS)
+            if (offset == 0) {
+                return null
+            }
+            val size = buffer.getInt(offset)
+            return IntArray(size) { buffer.get(offset + 4 + it).toInt() and 0xFF }
+        }
+
+    private fun checkValid() {
+        check(isValid()) { "analysis result is outdated, call analyze again" }
+    }
+
+    private fun sectionOffset(section: Int): Int {
+        checkValid()
+        return buffer.getInt(16 + 8 * section)
+    }
+
+    private fun readCount(section: Int): Int {
+        val offset = sectionOffset(section)
+        return if (offset == 0) 0 else buffer.getInt(offset)
+    }
+
+    private fun recordOffset(section: Int, which: Int, count: Int): Int {
+        if (which < 0 || which >= count) {
+            throw IndexOutOfBoundsException("index: $which, size: $count")
+        }
+        return sectionOffset(section) + 4 + which * RECORD_SIZE
+    }
+
+    private fun readStringSection(section: Int): String? {
+        val offset = sectionOffset(section)
+        if (offset == 0) {
+            return null
+        }
+        return readString(offset + 4, buffer.getInt(offset))
+    }
+
+    private fun readString(offset: Int, length: Int): String {
+        val view = buffer.duplicate().order(buffer.order())
+        view.position(offset)
+        view.limit(offset + length * 2)
+        return view.asCharBuffer().toString()
+    }
+
+    companion object {
+        const val FLAG_STRUCTURE = 1 shl 0
+        const val FLAG_PARAM_HINT = 1 shl 1
+        const val FLAG_ERROR_REASONS = 1 shl 2
+        const val FLAG_SUGGESTIONS = 1 shl 3
+        const val FLAG_SYNTAX_TOKENS = 1 shl 4
+        const val FLAG_ALL = FLAG_STRUCTURE or FLAG_PARAM_HINT or FLAG_ERROR_REASONS or FLAG_SUGGESTIONS or FLAG_SYNTAX_TOKENS
+
+        private const val SECTION_STRUCTURE = 0
+        private const val SECTION_PARAM_HINT = 1
+        private const val SECTION_ERROR_REASONS = 2
+        private const val SECTION_SUGGESTIONS = 3
+        private const val SECTION_SYNTAX_TOKENS = 4
+
+        // 错误原因和补全提示的每条记录都是4个int
+        private const val RECORD_SIZE = 16
+    }
+}
@@ -22,6 +22,7 @@ import android.content.Context
 import android.content.res.AssetManager
 import com.hjq.toast.Toaster
 import java.io.Closeable
+import java.nio.ByteBuffer
 
 /**
  * 软件的内核，与c++代码交互
@@ -41,6 +42,11 @@ class CHelperCore private constructor(
      */
     private var pointer: Long = 0
 
+    /**
+     * 每次调用analyze都会覆盖上一次的结果，用来判断AnalysisResult是否已经失效
+     */
+    private var analysisGeneration: Long = 0
+
     /**
      * @param assetManager 软件内置资源管理器
      * @param path         资源包路径
@@ -176,6 +182,22 @@ class CHelperCore private constructor(
             return getColors0(pointer)
         }
 
+    /**
+     * 一次性获取当前命令的多个结果，c++内核把结果写入同一块内存，读取时才解码
+     * 
+     * @param flags 需要的结果，见AnalysisResult中的FLAG_*
+     * @return 分析结果，在下一次调用这个方法或关闭内核之前有效，失效后读取会抛出IllegalStateException
+     */
+    fun analyze(flags: Int = AnalysisResult.FLAG_ALL): AnalysisResult? {
+        if (pointer == 0L) {
+            return null
+        }
+        val generation = ++analysisGeneration
+        return analyze0(pointer, flags)?.let {
+            AnalysisResult(it) { pointer != 0L && analysisGeneration == generation }
+        }
+    }
+
     /**
      * 关闭内核，释放内存
      */
@@ -350,6 +372,16 @@ class CHelperCore private constructor(
         @JvmStatic
         private external fun getColors0(pointer: Long): IntArray?
 
+        /**
+         * 一次性获取当前命令的多个结果
+         * 
+         * @param pointer 内核的内存地址
+         * @param flags   需要的结果
+         * @return 直接指向c++内存的缓冲区
+         */
+        @JvmStatic
+        private external fun analyze0(pointer: Long, flags: Int): ByteBuffer?
+
         /**
          * 初始化"旧命令转新命令"功能
          * 
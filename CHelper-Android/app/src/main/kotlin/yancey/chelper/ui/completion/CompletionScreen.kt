@@ -421,8 +421,8 @@ fun CompletionScreen(
                                 val realIndex = suggestionIndex - 1
                                 val suggestionText =
                                     remember(viewModel.suggestionsUpdateTimes, realIndex) {
-                                        val suggestion = viewModel.core?.getSuggestion(realIndex)
-                                        if (suggestion != null && suggestion.description != null) {
+                                        val suggestion = viewModel.getSuggestion(realIndex)
+                                        if (suggestion != null && !suggestion.description.isNullOrEmpty()) {
                                             (suggestion.name
                                                 ?: "") + " - " + suggestion.description!!
                                         } else {
@@ -462,7 +462,7 @@ fun CompletionScreen(
                             ) {
                                 val suggestion =
                                     remember(viewModel.suggestionsUpdateTimes, suggestionIndex) {
-                                        viewModel.core?.getSuggestion(suggestionIndex)
+                                        viewModel.getSuggestion(suggestionIndex)
                                     }
                                 suggestion?.name?.let {
                                     Text(
@@ -474,7 +474,7 @@ fun CompletionScreen(
                                         )
                                     )
                                 }
-                                suggestion?.description?.let {
+                                suggestion?.description?.takeIf { it.isNotEmpty() }?.let {
                                     Text(
                                         text = it,
                                         modifier = Modifier
@@ -34,9 +34,11 @@ import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.launch
 import kotlinx.coroutines.withContext
 import yancey.chelper.android.util.MonitorUtil
+import yancey.chelper.core.AnalysisResult
 import yancey.chelper.core.CHelperCore
 import yancey.chelper.core.ErrorReason
 import yancey.chelper.core.SelectedString
+import yancey.chelper.core.Suggestion
 import yancey.chelper.data.CopyHistoryDataStore
 import java.io.BufferedInputStream
 import java.io.BufferedOutputStream
@@ -60,6 +62,8 @@ class CompletionViewModel(application: Application) : AndroidViewModel(applicati
     var suggestionsUpdateTimes by mutableIntStateOf(0)
     var syntaxHighlightTokens by mutableStateOf<IntArray?>(null)
     var core: CHelperCore? = null
+    // 最近一次分析的结果，补全提示显示时才从中读取
+    private var analysisResult: AnalysisResult? = null
     var lastInput: SelectedString = SelectedString("", 0, 0)
     var syntaxHighlightMaxLength = 20000
     private val copyHistoryDataStore = CopyHistoryDataStore(appContext)
@@ -112,13 +116,15 @@ class CompletionViewModel(application: Application) : AndroidViewModel(applicati
                 // 通知内核
                 it?.onTextChanged(selectedString.text, 0)
                 // 更新补全提示
-                suggestionsSize = it?.suggestionsSize ?: 0
+                analysisResult = it?.analyze(AnalysisResult.FLAG_SUGGESTIONS)
+                suggestionsSize = analysisResult?.suggestionCount ?: 0
                 suggestionsUpdateTimes++
                 return
             }
             if (it == null) {
                 return
             }
+            var flags = AnalysisResult.FLAG_PARAM_HINT or AnalysisResult.FLAG_SUGGESTIONS
             if (selectedString.text == lastInput.text) {
                 if (selectedString.selectionStart == lastInput.selectionStart) {
                     return
@@ -142,27 +148,54 @@ class CompletionViewModel(application: Application) : AndroidViewModel(applicati
                 }
                 // 通知内核
                 it.onTextChanged(selectedString.text, selectionStart)
+                flags = flags or AnalysisResult.FLAG_STRUCTURE
+                if (isSyntaxHighlight) {
+                    flags = flags or AnalysisResult.FLAG_SYNTAX_TOKENS
+                }
+                if (isUpdateErrorReason) {
+                    flags = flags or AnalysisResult.FLAG_ERROR_REASONS
+                }
+            }
+            // 一次性获取所有需要的结果
+            val result = it.analyze(flags)
+            analysisResult = result
+            if ((flags and AnalysisResult.FLAG_STRUCTURE) != 0) {
                 // 更新颜色
                 syntaxHighlightTokens = if (isSyntaxHighlight) {
-                    it.syntaxToken
+                    result?.syntaxTokens
                 } else {
                     null
                 }
                 // 更新命令语法结构
-                structure = it.structure
+                structure = result?.structure
                 // 更新错误原因
                 if (isUpdateErrorReason) {
-                    errorReasons = it.errorReasons
+                    errorReasons = result?.let { analysis ->
+                        Array(analysis.errorReasonCount) { which -> analysis.getErrorReason(which) }
+                    }
                 }
             }
             // 更新命令参数介绍
-            paramHint = it.paramHint
+            paramHint = result?.paramHint
             // 更新补全提示列表
-            suggestionsSize = it.suggestionsSize
+            suggestionsSize = result?.suggestionCount ?: 0
             suggestionsUpdateTimes++
         }
     }
 
+    /**
+     * 获取其中一个补全提示，从最近一次分析的结果中读取
+     *
+     * @param which 第几个补全提示，从0开始
+     */
+    fun getSuggestion(which: Int): Suggestion? {
+        val result = analysisResult ?: return null
+        if (which < 0 || which >= result.suggestionCount) {
+            return null
+        }
+        return result.getSuggestion(which)
+    }
+
     fun onItemClick(which: Int) {
         core.let {
             if (it == null) {
@@ -191,6 +224,7 @@ class CompletionViewModel(application: Application) : AndroidViewModel(applicati
         if (cpackBranch.isEmpty()) {
             core?.close()
             core = null
+            analysisResult = null
             return
         }
         var cpackPath: String? = null
@@ -215,6 +249,7 @@ class CompletionViewModel(application: Application) : AndroidViewModel(applicati
                 if (newCore != null) {
                     it?.close()
                     core = newCore
+                    analysisResult = null
                     lastInput = SelectedString("", 0, 0)
                     onSelectionChanged(isCheckingBySelection, isSyntaxHighlight, isShowErrorReason)
                 }
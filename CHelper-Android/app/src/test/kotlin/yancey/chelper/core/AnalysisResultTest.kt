@@ -0,0 +1,126 @@
+package yancey.chelper.core
+
+import org.junit.Assert.assertArrayEquals
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertNull
+import org.junit.Assert.assertThrows
+import org.junit.Test
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * AnalysisResult 直接解码 c++ AnalysisBuffer 写出的内存。
+ * 这里按 c++ 的格式手动拼一块缓冲区，锁住偏移量和字段顺序，两边任何一边改了格式都会在这里失败。
+ */
+class AnalysisResultTest {
+
+    /**
+     * 和 c++ 一样按 4 字节对齐追加数据
+     */
+    private class Writer {
+        val buffer: ByteBuffer = ByteBuffer.allocateDirect(1024).order(ByteOrder.nativeOrder())
+
+        init {
+            // version, flags, byteSize, sectionCount + 5 个 (offset, byteSize)
+            repeat(14) { buffer.putInt(0) }
+            buffer.putInt(0, 1)
+            buffer.putInt(12, 5)
+        }
+
+        fun putString(str: String): Int {
+            val offset = buffer.position()
+            str.forEach { buffer.putChar(it) }
+            if (str.length % 2 == 1) {
+                buffer.putChar('\u0000')
+            }
+            return offset
+        }
+
+        fun section(section: Int, write: () -> Unit) {
+            val offset = buffer.position()
+            buffer.putInt(16 + 8 * section, offset)
+            write()
+            buffer.putInt(20 + 8 * section, buffer.position() - offset)
+        }
+
+        fun finish(flags: Int): ByteBuffer {
+            buffer.putInt(4, flags)
+            buffer.putInt(8, buffer.position())
+            buffer.flip()
+            return buffer
+        }
+    }
+
+    @Test
+    fun `按 c++ 的格式解码所有结果`() {
+        val writer = Writer()
+        val buffer = writer.buffer
+        writer.section(1) {
+            buffer.putInt(3)
+            writer.putString("abc")
+        }
+        writer.section(2) {
+            buffer.putInt(1)
+            val record = buffer.position()
+            repeat(4) { buffer.putInt(0) }
+            buffer.putInt(record, 1)
+            buffer.putInt(record + 4, 3)
+            buffer.putInt(record + 8, writer.putString("err"))
+            buffer.putInt(record + 12, 3)
+        }
+        writer.section(3) {
+            buffer.putInt(2)
+            val record = buffer.position()
+            repeat(8) { buffer.putInt(0) }
+            buffer.putInt(record, writer.putString("apple"))
+            buffer.putInt(record + 4, 5)
+            buffer.putInt(record + 8, writer.putString("苹果"))
+            buffer.putInt(record + 12, 2)
+            buffer.putInt(record + 16, writer.putString("ab"))
+            buffer.putInt(record + 20, 2)
+            buffer.putInt(record + 24, writer.putString(""))
+            buffer.putInt(record + 28, 0)
+        }
+        writer.section(4) {
+            buffer.putInt(5)
+            buffer.put(byteArrayOf(1, 2, 3, 14, 0, 0, 0, 0))
+        }
+        val flags = AnalysisResult.FLAG_ALL and AnalysisResult.FLAG_STRUCTURE.inv()
+        val result = AnalysisResult(writer.finish(flags))
+
+        assertEquals(1, result.version)
+        assertEquals(flags, result.flags)
+        assertNull(result.structure)
+        assertEquals("abc", result.paramHint)
+
+        assertEquals(1, result.errorReasonCount)
+        val errorReason = result.getErrorReason(0)
+        assertEquals("err", errorReason.errorReason)
+        assertEquals(1, errorReason.start)
+        assertEquals(3, errorReason.end)
+
+        assertEquals(2, result.suggestionCount)
+        assertEquals("apple", result.getSuggestion(0).name)
+        assertEquals("苹果", result.getSuggestion(0).description)
+        assertEquals("ab", result.getSuggestion(1).name)
+        assertEquals("", result.getSuggestion(1).description)
+
+        assertArrayEquals(intArrayOf(1, 2, 3, 14, 0), result.syntaxTokens)
+    }
+
+    @Test(expected = IndexOutOfBoundsException::class)
+    fun `越界读取补全提示应当抛出异常`() {
+        AnalysisResult(Writer().finish(0)).getSuggestion(0)
+    }
+
+    @Test
+    fun `缓冲区被覆盖之后读取应当抛出异常`() {
+        var isValid = true
+        val result = AnalysisResult(Writer().finish(0)) { isValid }
+        assertEquals(0, result.suggestionCount)
+        isValid = false
+        assertThrows(IllegalStateException::class.java) { result.suggestionCount }
+        assertThrows(IllegalStateException::class.java) { result.version }
+        assertThrows(IllegalStateException::class.java) { result.paramHint }
+    }
+}
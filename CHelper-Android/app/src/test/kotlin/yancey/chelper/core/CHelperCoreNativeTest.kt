@@ -0,0 +1,98 @@
+package yancey.chelper.core
+
+import org.junit.After
+import org.junit.Assert.assertArrayEquals
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertNotNull
+import org.junit.Assert.assertThrows
+import org.junit.Assume.assumeTrue
+import org.junit.Before
+import org.junit.Test
+import java.io.File
+
+/**
+ * 在电脑的 JVM 上直接调用 c++ 内核，验证 analyze0 和逐个获取结果的 JNI 方法一致，
+ * 并且 AnalysisResult 在内核覆盖缓冲区之后不会读到新的结果。
+ * 需要的库和资源包见 build.gradle.kts 的 testOptions，不存在时跳过。
+ */
+class CHelperCoreNativeTest {
+
+    private val cores = mutableListOf<CHelperCore>()
+
+    private lateinit var cpackPath: String
+
+    @Before
+    fun setUp() {
+        val libraryName = System.mapLibraryName("CHelperAndroid")
+        val isLibraryBuilt = System.getProperty("java.library.path").orEmpty()
+            .split(File.pathSeparator)
+            .any { File(it, libraryName).isFile }
+        assumeTrue("CHelperAndroid is not built for this platform", isLibraryBuilt)
+        val cpack = File(System.getProperty("chelper.cpackDir").orEmpty())
+            .listFiles { file -> file.name.startsWith("release-vanilla-") && file.extension == "cpack" }
+            ?.firstOrNull()
+        assumeTrue("cpack is not generated", cpack != null)
+        cpackPath = cpack!!.absolutePath
+    }
+
+    @After
+    fun tearDown() {
+        cores.forEach { it.close() }
+    }
+
+    private fun createCore(): CHelperCore = CHelperCore.fromFile(cpackPath).also { cores.add(it) }
+
+    @Test
+    fun `analyze 的结果和逐个获取的结果一致`() {
+        val core = createCore()
+        for (command in listOf("give @s app", "execute if block ~~~ stone[", "")) {
+            core.onTextChanged(command, command.length)
+            val result = core.analyze()
+            assertNotNull(result)
+            result!!
+            assertEquals(AnalysisResult.FLAG_ALL, result.flags)
+            assertEquals(core.structure, result.structure)
+            assertEquals(core.paramHint, result.paramHint)
+            val errorReasons = core.errorReasons.orEmpty()
+            assertEquals(errorReasons.size, result.errorReasonCount)
+            errorReasons.forEachIndexed { i, errorReason ->
+                assertEquals(errorReason.errorReason, result.getErrorReason(i).errorReason)
+                assertEquals(errorReason.start, result.getErrorReason(i).start)
+                assertEquals(errorReason.end, result.getErrorReason(i).end)
+            }
+            assertEquals(core.suggestionsSize, result.suggestionCount)
+            for (i in 0 until result.suggestionCount) {
+                assertEquals(core.getSuggestion(i)?.name, result.getSuggestion(i).name)
+                assertEquals(core.getSuggestion(i)?.description, result.getSuggestion(i).description)
+            }
+            assertArrayEquals(core.syntaxToken, result.syntaxTokens)
+        }
+    }
+
+    @Test
+    fun `再次分析或关闭内核之后旧的结果失效`() {
+        val core = createCore()
+        core.onTextChanged("give @s app", 11)
+        val first = core.analyze(AnalysisResult.FLAG_PARAM_HINT)!!
+        assertEquals(core.paramHint, first.paramHint)
+        core.onTextChanged("execute if block ~~~ stone[", 27)
+        val second = core.analyze(AnalysisResult.FLAG_PARAM_HINT)!!
+        assertThrows(IllegalStateException::class.java) { first.paramHint }
+        assertEquals(core.paramHint, second.paramHint)
+        core.close()
+        assertThrows(IllegalStateException::class.java) { second.paramHint }
+    }
+
+    @Test
+    fun `每个内核持有自己的缓冲区`() {
+        val core1 = createCore()
+        val core2 = createCore()
+        core1.onTextChanged("give @s app", 11)
+        core2.onTextChanged("execute if block ~~~ stone[", 27)
+        val result1 = core1.analyze()!!
+        val structure1 = core1.structure
+        core2.analyze()
+        assertEquals(structure1, result1.structure)
+        assertEquals(core1.paramHint, result1.paramHint)
+    }
+}
@@ -48,12 +48,19 @@
 // 数据结构
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <variant>
@@ -96,6 +103,8 @@
 #include <serialization/serialization.h>
 // json工具
 #include <chelper/util/JsonUtil.h>
+// 调用区间的时间线
+#include <chelper/util/Trace.h>
 // 简单的调用栈
 #include <chelper/util/Profile.h>
 // KMP字符串匹配算法
@@ -55,6 +55,98 @@ jstring string2jstring(JNIEnv *env, const std::string &string) {
     return env->NewStringUTF(string.c_str());
 }
 
+static jclass findClass(JNIEnv *env, const char *name) {
+    jclass localClass = env->FindClass(name);
+    if (localClass == nullptr) [[unlikely]] {
+        env->ExceptionClear();
+        SPDLOG_ERROR("fail to find class: {}", name);
+        return nullptr;
+    }
+    auto globalClass = static_cast<jclass>(env->NewGlobalRef(localClass));
+    env->DeleteLocalRef(localClass);
+    return globalClass;
+}
+
+static jfieldID getFieldId(JNIEnv *env, jclass clazz, const char *name, const char *signature) {
+    if (clazz == nullptr) [[unlikely]] {
+        return nullptr;
+    }
+    jfieldID fieldId = env->GetFieldID(clazz, name, signature);
+    if (fieldId == nullptr) [[unlikely]] {
+        env->ExceptionClear();
+        SPDLOG_ERROR("fail to find field: {}", name);
+    }
+    return fieldId;
+}
+
+/**
+ * 第一次使用时查找并缓存的类和字段，查找失败只影响用到它们的函数
+ */
+class ErrorReasonJni {
+public:
+    jclass clazz;
+    jfieldID errorReasonField;
+    jfieldID startField;
+    jfieldID endField;
+
+    explicit ErrorReasonJni(JNIEnv *env)
+        : clazz(findClass(env, "yancey/chelper/core/ErrorReason")),
+          errorReasonField(getFieldId(env, clazz, "errorReason", "Ljava/lang/String;")),
+          startField(getFieldId(env, clazz, "start", "I")),
+          endField(getFieldId(env, clazz, "end", "I")) {}
+
+    [[nodiscard]] bool isValid() const {
+        return clazz != nullptr && errorReasonField != nullptr && startField != nullptr && endField != nullptr;
+    }
+
+    static const ErrorReasonJni &get(JNIEnv *env) {
+        static const ErrorReasonJni instance(env);
+        return instance;
+    }
+};
+
+class SuggestionJni {
+public:
+    jclass clazz;
+    jfieldID nameField;
+    jfieldID descriptionField;
+
+    explicit SuggestionJni(JNIEnv *env)
+        : clazz(findClass(env, "yancey/chelper/core/Suggestion")),
+          nameField(getFieldId(env, clazz, "name", "Ljava/lang/String;")),
+          descriptionField(getFieldId(env, clazz, "description", "Ljava/lang/String;")) {}
+
+    [[nodiscard]] bool isValid() const {
+        return clazz != nullptr && nameField != nullptr && descriptionField != nullptr;
+    }
+
+    static const SuggestionJni &get(JNIEnv *env) {
+        static const SuggestionJni instance(env);
+        return instance;
+    }
+};
+
+class ClickSuggestionResultJni {
+public:
+    jclass clazz;
+    jfieldID textField;
+    jfieldID selectionField;
+
+    explicit ClickSuggestionResultJni(JNIEnv *env)
+        : clazz(findClass(env, "yancey/chelper/core/ClickSuggestionResult")),
+          textField(getFieldId(env, clazz, "text", "Ljava/lang/String;")),
+          selectionField(getFieldId(env, clazz, "selection", "I")) {}
+
+    [[nodiscard]] bool isValid() const {
+        return clazz != nullptr && textField != nullptr && selectionField != nullptr;
+    }
+
+    static const ClickSuggestionResultJni &get(JNIEnv *env) {
+        static const ClickSuggestionResultJni instance(env);
+        return instance;
+    }
+};
+
 JNIEXPORT jint JNI_OnLoad(JavaVM *vm, void *reserved) {
 #ifdef __ANDROID__
     spdlog::set_default_logger(spdlog::android_logger_mt("android", "CHelperNative"));
@@ -143,27 +235,28 @@ Java_yancey_chelper_core_CHelperCore_getParamHint0(
 extern "C" [[maybe_unused]] JNIEXPORT jobjectArray JNICALL
 Java_yancey_chelper_core_CHelperCore_getErrorReasons0(
         JNIEnv *env, [[maybe_unused]] jobject thiz, jlong pointer) {
+    const ErrorReasonJni &errorReasonJni = ErrorReasonJni::get(env);
+    if (!errorReasonJni.isValid()) [[unlikely]] {
+        return nullptr;
+    }
     auto *core = reinterpret_cast<CHelper::CHelperCore *>(pointer);
-    jclass errorReasonClass = env->FindClass("yancey/chelper/core/ErrorReason");
     if (core == nullptr) [[unlikely]] {
         SPDLOG_WARN("call Java_yancey_chelper_core_CHelperCore_getErrorReasons0 when core is nullptr");
-        return env->NewObjectArray(0, errorReasonClass, nullptr);
+        return env->NewObjectArray(0, errorReasonJni.clazz, nullptr);
     }
     auto errorReasons = core->getErrorReasons();
-    jobjectArray result = env->NewObjectArray(static_cast<jsize>(errorReasons.size()), errorReasonClass, nullptr);
+    jobjectArray result = env->NewObjectArray(static_cast<jsize>(errorReasons.size()), errorReasonJni.clazz, nullptr);
     for (size_t i = 0; i < errorReasons.size(); ++i) {
         const CHelper::ErrorReason &item = *errorReasons[i];
-        jobject javaErrorReason = env->AllocObject(errorReasonClass);
-        env->SetObjectField(javaErrorReason,
-                            env->GetFieldID(errorReasonClass, "errorReason", "Ljava/lang/String;"),
-                            u16string2jstring(env, item.errorReason));
-        env->SetIntField(javaErrorReason,
-                         env->GetFieldID(errorReasonClass, "start", "I"),
-                         static_cast<jint>(item.start));
-        env->SetIntField(javaErrorReason,
-                         env->GetFieldID(errorReasonClass, "end", "I"),
-                         static_cast<jint>(item.end));
-        env->SetObjectArrayElement(result, i, javaErrorReason);
+        jobject javaErrorReason = env->AllocObject(errorReasonJni.clazz);
+        jstring errorReason = u16string2jstring(env, item.errorReason);
+        env->SetObjectField(javaErrorReason, errorReasonJni.errorReasonField, errorReason);
+        env->SetIntField(javaErrorReason, errorReasonJni.startField, static_cast<jint>(item.start));
+        env->SetIntField(javaErrorReason, errorReasonJni.endField, static_cast<jint>(item.end));
+        env->SetObjectArrayElement(result, static_cast<jsize>(i), javaErrorReason);
+        // 及时释放局部引用，避免数量过多时超出局部引用表的上限
+        env->DeleteLocalRef(errorReason);
+        env->DeleteLocalRef(javaErrorReason);
     }
     return result;
 }
@@ -196,14 +289,17 @@ Java_yancey_chelper_core_CHelperCore_getSuggestion0(
         SPDLOG_WARN("call Java_yancey_chelper_core_CHelperCore_getSuggestion0 when suggestions->size() <= which");
         return nullptr;
     }
-    CHelper::AutoSuggestion::Suggestion suggestion = suggestions->at(which);
-    jclass suggestionClass = env->FindClass("yancey/chelper/core/Suggestion");
-    jobject javaSuggestion = env->AllocObject(suggestionClass);
+    const SuggestionJni &suggestionJni = SuggestionJni::get(env);
+    if (!suggestionJni.isValid()) [[unlikely]] {
+        return nullptr;
+    }
+    const CHelper::AutoSuggestion::Suggestion &suggestion = (*suggestions)[which];
+    jobject javaSuggestion = env->AllocObject(suggestionJni.clazz);
     env->SetObjectField(javaSuggestion,
-                        env->GetFieldID(suggestionClass, "name", "Ljava/lang/String;"),
+                        suggestionJni.nameField,
                         u16string2jstring(env, suggestion.content->name));
     env->SetObjectField(javaSuggestion,
-                        env->GetFieldID(suggestionClass, "description", "Ljava/lang/String;"),
+                        suggestionJni.descriptionField,
                         suggestion.content->description.has_value()
                                 ? u16string2jstring(env, suggestion.content->description.value())
                                 : nullptr);
@@ -213,26 +309,33 @@ Java_yancey_chelper_core_CHelperCore_getSuggestion0(
 extern "C" [[maybe_unused]] JNIEXPORT jobject JNICALL
 Java_yancey_chelper_core_CHelperCore_getSuggestions0(
         JNIEnv *env, [[maybe_unused]] jobject thiz, jlong pointer) {
+    const SuggestionJni &suggestionJni = SuggestionJni::get(env);
+    if (!suggestionJni.isValid()) [[unlikely]] {
+        return nullptr;
+    }
     auto *core = reinterpret_cast<CHelper::CHelperCore *>(pointer);
-    jclass suggestionClass = env->FindClass("yancey/chelper/core/Suggestion");
     if (core == nullptr) [[unlikely]] {
         SPDLOG_WARN("call Java_yancey_chelper_core_CHelperCore_getSuggestions0 when core is nullptr");
-        return env->NewObjectArray(0, suggestionClass, nullptr);
+        return env->NewObjectArray(0, suggestionJni.clazz, nullptr);
     }
     const std::vector<CHelper::AutoSuggestion::Suggestion> &suggestions = *core->getSuggestions();
-    jobjectArray result = env->NewObjectArray(static_cast<jsize>(suggestions.size()), suggestionClass, nullptr);
+    jobjectArray result = env->NewObjectArray(static_cast<jsize>(suggestions.size()), suggestionJni.clazz, nullptr);
     for (size_t i = 0; i < suggestions.size(); ++i) {
         const CHelper::AutoSuggestion::Suggestion &item = suggestions[i];
-        jobject javaSuggestion = env->AllocObject(suggestionClass);
-        env->SetObjectField(javaSuggestion,
-                            env->GetFieldID(suggestionClass, "name", "Ljava/lang/String;"),
-                            u16string2jstring(env, item.content->name));
-        env->SetObjectField(javaSuggestion,
-                            env->GetFieldID(suggestionClass, "description", "Ljava/lang/String;"),
-                            item.content->description.has_value()
-                                    ? u16string2jstring(env, item.content->description.value())
-                                    : nullptr);
-        env->SetObjectArrayElement(result, i, javaSuggestion);
+        jobject javaSuggestion = env->AllocObject(suggestionJni.clazz);
+        jstring name = u16string2jstring(env, item.content->name);
+        jstring description = item.content->description.has_value()
+                                      ? u16string2jstring(env, item.content->description.value())
+                                      : nullptr;
+        env->SetObjectField(javaSuggestion, suggestionJni.nameField, name);
+        env->SetObjectField(javaSuggestion, suggestionJni.descriptionField, description);
+        env->SetObjectArrayElement(result, static_cast<jsize>(i), javaSuggestion);
+        // 及时释放局部引用，避免补全提示过多时超出局部引用表的上限
+        env->DeleteLocalRef(name);
+        if (description != nullptr) {
+            env->DeleteLocalRef(description);
+        }
+        env->DeleteLocalRef(javaSuggestion);
     }
     return result;
 }
@@ -257,14 +360,14 @@ Java_yancey_chelper_core_CHelperCore_onSuggestionClick0(
         return nullptr;
     }
     std::optional<std::pair<std::u16string, size_t>> result = core->onSuggestionClick(which);
-    if (result.has_value()) [[likely]] {
-        jclass resultClass = env->FindClass("yancey/chelper/core/ClickSuggestionResult");
-        jobject javaResult = env->AllocObject(resultClass);
+    const ClickSuggestionResultJni &clickSuggestionResultJni = ClickSuggestionResultJni::get(env);
+    if (result.has_value() && clickSuggestionResultJni.isValid()) [[likely]] {
+        jobject javaResult = env->AllocObject(clickSuggestionResultJni.clazz);
         env->SetObjectField(javaResult,
-                            env->GetFieldID(resultClass, "text", "Ljava/lang/String;"),
+                            clickSuggestionResultJni.textField,
                             u16string2jstring(env, result.value().first));
         env->SetIntField(javaResult,
-                         env->GetFieldID(resultClass, "selection", "I"),
+                         clickSuggestionResultJni.selectionField,
                          static_cast<jint>(result.value().second));
         return javaResult;
     } else {
@@ -292,6 +395,19 @@ Java_yancey_chelper_core_CHelperCore_getColors0(
     return result;
 }
 
+extern "C" [[maybe_unused]] JNIEXPORT jobject JNICALL
+Java_yancey_chelper_core_CHelperCore_analyze0(
+        JNIEnv *env, [[maybe_unused]] jobject thiz, jlong pointer, jint flags) {
+    auto *core = reinterpret_cast<CHelper::CHelperCore *>(pointer);
+    if (core == nullptr) [[unlikely]] {
+        SPDLOG_WARN("call Java_yancey_chelper_core_CHelperCore_analyze0 when core is nullptr");
+        return nullptr;
+    }
+    const CHelper::Analysis::AnalysisBuffer &analysisBuffer = core->analyze(static_cast<uint32_t>(flags));
+    // 直接把内核持有的内存交给java读取，在下一次调用analyze0或release0之前有效，java层会检查结果是否已经失效
+    return env->NewDirectByteBuffer(const_cast<uint8_t *>(analysisBuffer.data()), static_cast<jlong>(analysisBuffer.size()));
+}
+
 CHelper::Old2New::BlockFixData blockFixData0;
 
 extern "C" [[maybe_unused]] JNIEXPORT jboolean JNICALL
@@ -309,14 +425,19 @@ Java_yancey_chelper_core_CHelperCore_old2newInit0(
             return false;
         }
         auto dataFileSize = static_cast<size_t>(AAsset_getLength(asset));
-        char *buffer = new char[dataFileSize];
-        int numBytesRead = AAsset_read(asset, buffer, dataFileSize);
+        std::string buffer(dataFileSize, '\0');
+        int numBytesRead = AAsset_read(asset, buffer.data(), dataFileSize);
         AAsset_close(asset);
-        std::istringstream iss(std::string(buffer, numBytesRead));
-        serialization::from_binary(iss, blockFixData0);
-        delete[] buffer;
+        buffer.resize(numBytesRead < 0 ? 0 : static_cast<size_t>(numBytesRead));
+        std::istringstream iss(std::move(buffer));
+        // 格式版本不同时抛出异常，旧的数据保持不变
+        CHelper::Old2New::BlockFixData blockFixData;
+        serialization::from_binary(iss, blockFixData);
+        blockFixData0 = std::move(blockFixData);
         return true;
     } catch (const std::exception &e) {
+        SPDLOG_WARN("fail to load block fix data: {}", e.what());
+        CHelper::Profile::clear();
         return false;
     }
 }
@@ -0,0 +1,751 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/CHelperCore.h>
+#include <chelper/auto_suggestion/AutoSuggestion.h>
+#include <chelper/command_structure/CommandStructure.h>
+#include <chelper/lexer/Lexer.h>
+#include <chelper/linter/Linter.h>
+#include <chelper/lsp/LspServer.h>
+#include <chelper/old2new/Old2New.h>
+#include <chelper/parser/Parser.h>
+#include <chelper/syntax_highlight/SyntaxHighlight.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+namespace CHelper::Bench {
+
+    // 防止被测的结果被编译器优化掉
+    static volatile size_t sink = 0;
+
+    class Options {
+    public:
+        std::optional<std::filesystem::path> output;
+        std::string filter;
+        size_t sampleCount = 20;
+        std::chrono::nanoseconds minSampleTime = std::chrono::milliseconds(20);
+        // 逐字输入时每条命令重放的次数
+        size_t replayCount = 5;
+    };
+
+    namespace KeystrokePhase {
+        // 和安卓端每次输入后调用内核的顺序相同
+        enum KeystrokePhase : uint8_t {
+            ON_TEXT_CHANGED,
+            GET_SYNTAX_RESULT,
+            GET_STRUCTURE,
+            GET_ERROR_REASONS,
+            GET_PARAM_HINT,
+            GET_SUGGESTIONS,
+            COUNT
+        };
+    }// namespace KeystrokePhase
+
+    // 最后一项是一次输入所有阶段的总耗时
+    static constexpr std::array<const char *, KeystrokePhase::COUNT + 1> KEYSTROKE_PHASE_NAMES = {
+            "onTextChanged",
+            "getSyntaxResult",
+            "getStructure",
+            "getErrorReasons",
+            "getParamHint",
+            "getSuggestions",
+            "total"};
+
+    // 报告中列出的最慢的输入数量
+    static constexpr size_t SLOWEST_PREFIX_COUNT = 10;
+
+    /**
+     * 单个基准测试的统计结果，时间的单位是纳秒，表示每次操作的耗时
+     */
+    class Statistics {
+    public:
+        size_t iterationCount = 0;
+        std::vector<double> samples;
+        double min = 0, max = 0, mean = 0, median = 0, stddev = 0, p90 = 0;
+
+        explicit Statistics(std::vector<double> samples0, size_t iterationCount)
+            : iterationCount(iterationCount),
+              samples(std::move(samples0)) {
+            std::vector<double> sorted = samples;
+            std::sort(sorted.begin(), sorted.end());
+            min = sorted.front();
+            max = sorted.back();
+            median = sorted.size() % 2 == 1 ? sorted[sorted.size() / 2] : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2;
+            p90 = sorted[std::min(sorted.size() - 1, sorted.size() * 9 / 10)];
+            for (double item: sorted) {
+                mean += item;
+            }
+            mean /= static_cast<double>(sorted.size());
+            for (double item: sorted) {
+                stddev += (item - mean) * (item - mean);
+            }
+            stddev = sorted.size() > 1 ? std::sqrt(stddev / static_cast<double>(sorted.size() - 1)) : 0;
+        }
+    };
+
+    class BenchmarkResult {
+    public:
+        std::string name;
+        std::string cpack;
+        // 每次迭代包含的操作数，比如测试文件中命令的数量
+        size_t operationCount;
+        Statistics statistics;
+    };
+
+    /**
+     * 逐字输入时单次输入的延迟分布，时间的单位是纳秒
+     */
+    class LatencyStatistics {
+    public:
+        double p50 = 0, p95 = 0, p99 = 0, max = 0;
+
+        LatencyStatistics() = default;
+
+        explicit LatencyStatistics(std::vector<double> samples) {
+            if (samples.empty()) [[unlikely]] {
+                return;
+            }
+            std::sort(samples.begin(), samples.end());
+            auto percentile = [&samples](size_t percent) {
+                size_t rank = (samples.size() * percent + 99) / 100;
+                return samples[std::max<size_t>(rank, 1) - 1];
+            };
+            p50 = percentile(50);
+            p95 = percentile(95);
+            p99 = percentile(99);
+            max = samples.back();
+        }
+    };
+
+    class SlowPrefix {
+    public:
+        std::u16string prefix;
+        // 多次重放的总耗时的中位数
+        double time;
+    };
+
+    class KeystrokeResult {
+    public:
+        std::string cpack;
+        size_t keystrokeCount;
+        size_t replayCount;
+        std::array<LatencyStatistics, KeystrokePhase::COUNT + 1> phases;
+        std::vector<SlowPrefix> slowestPrefixes;
+    };
+
+    class Benchmark {
+    public:
+        const Options &options;
+        std::vector<BenchmarkResult> results;
+        std::vector<KeystrokeResult> keystrokeResults;
+
+        explicit Benchmark(const Options &options)
+            : options(options) {}
+
+        /**
+         * 先预热并确定每个样本的迭代次数，使每个样本的耗时不少于minSampleTime，然后采样
+         *
+         * @param function 执行一次迭代，返回值用于防止被优化
+         */
+        template<class Function>
+        void run(const std::string &name, const std::string &cpack, size_t operationCount, Function &&function) {
+            std::string fullName = cpack.empty() ? name : name + "/" + cpack;
+            if (!options.filter.empty() && fullName.find(options.filter) == std::string::npos) {
+                return;
+            }
+            try {
+                size_t iterationCount = 1;
+                while (true) {
+                    auto start = std::chrono::steady_clock::now();
+                    for (size_t i = 0; i < iterationCount; ++i) {
+                        sink = sink + function();
+                    }
+                    auto duration = std::chrono::steady_clock::now() - start;
+                    if (duration >= options.minSampleTime) {
+                        break;
+                    }
+                    iterationCount *= 2;
+                }
+                std::vector<double> samples;
+                samples.reserve(options.sampleCount);
+                for (size_t sample = 0; sample < options.sampleCount; ++sample) {
+                    auto start = std::chrono::steady_clock::now();
+                    for (size_t i = 0; i < iterationCount; ++i) {
+                        sink = sink + function();
+                    }
+                    auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+                    samples.push_back(duration.count() / static_cast<double>(iterationCount * std::max<size_t>(operationCount, 1)));
+                }
+                results.push_back({name, cpack, operationCount, Statistics(std::move(samples), iterationCount)});
+                const Statistics &statistics = results.back().statistics;
+                SPDLOG_INFO("{}: median {:.1f} ns, mean {:.1f} ns, stddev {:.1f} ns",
+                            FORMAT_ARG(fullName),
+                            FORMAT_ARG(statistics.median),
+                            FORMAT_ARG(statistics.mean),
+                            FORMAT_ARG(statistics.stddev));
+            } catch (const std::exception &e) {
+                SPDLOG_ERROR("benchmark failed: {}", FORMAT_ARG(fullName));
+                Profile::printAndClear(e);
+            }
+        }
+
+        /**
+         * 把每条命令从第一个字符开始逐字输入，每次输入后按安卓端的顺序调用内核，统计每次输入的延迟
+         */
+        void replayKeystrokes(const std::string &cpack, CHelperCore &core, const std::vector<std::u16string> &commands) {
+            std::string fullName = "KeystrokeReplay/" + cpack;
+            if (!options.filter.empty() && fullName.find(options.filter) == std::string::npos) {
+                return;
+            }
+            try {
+                std::vector<std::u16string> prefixes;
+                for (const auto &command: commands) {
+                    for (size_t length = 1; length <= command.size(); ++length) {
+                        // 不在代理对的中间截断
+                        if (length < command.size() && (command[length - 1] & 0xFC00) == 0xD800) [[unlikely]] {
+                            continue;
+                        }
+                        prefixes.push_back(command.substr(0, length));
+                    }
+                }
+                // times[replay][prefix][phase]
+                std::vector<std::vector<std::array<double, KeystrokePhase::COUNT + 1>>> times(options.replayCount);
+                for (auto &replayTimes: times) {
+                    replayTimes.reserve(prefixes.size());
+                    for (const auto &prefix: prefixes) {
+                        if (prefix.size() == 1) {
+                            // 每条命令从空白的输入框开始
+                            core.onTextChanged(u"", 0);
+                        }
+                        std::array<double, KeystrokePhase::COUNT + 1> phaseTimes{};
+                        auto last = std::chrono::steady_clock::now();
+                        auto record = [&phaseTimes, &last](KeystrokePhase::KeystrokePhase phase) {
+                            auto now = std::chrono::steady_clock::now();
+                            phaseTimes[phase] = std::chrono::duration<double, std::nano>(now - last).count();
+                            phaseTimes[KeystrokePhase::COUNT] += phaseTimes[phase];
+                            last = now;
+                        };
+                        core.onTextChanged(prefix, prefix.size());
+                        record(KeystrokePhase::ON_TEXT_CHANGED);
+                        sink = sink + core.getSyntaxResult().tokenTypes.size();
+                        record(KeystrokePhase::GET_SYNTAX_RESULT);
+                        sink = sink + core.getStructure().size();
+                        record(KeystrokePhase::GET_STRUCTURE);
+                        sink = sink + core.getErrorReasons().size();
+                        record(KeystrokePhase::GET_ERROR_REASONS);
+                        sink = sink + core.getParamHint().size();
+                        record(KeystrokePhase::GET_PARAM_HINT);
+                        sink = sink + core.getSuggestions()->size();
+                        record(KeystrokePhase::GET_SUGGESTIONS);
+                        replayTimes.push_back(phaseTimes);
+                    }
+                }
+                KeystrokeResult result{cpack, prefixes.size(), options.replayCount, {}, {}};
+                for (size_t phase = 0; phase <= KeystrokePhase::COUNT; ++phase) {
+                    std::vector<double> samples;
+                    samples.reserve(prefixes.size() * options.replayCount);
+                    for (const auto &replayTimes: times) {
+                        for (const auto &phaseTimes: replayTimes) {
+                            samples.push_back(phaseTimes[phase]);
+                        }
+                    }
+                    result.phases[phase] = LatencyStatistics(std::move(samples));
+                }
+                // 用多次重放的中位数排序，减少偶然的抖动的影响
+                std::vector<SlowPrefix> slowPrefixes;
+                slowPrefixes.reserve(prefixes.size());
+                for (size_t i = 0; i < prefixes.size(); ++i) {
+                    std::vector<double> totals;
+                    totals.reserve(options.replayCount);
+                    for (const auto &replayTimes: times) {
+                        totals.push_back(replayTimes[i][KeystrokePhase::COUNT]);
+                    }
+                    std::nth_element(totals.begin(), totals.begin() + static_cast<ptrdiff_t>(totals.size() / 2), totals.end());
+                    slowPrefixes.push_back({prefixes[i], totals[totals.size() / 2]});
+                }
+                size_t slowestCount = std::min(SLOWEST_PREFIX_COUNT, slowPrefixes.size());
+                std::partial_sort(slowPrefixes.begin(), slowPrefixes.begin() + static_cast<ptrdiff_t>(slowestCount), slowPrefixes.end(),
+                                  [](const SlowPrefix &item1, const SlowPrefix &item2) {
+                                      return item1.time > item2.time;
+                                  });
+                slowPrefixes.resize(slowestCount);
+                result.slowestPrefixes = std::move(slowPrefixes);
+                keystrokeResults.push_back(std::move(result));
+                const KeystrokeResult &keystrokeResult = keystrokeResults.back();
+                for (size_t phase = 0; phase <= KeystrokePhase::COUNT; ++phase) {
+                    const LatencyStatistics &statistics = keystrokeResult.phases[phase];
+                    SPDLOG_INFO("{} {}: p50 {:.1f} ns, p95 {:.1f} ns, p99 {:.1f} ns, max {:.1f} ns",
+                                FORMAT_ARG(fullName),
+                                FORMAT_ARG(KEYSTROKE_PHASE_NAMES[phase]),
+                                FORMAT_ARG(statistics.p50),
+                                FORMAT_ARG(statistics.p95),
+                                FORMAT_ARG(statistics.p99),
+                                FORMAT_ARG(statistics.max));
+                }
+                for (const auto &slowPrefix: keystrokeResult.slowestPrefixes) {
+                    SPDLOG_INFO("{} slow prefix: {:.1f} ns \"{}\"",
+                                FORMAT_ARG(fullName),
+                                FORMAT_ARG(slowPrefix.time),
+                                FORMAT_ARG(utf8::utf16to8(slowPrefix.prefix)));
+                }
+            } catch (const std::exception &e) {
+                SPDLOG_ERROR("benchmark failed: {}", FORMAT_ARG(fullName));
+                Profile::printAndClear(e);
+            }
+        }
+
+        [[nodiscard]] std::string toJson() const {
+            rapidjson::StringBuffer buffer;
+            rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+            writer.StartObject();
+            writer.Key("version");
+            writer.Uint(1);
+            writer.Key("context");
+            writer.StartObject();
+            writer.Key("date");
+            std::string date = fmt::format("{:%Y-%m-%dT%H:%M:%S}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+            writer.String(date.c_str());
+            writer.Key("compiler");
+#if defined(__clang__)
+            writer.String("clang " __clang_version__);
+#elif defined(__GNUC__)
+            writer.String("gcc " __VERSION__);
+#elif defined(_MSC_VER)
+            writer.String(fmt::format("msvc {}", _MSC_FULL_VER).c_str());
+#else
+            writer.String("unknown");
+#endif
+            writer.Key("debug");
+#if _CHELPER_DEBUG == true
+            writer.Bool(true);
+#else
+            writer.Bool(false);
+#endif
+            writer.Key("hardwareConcurrency");
+            writer.Uint(std::thread::hardware_concurrency());
+            writer.Key("sampleCount");
+            writer.Uint64(options.sampleCount);
+            writer.Key("replayCount");
+            writer.Uint64(options.replayCount);
+            writer.Key("unit");
+            writer.String("ns");
+            writer.EndObject();
+            writer.Key("benchmarks");
+            writer.StartArray();
+            for (const auto &result: results) {
+                const Statistics &statistics = result.statistics;
+                writer.StartObject();
+                writer.Key("name");
+                writer.String(result.name.c_str());
+                writer.Key("cpack");
+                writer.String(result.cpack.c_str());
+                writer.Key("operationCount");
+                writer.Uint64(result.operationCount);
+                writer.Key("iterationCount");
+                writer.Uint64(statistics.iterationCount);
+                writer.Key("min");
+                writer.Double(statistics.min);
+                writer.Key("max");
+                writer.Double(statistics.max);
+                writer.Key("mean");
+                writer.Double(statistics.mean);
+                writer.Key("median");
+                writer.Double(statistics.median);
+                writer.Key("stddev");
+                writer.Double(statistics.stddev);
+                writer.Key("p90");
+                writer.Double(statistics.p90);
+                writer.Key("samples");
+                writer.StartArray();
+                for (double sample: statistics.samples) {
+                    writer.Double(sample);
+                }
+                writer.EndArray();
+                writer.EndObject();
+            }
+            writer.EndArray();
+            writer.Key("keystrokes");
+            writer.StartArray();
+            for (const auto &result: keystrokeResults) {
+                writer.StartObject();
+                writer.Key("cpack");
+                writer.String(result.cpack.c_str());
+                writer.Key("keystrokeCount");
+                writer.Uint64(result.keystrokeCount);
+                writer.Key("replayCount");
+                writer.Uint64(result.replayCount);
+                writer.Key("phases");
+                writer.StartArray();
+                for (size_t phase = 0; phase <= KeystrokePhase::COUNT; ++phase) {
+                    const LatencyStatistics &statistics = result.phases[phase];
+                    writer.StartObject();
+                    writer.Key("name");
+                    writer.String(KEYSTROKE_PHASE_NAMES[phase]);
+                    writer.Key("p50");
+                    writer.Double(statistics.p50);
+                    writer.Key("p95");
+                    writer.Double(statistics.p95);
+                    writer.Key("p99");
+                    writer.Double(statistics.p99);
+                    writer.Key("max");
+                    writer.Double(statistics.max);
+                    writer.EndObject();
+                }
+                writer.EndArray();
+                writer.Key("slowestPrefixes");
+                writer.StartArray();
+                for (const auto &slowPrefix: result.slowestPrefixes) {
+                    writer.StartObject();
+                    writer.Key("prefix");
+                    std::string prefix = utf8::utf16to8(slowPrefix.prefix);
+                    writer.String(prefix.c_str(), static_cast<rapidjson::SizeType>(prefix.size()));
+                    writer.Key("time");
+                    writer.Double(slowPrefix.time);
+                    writer.EndObject();
+                }
+                writer.EndArray();
+                writer.EndObject();
+            }
+            writer.EndArray();
+            writer.EndObject();
+            return {buffer.GetString(), buffer.GetSize()};
+        }
+    };
+
+    static std::vector<std::u16string> readCommands(const std::filesystem::path &path) {
+        std::vector<std::u16string> commands;
+        std::ifstream fin(path, std::ios::in);
+        if (!fin.is_open()) [[unlikely]] {
+            Profile::push("fail to open file: {}", FORMAT_ARG(path.string()));
+            throw std::runtime_error("fail to open file");
+        }
+        std::string str;
+        while (std::getline(fin, str)) {
+            if (!str.empty() && str.back() == '\r') [[unlikely]] {
+                str.pop_back();
+            }
+            // 以-开头的行是测试文件中的分隔符
+            if (str.empty() || str[0] == '-') {
+                continue;
+            }
+            commands.push_back(utf8::utf8to16(str));
+        }
+        return commands;
+    }
+
+    /**
+     * LSP服务器打开一万行的文档，然后在文档的不同位置请求补全，统计从发送请求到收到回复的耗时
+     */
+    static void benchLsp(Benchmark &benchmark, const std::string &name, const std::string &binary, const std::vector<std::u16string> &commands) {
+        if (commands.empty()) [[unlikely]] {
+            return;
+        }
+        std::shared_ptr<const CPack> cpack;
+        try {
+            std::istringstream istream(binary);
+            cpack = CPack::createByBinary(istream);
+        } catch (const std::exception &e) {
+            SPDLOG_ERROR("CPack load failed: {}", FORMAT_ARG(name));
+            Profile::printAndClear(e);
+            return;
+        }
+        constexpr size_t lineCount = 10000;
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        writer.StartObject();
+        writer.Key("jsonrpc");
+        writer.String("2.0");
+        writer.Key("method");
+        writer.String("textDocument/didOpen");
+        writer.Key("params");
+        writer.StartObject();
+        writer.Key("textDocument");
+        writer.StartObject();
+        writer.Key("uri");
+        writer.String("file:///bench.mcfunction");
+        writer.Key("languageId");
+        writer.String("mcfunction");
+        writer.Key("version");
+        writer.Int(1);
+        writer.Key("text");
+        std::string text;
+        for (size_t i = 0; i < lineCount; ++i) {
+            text.append(utf8::utf16to8(commands[i % commands.size()])).push_back('\n');
+        }
+        writer.String(text.c_str(), static_cast<rapidjson::SizeType>(text.size()));
+        writer.EndObject();
+        writer.EndObject();
+        writer.EndObject();
+        std::string didOpen(buffer.GetString(), buffer.GetSize());
+        // 打开文档之后只有请求的回复，所以只需要统计收到的消息数量
+        std::mutex mutex;
+        std::condition_variable condition;
+        size_t messageCount = 0;
+        Lsp::LspServer server(cpack, [&mutex, &condition, &messageCount](const std::string &) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++messageCount;
+            condition.notify_all();
+        });
+        server.handleMessage(didOpen);
+        server.waitIdle();
+        benchmark.run("LspServer::didOpen", name, lineCount, [&server, &didOpen]() {
+            server.handleMessage(didOpen);
+            server.waitIdle();
+            return lineCount;
+        });
+        size_t requestIndex = 0;
+        benchmark.run("LspServer::completion", name, 1, [&]() {
+            size_t line = (requestIndex * 7919) % lineCount;
+            std::string request = fmt::format(R"({{"jsonrpc":"2.0","id":{},"method":"textDocument/completion","params":{{"textDocument":{{"uri":"file:///bench.mcfunction"}},"position":{{"line":{},"character":{}}}}}}})",
+                                              requestIndex++, line, commands[line % commands.size()].size());
+            size_t target;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                target = messageCount + 1;
+            }
+            server.handleMessage(request);
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&messageCount, target]() {
+                return messageCount >= target;
+            });
+            return target;
+        });
+    }
+
+    static void benchCPack(Benchmark &benchmark, const std::string &name, const std::filesystem::path &path, const std::vector<std::u16string> &commands, const std::vector<std::u16string> &slowCommands) {
+        std::unique_ptr<CPack> cpack;
+        try {
+            cpack = CPack::createByDirectory(path);
+        } catch (const std::exception &e) {
+            SPDLOG_ERROR("CPack load failed: {}", FORMAT_ARG(path.string()));
+            Profile::printAndClear(e);
+            return;
+        }
+        // 资源包加载
+        benchmark.run("CPack::createByDirectory", name, 1, [&path]() {
+            return CPack::createByDirectory(path)->commands->size();
+        });
+        rapidjson::GenericDocument<rapidjson::UTF8<>> json = cpack->toJson();
+        benchmark.run("CPack::createByJson", name, 1, [&json]() {
+            return CPack::createByJson(json)->commands->size();
+        });
+        std::filesystem::path binaryPath = std::filesystem::temp_directory_path() / ("CHelperBench-" + name + ".cpack");
+        cpack->writeBinToFile(binaryPath);
+        std::string binary;
+        {
+            std::ifstream istream(binaryPath, std::ios::binary);
+            std::ostringstream oss;
+            oss << istream.rdbuf();
+            binary = oss.str();
+        }
+        std::filesystem::remove(binaryPath);
+        benchmark.run("CPack::createByBinary", name, 1, [&binary]() {
+            std::istringstream istream(binary);
+            return CPack::createByBinary(istream)->commands->size();
+        });
+        rapidjson::GenericDocument<rapidjson::UTF8<>> overlay;
+        overlay.Parse(R"({
+            "manifest": {"name": "bench", "author": "CHelper", "updateDate": "2026-01-01", "packId": "BenchOverlay", "versionCode": 1},
+            "id": [{"type": "item", "content": [{"name": "apple", "description": "changed"}, {"name": "bench_item", "description": "added"}]}]
+        })");
+        benchmark.run("CPack::createByOverlay", name, 1, [&cpack, &overlay]() {
+            return CPack::createByOverlay(*cpack, overlay)->commands->size();
+        });
+        // 命令分析
+        benchmark.run("Parser::parse", name, commands.size(), [&cpack, &commands]() {
+            size_t result = 0;
+            for (const auto &command: commands) {
+                result += Parser::parse(command, *cpack).isError();
+            }
+            return result;
+        });
+        std::vector<ASTNode> astNodes;
+        astNodes.reserve(commands.size());
+        for (const auto &command: commands) {
+            astNodes.push_back(Parser::parse(command, *cpack));
+        }
+        benchmark.run("AutoSuggestion::getSuggestions", name, commands.size(), [&astNodes, &commands]() {
+            size_t result = 0;
+            for (size_t i = 0; i < astNodes.size(); ++i) {
+                result += AutoSuggestion::getSuggestions(astNodes[i], commands[i].size()).collect().size();
+            }
+            return result;
+        });
+        benchmark.run("Linter::getErrorReasons", name, commands.size(), [&astNodes]() {
+            size_t result = 0;
+            for (const auto &astNode: astNodes) {
+                result += Linter::getErrorReasons(astNode).size();
+            }
+            return result;
+        });
+        benchmark.run("SyntaxHighlight::getSyntaxResult", name, commands.size(), [&astNodes]() {
+            size_t result = 0;
+            for (const auto &astNode: astNodes) {
+                result += SyntaxHighlight::getSyntaxResult(astNode).tokenTypes.size();
+            }
+            return result;
+        });
+        benchmark.run("CommandStructure::getStructure", name, commands.size(), [&astNodes]() {
+            size_t result = 0;
+            for (const auto &astNode: astNodes) {
+                result += CommandStructure::getStructure(astNode).size();
+            }
+            return result;
+        });
+        // 模糊测试找到的耗时较长的输入
+        if (!slowCommands.empty()) {
+            benchmark.run("SlowInput::parse", name, slowCommands.size(), [&cpack, &slowCommands]() {
+                size_t result = 0;
+                for (const auto &command: slowCommands) {
+                    result += Parser::parse(command, *cpack).isError();
+                }
+                return result;
+            });
+            benchmark.run("SlowInput::getSuggestions", name, slowCommands.size(), [&cpack, &slowCommands]() {
+                size_t result = 0;
+                for (const auto &command: slowCommands) {
+                    result += AutoSuggestion::getSuggestions(Parser::parse(command, *cpack), command.size()).collect().size();
+                }
+                return result;
+            });
+        }
+        benchLsp(benchmark, name, binary, commands);
+        // 逐字输入，资源包交给内核
+        std::unique_ptr<CHelperCore> core(CHelperCore::create([&cpack]() {
+            return std::move(cpack);
+        }));
+        if (core != nullptr) [[likely]] {
+            benchmark.replayKeystrokes(name, *core, commands);
+        }
+    }
+
+}// namespace CHelper::Bench
+
+/**
+ * 基准测试，结果以JSON格式输出，方便比较不同的构建
+ *
+ * 用法：CHelperBench [--output 输出文件] [--filter 名称] [--samples 样本数] [--min-time 每个样本的最短毫秒数] [--replays 逐字输入的重放次数]
+ *
+ * 逐字输入的结果在keystrokes中，包含每个阶段每次输入的延迟分布和最慢的输入
+ */
+int main(int argc, char *argv[]) {
+    // 不指定输出文件时结果输出到标准输出，日志输出到标准错误
+    spdlog::set_default_logger(spdlog::stderr_color_mt("CHelperBench"));
+    CHelper::Bench::Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (i + 1 >= argc) [[unlikely]] {
+            SPDLOG_ERROR("usage: CHelperBench [--output <file>] [--filter <name>] [--samples <count>] [--min-time <ms>] [--replays <count>]");
+            return -1;
+        }
+        if (arg == "--output") {
+            options.output = argv[++i];
+        } else if (arg == "--filter") {
+            options.filter = argv[++i];
+        } else if (arg == "--samples") {
+            options.sampleCount = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--min-time") {
+            options.minSampleTime = std::chrono::milliseconds(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--replays") {
+            options.replayCount = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+        } else {
+            SPDLOG_ERROR("usage: CHelperBench [--output <file>] [--filter <name>] [--samples <count>] [--min-time <ms>] [--replays <count>]");
+            return -1;
+        }
+    }
+    CHelper::Bench::Benchmark benchmark(options);
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    std::vector<std::u16string> commands;
+    std::vector<std::u16string> slowCommands;
+    try {
+        commands = CHelper::Bench::readCommands(resourceDir / "test" / "test.txt");
+        SPDLOG_INFO("{} commands", FORMAT_ARG(commands.size()));
+        slowCommands = CHelper::Bench::readCommands(resourceDir / "test" / "slow.txt");
+        SPDLOG_INFO("{} slow commands", FORMAT_ARG(slowCommands.size()));
+        // 和资源包无关的部分
+        benchmark.run("Lexer::lex", "", commands.size(), [&commands]() {
+            size_t result = 0;
+            for (const auto &command: commands) {
+                result += CHelper::Lexer::lex(command)->allTokens.size();
+            }
+            return result;
+        });
+        CHelper::Old2New::BlockFixData blockFixData = CHelper::Old2New::blockFixDataFromJson(
+                serialization::get_json_from_file(resourceDir / "resources" / "old2new" / "blockFixData.json"));
+        benchmark.run("Old2New::old2new", "", commands.size(), [&blockFixData, &commands]() {
+            size_t result = 0;
+            for (const auto &command: commands) {
+                result += CHelper::Old2New::old2new(blockFixData, command).size();
+            }
+            return result;
+        });
+        // test.txt中是新语法的命令，旧语法的命令才会经过完整的转换
+        std::vector<std::u16string> oldCommands = CHelper::Bench::readCommands(resourceDir / "test" / "old2new.txt");
+        benchmark.run("Old2New::old2new(old)", "", oldCommands.size(), [&blockFixData, &oldCommands]() {
+            size_t result = 0;
+            for (const auto &command: oldCommands) {
+                result += CHelper::Old2New::old2new(blockFixData, command).size();
+            }
+            return result;
+        });
+        if (!slowCommands.empty()) {
+            benchmark.run("SlowInput::lex", "", slowCommands.size(), [&slowCommands]() {
+                size_t result = 0;
+                for (const auto &command: slowCommands) {
+                    result += CHelper::Lexer::lex(command)->allTokens.size();
+                }
+                return result;
+            });
+            benchmark.run("SlowInput::old2new", "", slowCommands.size(), [&blockFixData, &slowCommands]() {
+                size_t result = 0;
+                for (const auto &command: slowCommands) {
+                    result += CHelper::Old2New::old2new(blockFixData, command).size();
+                }
+                return result;
+            });
+        }
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        return -1;
+    }
+    // 每个分支的资源包
+    for (const auto &versionType: {"release", "beta", "netease"}) {
+        std::vector<std::filesystem::path> branchDirs;
+        for (const auto &branchDir: std::filesystem::directory_iterator(resourceDir / "resources" / versionType)) {
+            branchDirs.push_back(branchDir.path());
+        }
+        std::sort(branchDirs.begin(), branchDirs.end());
+        for (const auto &branchDir: branchDirs) {
+            std::string name = std::string(versionType) + "-" + branchDir.filename().string();
+            CHelper::Bench::benchCPack(benchmark, name, branchDir, commands, slowCommands);
+        }
+    }
+    std::string json = benchmark.toJson();
+    if (options.output.has_value()) {
+        std::ofstream ostream(options.output.value(), std::ios::binary);
+        if (!ostream.is_open()) [[unlikely]] {
+            SPDLOG_ERROR("fail to open file: {}", FORMAT_ARG(options.output->string()));
+            return -1;
+        }
+        ostream << json << '\n';
+    } else {
+        fmt::print("{}\n", json);
+    }
+    return 0;
+}
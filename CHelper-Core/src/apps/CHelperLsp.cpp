@@ -0,0 +1,72 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/lsp/LspServer.h>
+#include <iostream>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+/**
+ * 通过标准输入输出提供LSP服务
+ *
+ * 用法：CHelperLsp <资源包文件夹或cpack文件> [线程数]
+ */
+int main(int argc, char *argv[]) {
+    // 标准输出用于传输消息，日志输出到标准错误
+    spdlog::set_default_logger(spdlog::stderr_color_mt("CHelperLsp"));
+    if (argc != 2 && argc != 3) [[unlikely]] {
+        SPDLOG_ERROR("usage: CHelperLsp <cpack directory|cpack file> [threadCount]");
+        return -1;
+    }
+    std::filesystem::path cpackPath(argv[1]);
+    size_t threadCount = 0;
+    if (argc == 3) {
+        threadCount = static_cast<size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+#ifdef _WIN32
+    // 避免换行符被转换，Content-Length按字节计算
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    std::shared_ptr<const CHelper::CPack> cpack;
+    try {
+        const auto start = std::chrono::high_resolution_clock::now();
+        if (std::filesystem::is_directory(cpackPath)) {
+            cpack = CHelper::CPack::createByDirectory(cpackPath);
+        } else {
+            std::ifstream istream(cpackPath, std::ios::binary);
+            if (!istream.is_open()) [[unlikely]] {
+                SPDLOG_ERROR("fail to open file: {}", FORMAT_ARG(cpackPath.string()));
+                return -1;
+            }
+            cpack = CHelper::CPack::createByBinary(istream);
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        SPDLOG_INFO("CPack load successfully ({})", FORMAT_ARG(std::chrono::duration_cast<std::chrono::milliseconds>(end - start)));
+    } catch (const std::exception &e) {
+        SPDLOG_ERROR("CPack load failed");
+        CHelper::Profile::printAndClear(e);
+        return -1;
+    }
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+    return CHelper::Lsp::LspServer::run(std::move(cpack), std::cin, std::cout, threadCount);
+}
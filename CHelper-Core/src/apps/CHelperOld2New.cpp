@@ -0,0 +1,69 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/old2new/Old2NewBatch.h>
+
+/**
+ * 批量把旧版命令转换为新版命令
+ *
+ * 用法：CHelperOld2New <blockFixData.json或old2new.dat> <输入文件或文件夹> <输出文件或文件夹> [线程数]
+ */
+int main(int argc, char *argv[]) {
+    if (argc != 4 && argc != 5) [[unlikely]] {
+        SPDLOG_ERROR("usage: CHelperOld2New <blockFixData.json|old2new.dat> <input> <output> [threadCount]");
+        return -1;
+    }
+    std::filesystem::path blockFixDataPath(argv[1]);
+    std::filesystem::path input(argv[2]);
+    std::filesystem::path output(argv[3]);
+    size_t threadCount = 0;
+    if (argc == 5) {
+        threadCount = static_cast<size_t>(std::strtoull(argv[4], nullptr, 10));
+    }
+    try {
+        CHelper::Old2New::BlockFixData blockFixData;
+        if (blockFixDataPath.extension() == ".json") {
+            blockFixData = CHelper::Old2New::blockFixDataFromJson(serialization::get_json_from_file(blockFixDataPath));
+        } else {
+            std::ifstream istream(blockFixDataPath, std::ios::binary);
+            if (!istream.is_open()) [[unlikely]] {
+                SPDLOG_ERROR("fail to open file: {}", FORMAT_ARG(blockFixDataPath.string()));
+                return -1;
+            }
+            serialization::Codec<decltype(blockFixData)>::from_binary<false>(istream, blockFixData);
+        }
+        const auto start = std::chrono::high_resolution_clock::now();
+        CHelper::Old2New::BatchResult result = CHelper::Old2New::old2newDirectory(blockFixData, input, output, threadCount);
+        const auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        SPDLOG_INFO("converted {} files, {} lines, {} lines rewritten in {}",
+                    FORMAT_ARG(result.fileCount),
+                    FORMAT_ARG(result.lineCount),
+                    FORMAT_ARG(result.changedLineCount),
+                    FORMAT_ARG(std::chrono::duration_cast<std::chrono::milliseconds>(end - start)));
+        if (seconds > 0) [[likely]] {
+            SPDLOG_INFO("throughput: {:.0f} lines/s, {:.2f} MB/s",
+                        FORMAT_ARG(static_cast<double>(result.lineCount) / seconds),
+                        FORMAT_ARG(static_cast<double>(result.byteCount) / 1024 / 1024 / seconds));
+        }
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        return -1;
+    }
+    return 0;
+}
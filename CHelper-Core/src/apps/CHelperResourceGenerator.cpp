@@ -19,10 +19,17 @@
 #include "CHelperResourceGenerator.h"
 #include <chelper/parser/Parser.h>
 
-int main() {
+int main(int argc, char *argv[]) {
     // testDir();
     // testBin();
     // return 0;
+    if (argc > 1) {
+        if (std::string_view(argv[1]) == "--memory-usage") {
+            return outputMemoryUsage() ? 0 : -1;
+        }
+        SPDLOG_ERROR("usage: CHelperResourceGenerator [--memory-usage]");
+        return -1;
+    }
     bool isSuccess = true;
     isSuccess = outputFile(CHelper::Test::writeSingleJson, "json") && isSuccess;
     isSuccess = outputFile(CHelper::Test::writeBinary, "cpack") && isSuccess;
@@ -70,6 +77,36 @@ int main() {
     return isSuccess;
 }
 
+bool outputMemoryUsage() {
+    std::filesystem::path projectDir(RESOURCE_DIR);
+    bool isSuccess = true;
+    for (const auto &versionType: {"release", "beta", "netease"}) {
+        for (const auto &branchDir: std::filesystem::directory_iterator(projectDir / "resources" / versionType)) {
+            SPDLOG_INFO("----- memory usage: {}-{} -----", FORMAT_ARG(versionType), FORMAT_ARG(branchDir.path().filename().string()));
+            std::unique_ptr<CHelper::CHelperCore> core(CHelper::CHelperCore::createByDirectory(branchDir));
+            if (core == nullptr) [[unlikely]] {
+                isSuccess = false;
+                continue;
+            }
+            fmt::print("after loading:\n{}", core->getMemoryUsage().toString());
+            // 创建所有使用时才创建的节点，得到节点缓存的上限
+            const CHelper::CPack &cpack = core->getCPack();
+            if (cpack.blockIds != nullptr && cpack.blockIds->blockStateValues != nullptr) {
+                for (const auto &blockId: *cpack.blockIds->blockStateValues) {
+                    blockId->getNode(*cpack.blockIds);
+                }
+            }
+            if (cpack.itemIds != nullptr) {
+                for (const auto &itemId: *cpack.itemIds) {
+                    itemId->getNode(cpack.itemNodeCache);
+                }
+            }
+            fmt::print("after creating all block and item nodes:\n{}\n", core->getMemoryUsage().toString());
+        }
+    }
+    return isSuccess;
+}
+
 bool outputOld2New() {
     // old2new
     std::filesystem::path resourceDir(RESOURCE_DIR);
@@ -80,6 +117,10 @@ bool outputOld2New() {
     std::ofstream ostream(output, std::ios::binary);
     serialization::Codec<decltype(blockFixData)>::to_binary<false>(ostream, blockFixData);
     ostream.close();
+    SPDLOG_INFO("block fix data: {} entries, {} buckets, {} chars of strings",
+                FORMAT_ARG(blockFixData.entries.size()),
+                FORMAT_ARG(blockFixData.seeds.size()),
+                FORMAT_ARG(blockFixData.strings.size()));
     return true;
 }
 
@@ -387,9 +428,14 @@ namespace CHelper::Test {
             std::filesystem::path realOutput = output / filename;
             std::chrono::high_resolution_clock::time_point start, end;
             start = std::chrono::high_resolution_clock::now();
-            core->getCPack().writeBinToFile(realOutput);
+            const StringPool stringPool = core->getCPack().writeBinToFile(realOutput);
             end = std::chrono::high_resolution_clock::now();
             SPDLOG_INFO("run successfully ({})", FORMAT_ARG(std::chrono::duration_cast<std::chrono::milliseconds>(end - start)));
+            SPDLOG_INFO("string pool: {} strings -> {} unique strings, {} bytes -> {} bytes",
+                        FORMAT_ARG(stringPool.getReferenceCount()),
+                        FORMAT_ARG(stringPool.size()),
+                        FORMAT_ARG(stringPool.getReferenceSize()),
+                        FORMAT_ARG(stringPool.getUniqueSize()));
             core2 = CHelperCore::createByBinary(realOutput);
         } catch (const std::exception &e) {
             Profile::printAndClear(e);
@@ -24,7 +24,7 @@
 #include <chelper/CHelperCore.h>
 #include <pch.h>
 
-int main();
+int main(int argc, char *argv[]);
 
 #if CHelperOnlyReadBinary != true
 
@@ -38,6 +38,9 @@ int main();
 
 [[maybe_unused]] bool outputOld2New();
 
+// 输出每个资源包占用的内存
+[[maybe_unused]] bool outputMemoryUsage();
+
 namespace CHelper::Test {
 
     [[maybe_unused]] void testDir(const std::filesystem::path &cpackPath, const std::filesystem::path &testFilePath, bool isTestTime);
@@ -36,6 +36,19 @@ EMSCRIPTEN_KEEPALIVE void release(const CHelper::CHelperCore *core) {
     delete core;
 }
 
+/**
+ * 更新输入并把flags中请求的所有结果写入同一个缓冲区，格式见AnalysisBuffer
+ *
+ * 缓冲区由内核持有，返回的指针在下一次调用analyze或release之前有效
+ */
+EMSCRIPTEN_KEEPALIVE const uint8_t *analyze(CHelper::CHelperCore *core, const char16_t *content, size_t index, uint32_t flags) {
+    if (core == nullptr) [[unlikely]] {
+        return nullptr;
+    }
+    core->onTextChanged(content, index);
+    return core->analyze(flags).data();
+}
+
 EMSCRIPTEN_KEEPALIVE void onTextChanged(CHelper::CHelperCore *core, const char16_t *content, size_t index) {
     if (core == nullptr) [[unlikely]] {
         return;
@@ -0,0 +1,319 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "chelper.h"
+
+#include <chelper/CHelperCore.h>
+#include <chelper/parser/Parser.h>
+
+struct chelper_cpack {
+    std::shared_ptr<const CHelper::CPack> cpack;
+};
+
+struct chelper_session {
+    // 文本和光标位置保存在内核中
+    CHelper::CHelperCore core;
+    // 生成的结果在输入改变前缓存起来，先获取长度再获取内容时不需要重复生成
+    std::optional<std::u16string> structure;
+    std::optional<std::u16string> paramHint;
+    std::optional<std::vector<std::shared_ptr<CHelper::ErrorReason>>> errorReasons;
+    std::optional<CHelper::SyntaxHighlight::SyntaxResult> syntaxResult;
+
+    chelper_session(std::shared_ptr<const CHelper::CPack> cpack, CHelper::ASTNode astNode)
+        : core(std::move(cpack), std::move(astNode)) {}
+
+    void onTextChanged(const std::u16string &text, size_t cursor) {
+        core.onTextChanged(text, cursor);
+        structure.reset();
+        paramHint.reset();
+        errorReasons.reset();
+        syntaxResult.reset();
+    }
+
+    void onSelectionChanged(size_t cursor) {
+        core.onSelectionChanged(cursor);
+        paramHint.reset();
+    }
+
+    const std::vector<std::shared_ptr<CHelper::ErrorReason>> &getErrorReasons() {
+        if (!errorReasons.has_value()) {
+            errorReasons = core.getErrorReasons();
+        }
+        return errorReasons.value();
+    }
+};
+
+/**
+ * 把字符串复制到调用者提供的缓冲区，缓冲区不够大时只复制前capacity个
+ *
+ * @return 字符串的完整长度
+ */
+template<class T, class Char>
+static size_t copyTo(std::basic_string_view<Char> str, T *buffer, size_t capacity) {
+    static_assert(sizeof(T) == sizeof(Char));
+    if (buffer != nullptr && !str.empty()) {
+        std::memcpy(buffer, str.data(), std::min(str.size(), capacity) * sizeof(Char));
+    }
+    return str.size();
+}
+
+extern "C" {
+
+uint32_t chelper_api_version(void) {
+    return CHELPER_API_VERSION;
+}
+
+chelper_cpack *chelper_cpack_load_binary(const uint8_t *data, size_t size) {
+    if (data == nullptr && size != 0) [[unlikely]] {
+        return nullptr;
+    }
+    try {
+        std::istringstream iss(std::string(reinterpret_cast<const char *>(data), size));
+        return new chelper_cpack{CHelper::CPack::createByBinary(iss)};
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        return nullptr;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+chelper_cpack *chelper_cpack_load_file(const char *path) {
+    if (path == nullptr) [[unlikely]] {
+        return nullptr;
+    }
+    try {
+        std::filesystem::path cpackPath(reinterpret_cast<const char8_t *>(path));
+        if (cpackPath.extension() == ".cpack") {
+            std::ifstream is(cpackPath, std::ios::binary);
+            if (!is.is_open()) [[unlikely]] {
+                SPDLOG_ERROR("fail to read file: {}", path);
+                return nullptr;
+            }
+            return new chelper_cpack{CHelper::CPack::createByBinary(is)};
+        }
+        return new chelper_cpack{CHelper::CPack::createByDirectory(cpackPath)};
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        return nullptr;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void chelper_cpack_release(chelper_cpack *cpack) {
+    delete cpack;
+}
+
+chelper_session *chelper_session_create(const chelper_cpack *cpack) {
+    if (cpack == nullptr) [[unlikely]] {
+        return nullptr;
+    }
+    try {
+        CHelper::ASTNode astNode = CHelper::Parser::parse(u"", *cpack->cpack);
+        return new chelper_session(cpack->cpack, std::move(astNode));
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        return nullptr;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void chelper_session_release(chelper_session *session) {
+    delete session;
+}
+
+int chelper_session_set_text(chelper_session *session, const uint16_t *text, size_t length, size_t cursor) {
+    if (session == nullptr || (text == nullptr && length != 0)) [[unlikely]] {
+        return 0;
+    }
+    try {
+        session->onTextChanged(std::u16string(reinterpret_cast<const char16_t *>(text), length), cursor);
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+int chelper_session_set_cursor(chelper_session *session, size_t cursor) {
+    if (session == nullptr) [[unlikely]] {
+        return 0;
+    }
+    try {
+        session->onSelectionChanged(cursor);
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+size_t chelper_session_get_text(chelper_session *session, uint16_t *buffer, size_t capacity) {
+    if (session == nullptr) [[unlikely]] {
+        return CHELPER_NPOS;
+    }
+    return copyTo(std::u16string_view(session->core.getInput()), buffer, capacity);
+}
+
+size_t chelper_session_get_cursor(chelper_session *session) {
+    if (session == nullptr) [[unlikely]] {
+        return CHELPER_NPOS;
+    }
+    return session->core.getIndex();
+}
+
+size_t chelper_session_get_structure(chelper_session *session, uint16_t *buffer, size_t capacity) {
+    if (session == nullptr) [[unlikely]] {
+        return CHELPER_NPOS;
+    }
+    try {
+        if (!session->structure.has_value()) {
+            session->structure = session->core.getStructure();
+        }
+        return copyTo(std::u16string_view(session->structure.value()), buffer, capacity);
+    } catch (...) {
+        return CHELPER_NPOS;
+    }
+}
+
+size_t chelper_session_get_param_hint(chelper_session *session, uint16_t *buffer, size_t capacity) {
+    if (session == nullptr) [[unlikely]] {
+        return CHELPER_NPOS;
+    }
+    try {
+        if (!session->paramHint.has_value()) {
+            session->paramHint = session->core.getParamHint();
+        }
+        return copyTo(std::u16string_view(session->paramHint.value()), buffer, capacity);
+    } catch (...) {
+        return CHELPER_NPOS;
+    }
+}
+
+size_t chelper_session_get_error_count(chelper_session *session) {
+    if (session == nullptr) [[unlikely]] {
+        return CHELPER_NPOS;
+    }
+    try {
+        return session->getErrorReasons().size();
+    } catch (...) {
+        return CHELPER_NPOS;
+    }
+}
+
+size_t chelper_session_get_error(chelper_session *session, size_t which, size_t *start, size_t *end, uint16_t *buffer, size_t capacity) {
+    if (session == nullptr) [[unlikely]] {
+        return CHELPER_NPOS;
+    }
+    try {
+        const auto &errorReasons = session->getErrorReasons();
+        if (which >= errorReasons.size()) [[unlikely]] {
+            return CHELPER_NPOS;
+        }
+        const CHelper::ErrorReason &errorReason = *errorReasons[which];
+        if (start != nullptr) {
+            *start = errorReason.start;
+        }
+        if (end != nullptr) {
+            *end = errorReason.end;
+        }
+        return copyTo(std::u16string_view(errorReason.errorReason), buffer, capacity);
+    } catch (...) {
+        return CHELPER_NPOS;
+    }
+}
+
+size_t chelper_session_get_suggestion_count(chelper_session *session) {
+    if (session == nullptr) [[unlikely]] {
+        return CHELPER_NPOS;
+    }
+    try {
+        return session->core.getSuggestions()->size();
+    } catch (...) {
+        return CHELPER_NPOS;
+    }
+}
+
+size_t chelper_session_get_suggestion_name(chelper_session *session, size_t which, uint16_t *buffer, size_t capacity) {
+    if (session == nullptr) [[unlikely]] {
+        return CHELPER_NPOS;
+    }
+    try {
+        const auto &suggestions = *session->core.getSuggestions();
+        if (which >= suggestions.size()) [[unlikely]] {
+            return CHELPER_NPOS;
+        }
+        return copyTo(std::u16string_view(suggestions[which].content->name), buffer, capacity);
+    } catch (...) {
+        return CHELPER_NPOS;
+    }
+}
+
+size_t chelper_session_get_suggestion_description(chelper_session *session, size_t which, uint16_t *buffer, size_t capacity) {
+    if (session == nullptr) [[unlikely]] {
+        return CHELPER_NPOS;
+    }
+    try {
+        const auto &suggestions = *session->core.getSuggestions();
+        if (which >= suggestions.size()) [[unlikely]] {
+            return CHELPER_NPOS;
+        }
+        const auto &description = suggestions[which].content->description;
+        if (!description.has_value()) {
+            return 0;
+        }
+        return copyTo(std::u16string_view(description.value()), buffer, capacity);
+    } catch (...) {
+        return CHELPER_NPOS;
+    }
+}
+
+int chelper_session_click_suggestion(chelper_session *session, size_t which) {
+    if (session == nullptr) [[unlikely]] {
+        return 0;
+    }
+    try {
+        auto result = session->core.onSuggestionClick(which);
+        if (!result.has_value()) [[unlikely]] {
+            return 0;
+        }
+        session->onTextChanged(result->first, result->second);
+        return 1;
+    } catch (...) {
+        return 0;
+    }
+}
+
+size_t chelper_session_get_syntax_tokens(chelper_session *session, uint8_t *buffer, size_t capacity) {
+    if (session == nullptr) [[unlikely]] {
+        return CHELPER_NPOS;
+    }
+    try {
+        if (!session->syntaxResult.has_value()) {
+            session->syntaxResult = session->core.getSyntaxResult();
+        }
+        const auto &tokenTypes = session->syntaxResult->tokenTypes;
+        if (buffer != nullptr && !tokenTypes.empty()) {
+            std::memcpy(buffer, tokenTypes.data(), std::min(tokenTypes.size(), capacity));
+        }
+        return tokenTypes.size();
+    } catch (...) {
+        return CHELPER_NPOS;
+    }
+}
+}
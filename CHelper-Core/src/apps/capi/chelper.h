@@ -0,0 +1,157 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHELPER_C_API_H
+#define CHELPER_C_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#ifdef CHELPER_C_API_BUILD
+#define CHELPER_API __declspec(dllexport)
+#else
+#define CHELPER_API __declspec(dllimport)
+#endif
+#else
+#define CHELPER_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * CHelper的C接口，供C、Python、Rust、.NET等语言直接调用
+ *
+ * 字符串统一使用UTF-16，长度的单位是uint16_t
+ *
+ * 获取结果的函数把结果写入调用者提供的缓冲区，返回结果的完整长度；
+ * 缓冲区不够大时只写入前capacity个，调用者可以先传入capacity为0获取长度；
+ * 参数错误时返回CHELPER_NPOS
+ *
+ * 所有函数都不会抛出异常，同一个会话不能同时在多个线程中使用
+ */
+
+#define CHELPER_API_VERSION 1
+
+#define CHELPER_NPOS ((size_t) -1)
+
+/**
+ * 资源包，可以被多个会话共享
+ */
+typedef struct chelper_cpack chelper_cpack;
+
+/**
+ * 会话，保存一个输入框的文本、光标和分析结果
+ */
+typedef struct chelper_session chelper_session;
+
+CHELPER_API uint32_t chelper_api_version(void);
+
+/**
+ * 从内存中读取二进制格式的资源包
+ *
+ * @return 读取失败时返回NULL
+ */
+CHELPER_API chelper_cpack *chelper_cpack_load_binary(const uint8_t *data, size_t size);
+
+/**
+ * 从文件中读取资源包，路径使用UTF-8编码
+ *
+ * 以.cpack结尾的文件按照二进制格式读取，否则按照资源包文件夹读取
+ *
+ * @return 读取失败时返回NULL
+ */
+CHELPER_API chelper_cpack *chelper_cpack_load_file(const char *path);
+
+/**
+ * 释放资源包，正在使用这个资源包的会话不受影响
+ */
+CHELPER_API void chelper_cpack_release(chelper_cpack *cpack);
+
+/**
+ * 创建会话，会话持有资源包的引用
+ *
+ * @return 创建失败时返回NULL
+ */
+CHELPER_API chelper_session *chelper_session_create(const chelper_cpack *cpack);
+
+CHELPER_API void chelper_session_release(chelper_session *session);
+
+/**
+ * 文本改变
+ *
+ * @return 是否成功
+ */
+CHELPER_API int chelper_session_set_text(chelper_session *session, const uint16_t *text, size_t length, size_t cursor);
+
+/**
+ * 光标改变
+ *
+ * @return 是否成功
+ */
+CHELPER_API int chelper_session_set_cursor(chelper_session *session, size_t cursor);
+
+/**
+ * 获取当前文本，补全提示被使用后文本会改变
+ */
+CHELPER_API size_t chelper_session_get_text(chelper_session *session, uint16_t *buffer, size_t capacity);
+
+/**
+ * 获取当前光标位置
+ */
+CHELPER_API size_t chelper_session_get_cursor(chelper_session *session);
+
+CHELPER_API size_t chelper_session_get_structure(chelper_session *session, uint16_t *buffer, size_t capacity);
+
+CHELPER_API size_t chelper_session_get_param_hint(chelper_session *session, uint16_t *buffer, size_t capacity);
+
+CHELPER_API size_t chelper_session_get_error_count(chelper_session *session);
+
+/**
+ * 获取其中一个错误，start和end可以为NULL
+ */
+CHELPER_API size_t chelper_session_get_error(chelper_session *session, size_t which, size_t *start, size_t *end, uint16_t *buffer, size_t capacity);
+
+CHELPER_API size_t chelper_session_get_suggestion_count(chelper_session *session);
+
+CHELPER_API size_t chelper_session_get_suggestion_name(chelper_session *session, size_t which, uint16_t *buffer, size_t capacity);
+
+/**
+ * 获取补全提示的介绍，没有介绍时返回0
+ */
+CHELPER_API size_t chelper_session_get_suggestion_description(chelper_session *session, size_t which, uint16_t *buffer, size_t capacity);
+
+/**
+ * 使用补全提示，成功后通过chelper_session_get_text和chelper_session_get_cursor获取新的文本和光标位置
+ *
+ * @return 是否成功
+ */
+CHELPER_API int chelper_session_click_suggestion(chelper_session *session, size_t which);
+
+/**
+ * 获取每个字符的语法高亮类型，每个字符一个字节
+ */
+CHELPER_API size_t chelper_session_get_syntax_tokens(chelper_session *session, uint8_t *buffer, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif//CHELPER_C_API_H
@@ -0,0 +1,130 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Fuzz.h"
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv) {
+    // 第一个不是选项的参数是语料库文件夹
+    std::optional<std::filesystem::path> corpusDir;
+    for (int i = 1; i < *argc; ++i) {
+        if ((*argv)[i][0] != '-') {
+            corpusDir = (*argv)[i];
+            break;
+        }
+    }
+    if (!corpusDir.has_value() || !std::filesystem::is_directory(corpusDir.value()) || !std::filesystem::is_empty(corpusDir.value())) {
+        return 0;
+    }
+    std::filesystem::path seedPath = std::filesystem::path(RESOURCE_DIR) / "test" / "test.txt";
+    std::ifstream fin(seedPath, std::ios::in);
+    if (!fin.is_open()) [[unlikely]] {
+        SPDLOG_WARN("fail to open file: {}", FORMAT_ARG(seedPath.string()));
+        return 0;
+    }
+    size_t seedCount = 0;
+    std::string str;
+    while (std::getline(fin, str)) {
+        if (!str.empty() && str.back() == '\r') [[unlikely]] {
+            str.pop_back();
+        }
+        // 以-开头的行是测试文件中的分隔符
+        if (str.empty() || str[0] == '-') {
+            continue;
+        }
+        std::ofstream fout(corpusDir.value() / fmt::format("seed-{:03}", seedCount++), std::ios::binary);
+        fout.write(str.data(), static_cast<std::streamsize>(str.size()));
+    }
+    SPDLOG_INFO("write {} seeds to {}", FORMAT_ARG(seedCount), FORMAT_ARG(corpusDir->string()));
+    return 0;
+}
+
+namespace CHelper::Fuzz {
+
+    volatile size_t sink = 0;
+
+    std::u16string toCommand(const uint8_t *data, size_t size) {
+        std::string_view str(reinterpret_cast<const char *>(data), std::min(size, MAX_INPUT_SIZE));
+        std::string validStr;
+        validStr.reserve(str.size());
+        utf8::replace_invalid(str.begin(), str.end(), std::back_inserter(validStr));
+        return utf8::utf8to16(validStr);
+    }
+
+    const CPack &getCPack() {
+        static std::unique_ptr<CPack> cpack = []() {
+            const char *env = std::getenv("CHELPER_FUZZ_CPACK");
+            std::filesystem::path path = env == nullptr ? std::filesystem::path(RESOURCE_DIR) / "resources" / "beta" / "vanilla" : std::filesystem::path(env);
+            try {
+                return CPack::createByDirectory(path);
+            } catch (const std::exception &e) {
+                SPDLOG_ERROR("CPack load failed: {}", FORMAT_ARG(path.string()));
+                Profile::printAndClear(e);
+                std::exit(-1);
+            }
+        }();
+        return *cpack;
+    }
+
+    const Old2New::BlockFixData &getBlockFixData() {
+        static Old2New::BlockFixData blockFixData = []() {
+            std::filesystem::path path = std::filesystem::path(RESOURCE_DIR) / "resources" / "old2new" / "blockFixData.json";
+            try {
+                return Old2New::blockFixDataFromJson(serialization::get_json_from_file(path));
+            } catch (const std::exception &e) {
+                SPDLOG_ERROR("block fix data load failed: {}", FORMAT_ARG(path.string()));
+                Profile::printAndClear(e);
+                std::exit(-1);
+            }
+        }();
+        return blockFixData;
+    }
+
+    SlowInputRecorder::SlowInputRecorder(std::string target)
+        : target(std::move(target)) {
+        const char *dirEnv = std::getenv("CHELPER_FUZZ_SLOW_DIR");
+        dir = dirEnv == nullptr ? std::filesystem::path("slow") : std::filesystem::path(dirEnv);
+        const char *msEnv = std::getenv("CHELPER_FUZZ_SLOW_MS");
+        minDuration = std::chrono::milliseconds(msEnv == nullptr ? 1 : std::strtoull(msEnv, nullptr, 10));
+    }
+
+    void SlowInputRecorder::record(const uint8_t *data, size_t size, size_t length, std::chrono::nanoseconds duration) {
+        if (duration < minDuration) [[likely]] {
+            return;
+        }
+        double nanosPerChar = static_cast<double>(duration.count()) / static_cast<double>(std::max<size_t>(length, 1));
+        if (nanosPerChar <= maxNanosPerChar) [[likely]] {
+            return;
+        }
+        maxNanosPerChar = nanosPerChar;
+        std::error_code errorCode;
+        std::filesystem::create_directories(dir, errorCode);
+        std::filesystem::path path = dir / fmt::format("{}-{:.0f}ns-{:016x}", target, nanosPerChar, XXH3_64bits(data, size));
+        std::ofstream fout(path, std::ios::binary);
+        if (!fout.is_open()) [[unlikely]] {
+            SPDLOG_WARN("fail to open file: {}", FORMAT_ARG(path.string()));
+            return;
+        }
+        fout.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+        SPDLOG_INFO("slow input: {} chars in {}, {:.0f} ns/char, saved to {}",
+                    FORMAT_ARG(length),
+                    FORMAT_ARG(std::chrono::duration_cast<std::chrono::microseconds>(duration)),
+                    FORMAT_ARG(nanosPerChar),
+                    FORMAT_ARG(path.string()));
+    }
+
+}// namespace CHelper::Fuzz
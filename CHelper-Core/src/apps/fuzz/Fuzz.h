@@ -0,0 +1,97 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_FUZZ_H
+#define CHELPER_FUZZ_H
+
+#include <chelper/old2new/Old2New.h>
+#include <chelper/resources/CPack.h>
+#include <pch.h>
+
+/**
+ * 模糊测试的入口，兼容libFuzzer和AFL
+ *
+ * 每个模糊测试程序都要实现这个函数，使用clang构建时由libFuzzer调用，否则由FuzzMain.cpp中的main函数调用
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/**
+ * 在读取语料库之前调用，语料库文件夹为空时用test.txt中的每一行作为初始语料
+ */
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv);
+
+namespace CHelper::Fuzz {
+
+    // 输入的最大长度，太长的输入只会拖慢模糊测试
+    constexpr size_t MAX_INPUT_SIZE = 4096;
+
+    /**
+     * 把输入当作UTF-8编码的命令，非法的字符会被替换
+     */
+    std::u16string toCommand(const uint8_t *data, size_t size);
+
+    /**
+     * 加载一次资源包，可以通过环境变量CHELPER_FUZZ_CPACK指定资源包文件夹
+     */
+    const CPack &getCPack();
+
+    /**
+     * 加载一次旧命令转换使用的方块数据
+     */
+    const Old2New::BlockFixData &getBlockFixData();
+
+    /**
+     * 记录每个字符平均耗时最长的输入
+     *
+     * 耗时超过CHELPER_FUZZ_SLOW_MS毫秒（默认为1）并且每个字符的平均耗时超过之前所有输入时，
+     * 把输入写入CHELPER_FUZZ_SLOW_DIR文件夹（默认为slow），没有换行的输入可以加入test/slow.txt作为基准测试用例
+     */
+    class SlowInputRecorder {
+    private:
+        std::string target;
+        std::filesystem::path dir;
+        std::chrono::nanoseconds minDuration;
+        double maxNanosPerChar = 0;
+
+    public:
+        explicit SlowInputRecorder(std::string target);
+
+        void record(const uint8_t *data, size_t size, size_t length, std::chrono::nanoseconds duration);
+
+        /**
+         * 运行一次测试，记录耗时
+         *
+         * @param length 输入的字符数
+         */
+        template<class Function>
+        void run(const uint8_t *data, size_t size, size_t length, Function &&function) {
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            const auto end = std::chrono::steady_clock::now();
+            record(data, size, length, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start));
+        }
+    };
+
+    // 防止被测的结果被编译器优化掉
+    extern volatile size_t sink;
+
+}// namespace CHelper::Fuzz
+
+#endif//CHELPER_FUZZ_H
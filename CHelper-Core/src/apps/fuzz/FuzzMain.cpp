@@ -0,0 +1,75 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Fuzz.h"
+
+#include <iostream>
+
+static bool runFile(const std::filesystem::path &path) {
+    std::ifstream fin(path, std::ios::binary);
+    if (!fin.is_open()) [[unlikely]] {
+        SPDLOG_ERROR("fail to open file: {}", FORMAT_ARG(path.string()));
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+    return true;
+}
+
+/**
+ * 没有libFuzzer时使用的入口，可以配合AFL使用
+ *
+ * 用法：CHelperFuzzXxx [文件或文件夹...]，没有参数时从标准输入读取一个输入
+ *
+ * 运行文件夹中的输入时会先输出文件名，崩溃时最后一个文件名就是导致崩溃的输入
+ */
+int main(int argc, char *argv[]) {
+    LLVMFuzzerInitialize(&argc, &argv);
+    if (argc == 1) {
+        std::string data((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+        return 0;
+    }
+    std::vector<std::filesystem::path> paths;
+    for (int i = 1; i < argc; ++i) {
+        std::filesystem::path path(argv[i]);
+        if (!std::filesystem::is_directory(path)) {
+            paths.push_back(std::move(path));
+            continue;
+        }
+        std::vector<std::filesystem::path> files;
+        for (const auto &file: std::filesystem::directory_iterator(path)) {
+            if (file.is_regular_file()) {
+                files.push_back(file.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        paths.insert(paths.end(), files.begin(), files.end());
+    }
+    bool isVerbose = paths.size() > 1;
+    for (const auto &path: paths) {
+        if (isVerbose) {
+            SPDLOG_INFO("run {}", FORMAT_ARG(path.string()));
+        }
+        if (!runFile(path)) [[unlikely]] {
+            return -1;
+        }
+    }
+    SPDLOG_INFO("{} inputs passed", FORMAT_ARG(paths.size()));
+    return 0;
+}
@@ -0,0 +1,34 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Fuzz.h"
+
+#include <chelper/parser/Parser.h>
+
+/**
+ * 使用真实的资源包对Parser::parse进行模糊测试
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static CHelper::Fuzz::SlowInputRecorder recorder("parser");
+    const CHelper::CPack &cpack = CHelper::Fuzz::getCPack();
+    std::u16string command = CHelper::Fuzz::toCommand(data, size);
+    recorder.run(data, size, command.size(), [&command, &cpack]() {
+        CHelper::Fuzz::sink = CHelper::Fuzz::sink + CHelper::Parser::parse(command, cpack).isError();
+    });
+    return 0;
+}
@@ -26,8 +26,9 @@
 
 namespace CHelper {
 
-    CHelperCore::CHelperCore(std::unique_ptr<CPack> cpack, ASTNode astNode)
-        : cpack(std::move(cpack)),
+    CHelperCore::CHelperCore(std::shared_ptr<const CPack> cpack, ASTNode astNode)
+        : latestCPack(std::move(cpack)),
+          cpack(latestCPack),
           astNode(std::move(astNode)) {}
 
     CHelperCore *CHelperCore::create(const std::function<std::unique_ptr<CPack>()> &getCPack) {
@@ -93,13 +94,51 @@ namespace CHelper {
             return result;
         });
     }
+
+    CHelperCore *CHelperCore::createByOverlay(const CPack &base, const std::filesystem::path &overlayPath) {
+        return create([&base, &overlayPath]() {
+            return CPack::createByOverlay(base, overlayPath);
+        });
+    }
 #endif
 
+    bool CHelperCore::reload(const std::function<std::unique_ptr<CPack>()> &getCPack) {
+        std::shared_ptr<const CPack> newCPack;
+        try {
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+            const auto start = std::chrono::high_resolution_clock::now();
+#endif
+            newCPack = getCPack();
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+            const auto end = std::chrono::high_resolution_clock::now();
+#endif
+            SPDLOG_INFO("CPack reload successfully ({})", FORMAT_ARG(std::chrono::duration_cast<std::chrono::milliseconds>(end - start)));
+        } catch (const std::exception &e) {
+            SPDLOG_ERROR("CPack reload failed");
+            CHelper::Profile::printAndClear(e);
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(latestCPackMutex);
+        latestCPack = std::move(newCPack);
+        return true;
+    }
+
     void CHelperCore::onTextChanged(const std::u16string &content, size_t index0) {
-        if (input != content) [[likely]] {
+        CHELPER_TRACE_SCOPE("CHelperCore::onTextChanged");
+        std::shared_ptr<const CPack> currentCPack;
+        {
+            std::lock_guard<std::mutex> lock(latestCPackMutex);
+            currentCPack = latestCPack;
+        }
+        if (input != content || cpack != currentCPack) [[likely]] {
             input = content;
-            astNode = Parser::parse(input, *cpack);
             suggestions = nullptr;
+#ifdef CHELPER_NODE_PROFILE
+            NodeProfile::Scope profileScope(profileRecorder);
+#endif
+            astNode = Parser::parse(input, *currentCPack);
+            // 旧的语法树已经释放，如果没有其它地方使用，旧的资源包在这里释放
+            cpack = std::move(currentCPack);
         }
         onSelectionChanged(index0);
     }
@@ -111,6 +150,14 @@ namespace CHelper {
         }
     }
 
+    [[nodiscard]] const std::u16string &CHelperCore::getInput() const {
+        return input;
+    }
+
+    [[nodiscard]] size_t CHelperCore::getIndex() const {
+        return index;
+    }
+
     [[nodiscard]] const CPack &CHelperCore::getCPack() const {
         return *cpack;
     }
@@ -120,28 +167,60 @@ namespace CHelper {
     }
 
     [[nodiscard]] std::u16string CHelperCore::getParamHint() const {
+        CHELPER_TRACE_SCOPE("CHelperCore::getParamHint");
         return ParameterHint::getParameterHint(astNode, index).value_or(u"未知");
     }
 
     [[nodiscard]] std::vector<std::shared_ptr<ErrorReason>> CHelperCore::getErrorReasons() const {
+        CHELPER_TRACE_SCOPE("CHelperCore::getErrorReasons");
+#ifdef CHELPER_NODE_PROFILE
+        NodeProfile::Scope profileScope(profileRecorder);
+#endif
         return Linter::getErrorReasons(astNode);
     }
 
     std::vector<AutoSuggestion::Suggestion> *CHelperCore::getSuggestions() {
+        CHELPER_TRACE_SCOPE("CHelperCore::getSuggestions");
         if (suggestions == nullptr) [[likely]] {
+#ifdef CHELPER_NODE_PROFILE
+            NodeProfile::Scope profileScope(profileRecorder);
+#endif
             suggestions = std::make_shared<std::vector<AutoSuggestion::Suggestion>>(AutoSuggestion::getSuggestions(astNode, index).collect());
         }
         return suggestions.get();
     }
 
     [[nodiscard]] std::u16string CHelperCore::getStructure() const {
+        CHELPER_TRACE_SCOPE("CHelperCore::getStructure");
         return CommandStructure::getStructure(astNode);
     }
 
     [[nodiscard]] SyntaxHighlight::SyntaxResult CHelperCore::getSyntaxResult() const {
+        CHELPER_TRACE_SCOPE("CHelperCore::getSyntaxResult");
+#ifdef CHELPER_NODE_PROFILE
+        NodeProfile::Scope profileScope(profileRecorder);
+#endif
         return SyntaxHighlight::getSyntaxResult(astNode);
     }
 
+    NodeProfile::Report CHelperCore::getProfileReport() const {
+#ifdef CHELPER_NODE_PROFILE
+        return profileRecorder.getReport();
+#else
+        return {};
+#endif
+    }
+
+    void CHelperCore::clearProfileReport() {
+#ifdef CHELPER_NODE_PROFILE
+        profileRecorder.clear();
+#endif
+    }
+
+    MemoryUsage::Report CHelperCore::getMemoryUsage() const {
+        return cpack->getMemoryUsage();
+    }
+
     std::optional<std::pair<std::u16string, size_t>> CHelperCore::onSuggestionClick(size_t which) {
         if (suggestions == nullptr || which >= suggestions->size()) [[unlikely]] {
             return std::nullopt;
@@ -165,6 +244,12 @@ namespace CHelper {
         return result;
     }
 
+    const Analysis::AnalysisBuffer &CHelperCore::analyze(uint32_t flags) {
+        CHELPER_TRACE_SCOPE("CHelperCore::analyze");
+        analysisBuffer.write(*this, flags);
+        return analysisBuffer;
+    }
+
     std::u16string CHelperCore::old2new(const Old2New::BlockFixData &blockFixData, std::u16string old) {
         return Old2New::old2new(blockFixData, std::move(old));
     }
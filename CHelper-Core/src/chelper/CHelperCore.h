@@ -22,8 +22,10 @@
 #define CHELPER_CHELPERCORE_H
 
 #include "old2new/Old2New.h"
+#include <chelper/analysis/AnalysisBuffer.h>
 #include <chelper/auto_suggestion/Suggestion.h>
 #include <chelper/parser/ASTNode.h>
+#include <chelper/profile/NodeProfile.h>
 #include <chelper/resources/CPack.h>
 #include <chelper/syntax_highlight/SyntaxResult.h>
 #include <pch.h>
@@ -34,12 +36,22 @@ namespace CHelper {
     private:
         std::u16string input;
         size_t index = 0;
-        std::unique_ptr<CPack> cpack;
+        // 最新发布的资源包，可以在其它线程中重新加载并替换
+        std::shared_ptr<const CPack> latestCPack;
+        std::mutex latestCPackMutex;
+        // 当前语法树使用的资源包，语法树中的节点指向这个资源包，所以要和语法树一起持有
+        std::shared_ptr<const CPack> cpack;
         ASTNode astNode;
         std::shared_ptr<std::vector<AutoSuggestion::Suggestion>> suggestions;
+        // 分析结果缓冲区，和内核一起释放
+        Analysis::AnalysisBuffer analysisBuffer;
+#ifdef CHELPER_NODE_PROFILE
+        // 每种节点的耗时统计
+        mutable NodeProfile::Recorder profileRecorder;
+#endif
 
     public:
-        CHelperCore(std::unique_ptr<CPack> cpack, ASTNode astNode);
+        CHelperCore(std::shared_ptr<const CPack> cpack, ASTNode astNode);
 
         static CHelperCore *create(const std::function<std::unique_ptr<CPack>()> &getCPack);
 
@@ -49,12 +61,27 @@ namespace CHelper {
         static CHelperCore *createByJson(const std::filesystem::path &cpackPath);
 
         static CHelperCore *createByBinary(const std::filesystem::path &cpackPath);
+
+        static CHelperCore *createByOverlay(const CPack &base, const std::filesystem::path &overlayPath);
 #endif
 
+        /**
+         * 重新加载资源包，可以在后台线程中调用
+         *
+         * 加载完成后才会替换资源包，正在使用的旧资源包会在下一次输入变化时释放
+         *
+         * @return 是否加载成功，加载失败时继续使用原来的资源包
+         */
+        bool reload(const std::function<std::unique_ptr<CPack>()> &getCPack);
+
         void onTextChanged(const std::u16string &content, size_t index);
 
         void onSelectionChanged(size_t index0);
 
+        [[nodiscard]] const std::u16string &getInput() const;
+
+        [[nodiscard]] size_t getIndex() const;
+
         [[nodiscard]] const CPack &getCPack() const;
 
         [[nodiscard]] const ASTNode *getAstNode() const;
@@ -71,6 +98,25 @@ namespace CHelper {
 
         [[nodiscard]] std::optional<std::pair<std::u16string, size_t>> onSuggestionClick(size_t which);
 
+        /**
+         * 把flags中请求的所有结果写入内核持有的缓冲区，格式见AnalysisBuffer
+         *
+         * 返回的缓冲区在下一次调用analyze或者释放内核之前有效
+         */
+        const Analysis::AnalysisBuffer &analyze(uint32_t flags);
+
+        /**
+         * 获取每种节点的调用次数、耗时和读取的token数量，需要开启CHELPER_NODE_PROFILE，否则返回空的报告
+         */
+        [[nodiscard]] NodeProfile::Report getProfileReport() const;
+
+        void clearProfileReport();
+
+        /**
+         * 当前使用的资源包每个部分占用的内存，使用时才创建的节点会随着输入增加
+         */
+        [[nodiscard]] MemoryUsage::Report getMemoryUsage() const;
+
         static std::u16string old2new(const Old2New::BlockFixData &blockFixData, std::u16string old);
     };
 
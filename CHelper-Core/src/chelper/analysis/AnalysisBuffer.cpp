@@ -0,0 +1,134 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/CHelperCore.h>
+#include <chelper/analysis/AnalysisBuffer.h>
+
+namespace CHelper::Analysis {
+
+    void AnalysisBuffer::write(CHelperCore &core, uint32_t flags) {
+        words.clear();
+        appendWords(HEADER_WORD_COUNT);
+        words[0] = VERSION;
+        words[1] = flags & AnalysisFlag::ALL;
+        words[3] = AnalysisSection::COUNT;
+        if (flags & AnalysisFlag::STRUCTURE) {
+            beginSection(AnalysisSection::STRUCTURE);
+            std::u16string structure = core.getStructure();
+            words[appendWords(1)] = static_cast<uint32_t>(structure.size());
+            appendString(structure);
+            endSection(AnalysisSection::STRUCTURE);
+        }
+        if (flags & AnalysisFlag::PARAM_HINT) {
+            beginSection(AnalysisSection::PARAM_HINT);
+            std::u16string paramHint = core.getParamHint();
+            words[appendWords(1)] = static_cast<uint32_t>(paramHint.size());
+            appendString(paramHint);
+            endSection(AnalysisSection::PARAM_HINT);
+        }
+        if (flags & AnalysisFlag::ERROR_REASONS) {
+            beginSection(AnalysisSection::ERROR_REASONS);
+            auto errorReasons = core.getErrorReasons();
+            size_t index = appendWords(1 + ERROR_REASON_WORD_COUNT * errorReasons.size());
+            words[index++] = static_cast<uint32_t>(errorReasons.size());
+            for (const auto &item: errorReasons) {
+                words[index] = static_cast<uint32_t>(item->start);
+                words[index + 1] = static_cast<uint32_t>(item->end);
+                words[index + 2] = appendString(item->errorReason);
+                words[index + 3] = static_cast<uint32_t>(item->errorReason.size());
+                index += ERROR_REASON_WORD_COUNT;
+            }
+            endSection(AnalysisSection::ERROR_REASONS);
+        }
+        if (flags & AnalysisFlag::SUGGESTIONS) {
+            beginSection(AnalysisSection::SUGGESTIONS);
+            auto suggestions = core.getSuggestions();
+            size_t count = suggestions == nullptr ? 0 : suggestions->size();
+            size_t index = appendWords(1 + SUGGESTION_WORD_COUNT * count);
+            words[index++] = static_cast<uint32_t>(count);
+            for (size_t i = 0; i < count; ++i) {
+                const auto &content = (*suggestions)[i].content;
+                std::u16string_view description = content->description.has_value() ? std::u16string_view(content->description.value()) : std::u16string_view();
+                words[index] = appendString(content->name);
+                words[index + 1] = static_cast<uint32_t>(content->name.size());
+                words[index + 2] = appendString(description);
+                words[index + 3] = static_cast<uint32_t>(description.size());
+                index += SUGGESTION_WORD_COUNT;
+            }
+            endSection(AnalysisSection::SUGGESTIONS);
+        }
+        if (flags & AnalysisFlag::SYNTAX_TOKENS) {
+            beginSection(AnalysisSection::SYNTAX_TOKENS);
+            auto syntaxResult = core.getSyntaxResult();
+            size_t count = syntaxResult.tokenTypes.size();
+            words[appendWords(1)] = static_cast<uint32_t>(count);
+            size_t index = appendWords((count + 3) / 4);
+            if (count > 0) {
+                std::memcpy(words.data() + index, syntaxResult.tokenTypes.data(), count);
+            }
+            endSection(AnalysisSection::SYNTAX_TOKENS);
+        }
+        words[2] = byteOffset();
+    }
+
+    const uint8_t *AnalysisBuffer::data() const {
+        return reinterpret_cast<const uint8_t *>(words.data());
+    }
+
+    size_t AnalysisBuffer::size() const {
+        return words.size() * sizeof(uint32_t);
+    }
+
+    uint32_t AnalysisBuffer::byteOffset() const {
+        return static_cast<uint32_t>(size());
+    }
+
+    /**
+     * 在末尾添加count个为0的uint32
+     *
+     * @return 第一个新添加的uint32的下标
+     */
+    size_t AnalysisBuffer::appendWords(size_t count) {
+        size_t index = words.size();
+        words.resize(index + count, 0);
+        return index;
+    }
+
+    /**
+     * 在末尾添加字符串，不足4字节的部分补0
+     *
+     * @return 字符串的偏移量
+     */
+    uint32_t AnalysisBuffer::appendString(std::u16string_view str) {
+        uint32_t offset = byteOffset();
+        size_t index = appendWords((str.size() + 1) / 2);
+        if (!str.empty()) {
+            std::memcpy(words.data() + index, str.data(), str.size() * sizeof(char16_t));
+        }
+        return offset;
+    }
+
+    void AnalysisBuffer::beginSection(AnalysisSection::AnalysisSection section) {
+        words[4 + 2 * section] = byteOffset();
+    }
+
+    void AnalysisBuffer::endSection(AnalysisSection::AnalysisSection section) {
+        words[5 + 2 * section] = byteOffset() - words[4 + 2 * section];
+    }
+
+}// namespace CHelper::Analysis
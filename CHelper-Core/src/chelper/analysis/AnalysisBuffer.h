@@ -0,0 +1,100 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_ANALYSISBUFFER_H
+#define CHELPER_ANALYSISBUFFER_H
+
+#include <pch.h>
+
+namespace CHelper {
+    class CHelperCore;
+}// namespace CHelper
+
+namespace CHelper::Analysis {
+
+    namespace AnalysisFlag {
+        enum AnalysisFlag : uint32_t {
+            STRUCTURE = 1 << 0,
+            PARAM_HINT = 1 << 1,
+            ERROR_REASONS = 1 << 2,
+            SUGGESTIONS = 1 << 3,
+            SYNTAX_TOKENS = 1 << 4,
+            ALL = STRUCTURE | PARAM_HINT | ERROR_REASONS | SUGGESTIONS | SYNTAX_TOKENS
+        };
+    }// namespace AnalysisFlag
+
+    namespace AnalysisSection {
+        enum AnalysisSection : uint32_t {
+            STRUCTURE,
+            PARAM_HINT,
+            ERROR_REASONS,
+            SUGGESTIONS,
+            SYNTAX_TOKENS,
+            COUNT
+        };
+    }// namespace AnalysisSection
+
+    /**
+     * 把一次输入的所有分析结果写入同一块内存，外部只需要一次调用就可以通过偏移量读取所有结果
+     *
+     * 所有数字都是本机字节序的uint32，所有偏移量都是相对于缓冲区开头的字节数，并且都是4字节对齐的
+     *
+     * 头部：version, flags, byteSize, sectionCount, 然后每个部分是(offset, byteSize)，没有请求的部分两个值都是0
+     * 字符串(structure, paramHint)：length, 然后是length个char16_t
+     * errorReasons：count, 然后每个错误是(start, end, textOffset, textLength)，字符串放在所有记录后面
+     * suggestions：count, 然后每个补全是(nameOffset, nameLength, descriptionOffset, descriptionLength)，字符串放在所有记录后面
+     * syntaxTokens：count, 然后是count个uint8_t
+     */
+    class AnalysisBuffer {
+    public:
+        static constexpr uint32_t VERSION = 1;
+        static constexpr size_t HEADER_WORD_COUNT = 4 + 2 * AnalysisSection::COUNT;
+        static constexpr size_t ERROR_REASON_WORD_COUNT = 4;
+        static constexpr size_t SUGGESTION_WORD_COUNT = 4;
+
+    private:
+        // 用uint32_t存储保证了4字节对齐，重复使用时不会重新分配内存
+        std::vector<uint32_t> words;
+
+    public:
+        /**
+         * 把分析结果写入缓冲区，会覆盖上一次的结果
+         */
+        void write(CHelperCore &core, uint32_t flags);
+
+        [[nodiscard]] const uint8_t *data() const;
+
+        [[nodiscard]] size_t size() const;
+
+    private:
+        [[nodiscard]] uint32_t byteOffset() const;
+
+        size_t appendWords(size_t count);
+
+        uint32_t appendString(std::u16string_view str);
+
+        void beginSection(AnalysisSection::AnalysisSection section);
+
+        void endSection(AnalysisSection::AnalysisSection section);
+    };
+
+}// namespace CHelper::Analysis
+
+#endif//CHELPER_ANALYSISBUFFER_H
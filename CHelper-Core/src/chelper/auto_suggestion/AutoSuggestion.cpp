@@ -18,11 +18,7 @@
 
 #include <chelper/auto_suggestion/AutoSuggestion.h>
 #include <chelper/node/NodeType.h>
-
-#define CHELPER_COLLECT_AUTO_SUGGESTION(v1)                                                                                                   \
-    case Node::NodeTypeId::v1:                                                                                                                \
-        isDirty = AutoSuggestion<typename Node::NodeTypeDetail<Node::NodeTypeId::v1>::Type>::collectSuggestions(astNode, index, suggestions); \
-        break;
+#include <chelper/profile/NodeProfile.h>
 
 namespace CHelper::AutoSuggestion {
 
@@ -493,20 +489,26 @@ namespace CHelper::AutoSuggestion {
         }
     };
 
+    template<Node::NodeTypeId::NodeTypeId nodeTypeId>
+    struct CollectSuggestionsByNodeType {
+        static bool call(const ASTNode &astNode, size_t index, Suggestions &suggestions) {
+            return AutoSuggestion<typename Node::NodeTypeDetail<nodeTypeId>::Type>::collectSuggestions(astNode, index, suggestions);
+        }
+    };
+
+    static constexpr auto collectSuggestionsFunctions = Node::createNodeTypeTable<CollectSuggestionsByNodeType>();
+
     void collectSuggestions(const ASTNode &astNode, size_t index, Suggestions &suggestions) {
         if (index < astNode.tokens.startIndex || index > astNode.tokens.endIndex) [[likely]] {
             return;
         }
+        CHELPER_NODE_PROFILE_SCOPE(NodeProfile::Phase::SUGGESTION, astNode.node, astNode.tokens.size());
+        CHELPER_TRACE_SCOPE_ARG("collect suggestions", "nodeType", Node::getNodeTypeName(astNode.node.nodeTypeId));
         if (!astNode.isAllSpaceError()) [[unlikely]] {
-            bool isDirty;
 #ifdef CHelperTest
             Profile::push("collect suggestions: {} {}", FORMAT_ARG(utf8::utf16to8(astNode.tokens.toString())), FORMAT_ARG(Node::getNodeTypeName(astNode.node.nodeTypeId)));
 #endif
-            switch (astNode.node.nodeTypeId) {
-                CODEC_PASTE(CHELPER_COLLECT_AUTO_SUGGESTION, CHELPER_NODE_TYPES)
-                default:
-                    CHELPER_UNREACHABLE();
-            }
+            bool isDirty = collectSuggestionsFunctions[astNode.node.nodeTypeId](astNode, index, suggestions);
 #ifdef CHelperTest
             Profile::pop();
 #endif
@@ -39,11 +39,8 @@ namespace CHelper::AutoSuggestion {
           content(content) {}
 
     [[nodiscard]] XXH64_hash_t Suggestion::hashCode() const {
-        XXH3_state_t hashState;
-        XXH3_copyState(&hashState, content->getHashState());
-        XXH3_64bits_update(&hashState, &start, sizeof(start));
-        XXH3_64bits_update(&hashState, &end, sizeof(end));
-        return XXH3_64bits_digest(&hashState);
+        const size_t range[2] = {start, end};
+        return XXH3_64bits_withSeed(range, sizeof(range), content->getContentHash());
     }
 
 }// namespace CHelper::AutoSuggestion
\ No newline at end of file
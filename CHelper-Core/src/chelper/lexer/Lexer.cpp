@@ -209,6 +209,7 @@ namespace CHelper::Lexer {
     };
 
     std::shared_ptr<LexerResult> lex(std::u16string content) {
+        CHELPER_TRACE_SCOPE_ARG("lex", "content", std::u16string_view(content));
 #ifdef CHelperTest
         Profile::push("start lex: {}", FORMAT_ARG(utf8::utf16to8(content)));
 #endif
@@ -18,11 +18,7 @@
 
 #include <chelper/linter/Linter.h>
 #include <chelper/node/NodeType.h>
-
-#define CHELPER_LINT(v1)                                                                                          \
-    case Node::NodeTypeId::v1:                                                                                    \
-        isDirty = Linter<typename Node::NodeTypeDetail<Node::NodeTypeId::v1>::Type>::lint(astNode, errorReasons); \
-        break;
+#include <chelper/profile/NodeProfile.h>
 
 namespace CHelper::Linter {
 
@@ -78,7 +74,7 @@ namespace CHelper::Linter {
             std::u16string_view str = astNode.tokens.string();
             XXH64_hash_t strHash = XXH3_64bits(str.data(), str.size() * sizeof(decltype(str)::value_type));
             if (std::ranges::all_of(*node.customContents, [&strHash](const auto &item) {
-                    return !item->fastMatch(strHash) && !item->getIdWithNamespace()->fastMatch(strHash);
+                    return !item->fastMatch(strHash) && !item->fastMatchWithNamespace(strHash);
                 })) [[unlikely]] {
                 errorReasons.push_back(ErrorReason::idError(astNode.tokens, fmt::format(u"找不到ID -> {}", str)));
             }
@@ -192,17 +188,23 @@ namespace CHelper::Linter {
         }
     };
 
+    template<Node::NodeTypeId::NodeTypeId nodeTypeId>
+    struct LintByNodeType {
+        static bool call(const ASTNode &astNode, std::vector<std::shared_ptr<ErrorReason>> &errorReasons) {
+            return Linter<typename Node::NodeTypeDetail<nodeTypeId>::Type>::lint(astNode, errorReasons);
+        }
+    };
+
+    static constexpr auto lintFunctions = Node::createNodeTypeTable<LintByNodeType>();
+
     void lint(const ASTNode &astNode, std::vector<std::shared_ptr<ErrorReason>> &errorReasons) {
+        CHELPER_NODE_PROFILE_SCOPE(NodeProfile::Phase::LINT, astNode.node, astNode.tokens.size());
+        CHELPER_TRACE_SCOPE_ARG("lint", "nodeType", Node::getNodeTypeName(astNode.node.nodeTypeId));
         if (!astNode.isAllSpaceError()) [[unlikely]] {
 #ifdef CHelperTest
             Profile::push("collect id errors: {}", FORMAT_ARG(Node::getNodeTypeName(astNode.node.nodeTypeId)));
 #endif
-            bool isDirty = false;
-            switch (astNode.node.nodeTypeId) {
-                CODEC_PASTE(CHELPER_LINT, CHELPER_NODE_TYPES)
-                default:
-                    CHELPER_UNREACHABLE();
-            }
+            bool isDirty = lintFunctions[astNode.node.nodeTypeId](astNode, errorReasons);
 #ifdef CHelperTest
             Profile::pop();
 #endif
@@ -0,0 +1,810 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/lsp/LspServer.h>
+#include <chelper/parser/Parser.h>
+
+namespace CHelper::Lsp {
+
+    namespace ErrorCode {
+        constexpr int PARSE_ERROR = -32700;
+        constexpr int INVALID_REQUEST = -32600;
+        constexpr int METHOD_NOT_FOUND = -32601;
+        constexpr int INVALID_PARAMS = -32602;
+        constexpr int INTERNAL_ERROR = -32603;
+        constexpr int REQUEST_CANCELLED = -32800;
+    }// namespace ErrorCode
+
+    // 语义高亮的类型
+    static constexpr std::array<const char *, 8> SEMANTIC_TOKEN_TYPES = {
+            "keyword",
+            "number",
+            "operator",
+            "type",
+            "variable",
+            "function",
+            "string",
+            "enumMember",
+    };
+
+    // SyntaxTokenType对应的语义高亮类型的下标，-1表示不高亮
+    static constexpr std::array<int8_t, 15> SEMANTIC_TOKEN_TYPE_INDEX = {
+            -1,// UNKNOWN
+            0, // BOOLEAN
+            1, // FLOAT
+            1, // INTEGER
+            2, // SYMBOL
+            3, // ID
+            4, // TARGET_SELECTOR
+            5, // COMMAND
+            2, // BRACKET1
+            2, // BRACKET2
+            2, // BRACKET3
+            6, // STRING
+            0, // NULL_TOKEN
+            1, // RANGE
+            7, // LITERAL
+    };
+    static_assert(SEMANTIC_TOKEN_TYPE_INDEX.size() == SyntaxHighlight::SyntaxTokenType::LITERAL + 1);
+
+    static std::string toJson(const rapidjson::Value &value) {
+        rapidjson::StringBuffer buffer;
+        LspServer::JsonWriter writer(buffer);
+        value.Accept(writer);
+        return {buffer.GetString(), buffer.GetSize()};
+    }
+
+    static std::u16string toU16String(const rapidjson::Value &value) {
+        return utf8::utf8to16(std::string_view(value.GetString(), value.GetStringLength()));
+    }
+
+    static void writeString(LspServer::JsonWriter &writer, std::u16string_view str) {
+        std::string utf8 = utf8::utf16to8(str);
+        writer.String(utf8.data(), static_cast<rapidjson::SizeType>(utf8.size()));
+    }
+
+    static void writeRange(LspServer::JsonWriter &writer, size_t line, size_t start, size_t end) {
+        writer.StartObject();
+        writer.Key("start");
+        writer.StartObject();
+        writer.Key("line");
+        writer.Uint64(line);
+        writer.Key("character");
+        writer.Uint64(start);
+        writer.EndObject();
+        writer.Key("end");
+        writer.StartObject();
+        writer.Key("line");
+        writer.Uint64(line);
+        writer.Key("character");
+        writer.Uint64(end);
+        writer.EndObject();
+        writer.EndObject();
+    }
+
+    static const rapidjson::Value *getMember(const rapidjson::Value &value, const char *name) {
+        if (!value.IsObject()) [[unlikely]] {
+            return nullptr;
+        }
+        auto it = value.FindMember(name);
+        return it == value.MemberEnd() ? nullptr : &it->value;
+    }
+
+    static std::optional<std::pair<size_t, size_t>> getPosition(const rapidjson::Value *position) {
+        if (position == nullptr) [[unlikely]] {
+            return std::nullopt;
+        }
+        const rapidjson::Value *line = getMember(*position, "line");
+        const rapidjson::Value *character = getMember(*position, "character");
+        if (line == nullptr || character == nullptr || !line->IsUint64() || !character->IsUint64()) [[unlikely]] {
+            return std::nullopt;
+        }
+        return std::make_pair(static_cast<size_t>(line->GetUint64()), static_cast<size_t>(character->GetUint64()));
+    }
+
+    static std::vector<Line> splitLines(std::u16string_view text) {
+        std::vector<Line> lines;
+        size_t start = 0;
+        while (true) {
+            size_t end = text.find(u'\n', start);
+            std::u16string_view line = text.substr(start, end == std::u16string_view::npos ? std::u16string_view::npos : end - start);
+            if (!line.empty() && line.back() == u'\r') {
+                line.remove_suffix(1);
+            }
+            lines.emplace_back(std::u16string(line));
+            if (end == std::u16string_view::npos) {
+                break;
+            }
+            start = end + 1;
+        }
+        return lines;
+    }
+
+    /**
+     * 空行和注释不是命令，不需要解析
+     */
+    static bool isCommandLine(std::u16string_view text) {
+        size_t start = text.find_first_not_of(u" \t");
+        return start != std::u16string_view::npos && text[start] != u'#';
+    }
+
+    /**
+     * 应用一次增量修改，位置使用UTF-16编码
+     */
+    static void applyChange(Document &document, const rapidjson::Value &change) {
+        const rapidjson::Value *text = getMember(change, "text");
+        if (text == nullptr || !text->IsString()) [[unlikely]] {
+            return;
+        }
+        const rapidjson::Value *range = getMember(change, "range");
+        if (range == nullptr) {
+            document.lines = splitLines(toU16String(*text));
+            return;
+        }
+        auto start = getPosition(getMember(*range, "start"));
+        auto end = getPosition(getMember(*range, "end"));
+        if (!start.has_value() || !end.has_value()) [[unlikely]] {
+            return;
+        }
+        if (document.lines.empty()) [[unlikely]] {
+            document.lines.emplace_back(u"");
+        }
+        size_t startLine = std::min(start->first, document.lines.size() - 1);
+        size_t startCharacter = std::min(start->second, document.lines[startLine].text.size());
+        size_t endLine = std::min(end->first, document.lines.size() - 1);
+        size_t endCharacter = std::min(end->second, document.lines[endLine].text.size());
+        if (endLine < startLine || (endLine == startLine && endCharacter < startCharacter)) [[unlikely]] {
+            return;
+        }
+        std::u16string merged = document.lines[startLine].text.substr(0, startCharacter);
+        merged.append(toU16String(*text));
+        merged.append(std::u16string_view(document.lines[endLine].text).substr(endCharacter));
+        std::vector<Line> newLines = splitLines(merged);
+        auto begin = document.lines.begin();
+        document.lines.erase(begin + static_cast<std::ptrdiff_t>(startLine), begin + static_cast<std::ptrdiff_t>(endLine) + 1);
+        document.lines.insert(document.lines.begin() + static_cast<std::ptrdiff_t>(startLine),
+                              std::make_move_iterator(newLines.begin()),
+                              std::make_move_iterator(newLines.end()));
+    }
+
+    Line::Line(std::u16string text)
+        : text(std::move(text)) {}
+
+    /**
+     * 后台线程处理请求的作用域，离开作用域时删除还没有回复的请求，处理请求时抛出异常会回复内部错误
+     */
+    class LspServer::RequestScope {
+    private:
+        LspServer &server;
+        const std::string &id;
+        int uncaughtExceptions;
+
+    public:
+        RequestScope(LspServer &server, const std::string &id)
+            : server(server),
+              id(id),
+              uncaughtExceptions(std::uncaught_exceptions()) {}
+
+        RequestScope(const RequestScope &) = delete;
+
+        RequestScope &operator=(const RequestScope &) = delete;
+
+        ~RequestScope() {
+            if (std::uncaught_exceptions() > uncaughtExceptions) [[unlikely]] {
+                try {
+                    server.sendError(id, ErrorCode::INTERNAL_ERROR, "internal error");
+                } catch (const std::exception &) {
+                    // 正在处理异常，回复失败时不能再抛出异常
+                }
+            }
+            server.finishRequest(id);
+        }
+    };
+
+    LspServer::LspServer(std::shared_ptr<const CPack> cpack, Output output, size_t threadCount)
+        : cpack(std::move(cpack)),
+          output(std::move(output)) {
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            workers.emplace_back([this]() {
+                while (true) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(taskMutex);
+                        taskCondition.wait(lock, [this]() {
+                            return isStopping || !tasks.empty();
+                        });
+                        if (tasks.empty()) {
+                            return;
+                        }
+                        task = std::move(tasks.front());
+                        tasks.pop_front();
+                        ++runningTaskCount;
+                    }
+                    try {
+                        task();
+                    } catch (const std::exception &e) {
+                        Profile::printAndClear(e);
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(taskMutex);
+                        --runningTaskCount;
+                        if (tasks.empty() && runningTaskCount == 0) {
+                            idleCondition.notify_all();
+                        }
+                    }
+                }
+            });
+        }
+    }
+
+    LspServer::~LspServer() {
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            isStopping = true;
+        }
+        taskCondition.notify_all();
+        for (auto &worker: workers) {
+            worker.join();
+        }
+    }
+
+    bool LspServer::handleMessage(std::string_view message) {
+        rapidjson::Document document;
+        document.Parse(message.data(), message.size());
+        if (document.HasParseError() || !document.IsObject()) [[unlikely]] {
+            sendError("null", ErrorCode::PARSE_ERROR, "parse error");
+            return false;
+        }
+        const rapidjson::Value *method = getMember(document, "method");
+        const rapidjson::Value *id = getMember(document, "id");
+        if (method == nullptr || !method->IsString()) [[unlikely]] {
+            // 服务器不会向客户端发送请求，所以没有需要处理的回复
+            if (id != nullptr) {
+                sendError(toJson(*id), ErrorCode::INVALID_REQUEST, "invalid request");
+            }
+            return false;
+        }
+        std::string methodStr(method->GetString(), method->GetStringLength());
+        static const rapidjson::Value nullValue;
+        const rapidjson::Value *params = getMember(document, "params");
+        if (params == nullptr) {
+            params = &nullValue;
+        }
+        if (id == nullptr) {
+            if (methodStr == "exit") {
+                return true;
+            }
+            handleNotification(methodStr, *params);
+        } else {
+            handleRequest(methodStr, toJson(*id), *params);
+        }
+        return false;
+    }
+
+    void LspServer::waitIdle() {
+        std::unique_lock<std::mutex> lock(taskMutex);
+        idleCondition.wait(lock, [this]() {
+            return tasks.empty() && runningTaskCount == 0;
+        });
+    }
+
+    int LspServer::run(std::shared_ptr<const CPack> cpack, std::istream &istream, std::ostream &ostream, size_t threadCount) {
+        LspServer server(
+                std::move(cpack),
+                [&ostream](const std::string &message) {
+                    writeMessage(ostream, message);
+                },
+                threadCount);
+        while (true) {
+            std::optional<std::string> message = readMessage(istream);
+            if (!message.has_value()) {
+                // 没有收到exit通知输入就结束了
+                return 1;
+            }
+            if (server.handleMessage(*message)) {
+                return server.isShutdown ? 0 : 1;
+            }
+        }
+    }
+
+    std::optional<std::string> LspServer::readMessage(std::istream &istream) {
+        constexpr std::string_view contentLengthKey = "Content-Length:";
+        std::optional<size_t> contentLength;
+        std::string header;
+        while (std::getline(istream, header)) {
+            if (!header.empty() && header.back() == '\r') {
+                header.pop_back();
+            }
+            if (header.empty()) {
+                if (contentLength.has_value()) {
+                    break;
+                }
+                continue;
+            }
+            if (!header.starts_with(contentLengthKey)) {
+                // 其他的头，比如Content-Type
+                continue;
+            }
+            size_t value = 0;
+            bool hasDigit = false;
+            for (size_t i = contentLengthKey.size(); i < header.size(); ++i) {
+                char ch = header[i];
+                if (ch >= '0' && ch <= '9') {
+                    value = value * 10 + static_cast<size_t>(ch - '0');
+                    hasDigit = true;
+                } else if (ch != ' ' && ch != '\t') {
+                    hasDigit = false;
+                    break;
+                }
+            }
+            if (hasDigit) {
+                contentLength = value;
+            }
+        }
+        if (!istream || !contentLength.has_value()) {
+            return std::nullopt;
+        }
+        std::string content(*contentLength, '\0');
+        istream.read(content.data(), static_cast<std::streamsize>(content.size()));
+        if (static_cast<size_t>(istream.gcount()) != content.size()) [[unlikely]] {
+            return std::nullopt;
+        }
+        return content;
+    }
+
+    void LspServer::writeMessage(std::ostream &ostream, std::string_view message) {
+        ostream << "Content-Length: " << message.size() << "\r\n\r\n"
+                << message;
+        ostream.flush();
+    }
+
+    void LspServer::submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(taskMutex);
+            tasks.push_back(std::move(task));
+        }
+        taskCondition.notify_one();
+    }
+
+    void LspServer::send(const std::function<void(JsonWriter &writer)> &write) {
+        rapidjson::StringBuffer buffer;
+        JsonWriter writer(buffer);
+        writer.StartObject();
+        writer.Key("jsonrpc");
+        writer.String("2.0");
+        write(writer);
+        writer.EndObject();
+        std::string message(buffer.GetString(), buffer.GetSize());
+        std::lock_guard<std::mutex> lock(outputMutex);
+        output(message);
+    }
+
+    void LspServer::sendResult(const std::string &id, const std::function<void(JsonWriter &writer)> &writeResult) {
+        send([&id, &writeResult](JsonWriter &writer) {
+            writer.Key("id");
+            writer.RawValue(id.data(), id.size(), rapidjson::kStringType);
+            writer.Key("result");
+            writeResult(writer);
+        });
+    }
+
+    void LspServer::sendError(const std::string &id, int code, std::string_view message) {
+        send([&id, code, message](JsonWriter &writer) {
+            writer.Key("id");
+            writer.RawValue(id.data(), id.size(), rapidjson::kStringType);
+            writer.Key("error");
+            writer.StartObject();
+            writer.Key("code");
+            writer.Int(code);
+            writer.Key("message");
+            writer.String(message.data(), static_cast<rapidjson::SizeType>(message.size()));
+            writer.EndObject();
+        });
+    }
+
+    void LspServer::sendNotification(std::string_view method, const std::function<void(JsonWriter &writer)> &writeParams) {
+        send([method, &writeParams](JsonWriter &writer) {
+            writer.Key("method");
+            writer.String(method.data(), static_cast<rapidjson::SizeType>(method.size()));
+            writer.Key("params");
+            writeParams(writer);
+        });
+    }
+
+    bool LspServer::isCancelled(const std::string &id) {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        auto it = pendingRequests.find(id);
+        return it != pendingRequests.end() && it->second;
+    }
+
+    bool LspServer::replyIfCancelled(const std::string &id) {
+        if (!isCancelled(id)) [[likely]] {
+            return false;
+        }
+        sendError(id, ErrorCode::REQUEST_CANCELLED, "request cancelled");
+        return true;
+    }
+
+    void LspServer::finishRequest(const std::string &id) {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        pendingRequests.erase(id);
+    }
+
+    std::shared_ptr<Document> LspServer::getDocument(const rapidjson::Value &params) {
+        const rapidjson::Value *textDocument = getMember(params, "textDocument");
+        const rapidjson::Value *uri = textDocument == nullptr ? nullptr : getMember(*textDocument, "uri");
+        if (uri == nullptr || !uri->IsString()) [[unlikely]] {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(documentsMutex);
+        auto it = documents.find(std::string(uri->GetString(), uri->GetStringLength()));
+        return it == documents.end() ? nullptr : it->second;
+    }
+
+    CHelperCore &LspServer::getCore(Line &line) {
+        if (line.core == nullptr) {
+            line.core = std::make_unique<CHelperCore>(cpack, Parser::parse(u"", *cpack));
+            line.core->onTextChanged(line.text, line.text.size());
+        }
+        return *line.core;
+    }
+
+    const std::vector<std::shared_ptr<ErrorReason>> &LspServer::getErrorReasons(Line &line) {
+        if (!line.errorReasons.has_value()) {
+            line.errorReasons = getCore(line).getErrorReasons();
+        }
+        return line.errorReasons.value();
+    }
+
+    void LspServer::handleRequest(const std::string &method, const std::string &id, const rapidjson::Value &params) {
+        if (method == "initialize") {
+            sendResult(id, [](JsonWriter &writer) {
+                writer.StartObject();
+                writer.Key("capabilities");
+                writer.StartObject();
+                writer.Key("positionEncoding");
+                writer.String("utf-16");
+                writer.Key("textDocumentSync");
+                writer.StartObject();
+                writer.Key("openClose");
+                writer.Bool(true);
+                // 增量同步
+                writer.Key("change");
+                writer.Int(2);
+                writer.EndObject();
+                writer.Key("completionProvider");
+                writer.StartObject();
+                writer.Key("triggerCharacters");
+                writer.StartArray();
+                for (const char *triggerCharacter: {" ", "@", "[", "=", ",", "{", ":", "\""}) {
+                    writer.String(triggerCharacter);
+                }
+                writer.EndArray();
+                writer.EndObject();
+                writer.Key("hoverProvider");
+                writer.Bool(true);
+                writer.Key("semanticTokensProvider");
+                writer.StartObject();
+                writer.Key("legend");
+                writer.StartObject();
+                writer.Key("tokenTypes");
+                writer.StartArray();
+                for (const char *tokenType: SEMANTIC_TOKEN_TYPES) {
+                    writer.String(tokenType);
+                }
+                writer.EndArray();
+                writer.Key("tokenModifiers");
+                writer.StartArray();
+                writer.EndArray();
+                writer.EndObject();
+                writer.Key("full");
+                writer.Bool(true);
+                writer.EndObject();
+                writer.EndObject();
+                writer.Key("serverInfo");
+                writer.StartObject();
+                writer.Key("name");
+                writer.String("CHelper");
+                writer.EndObject();
+                writer.EndObject();
+            });
+            return;
+        }
+        if (isShutdown) [[unlikely]] {
+            sendError(id, ErrorCode::INVALID_REQUEST, "server is shut down");
+            return;
+        }
+        if (method == "shutdown") {
+            isShutdown = true;
+            waitIdle();
+            sendResult(id, [](JsonWriter &writer) {
+                writer.Null();
+            });
+            return;
+        }
+        bool isCompletion = method == "textDocument/completion";
+        bool isHover = method == "textDocument/hover";
+        bool isSemanticTokens = method == "textDocument/semanticTokens/full";
+        if (!isCompletion && !isHover && !isSemanticTokens) {
+            sendError(id, ErrorCode::METHOD_NOT_FOUND, "method not found: " + method);
+            return;
+        }
+        std::shared_ptr<Document> document = getDocument(params);
+        if (document == nullptr) [[unlikely]] {
+            sendError(id, ErrorCode::INVALID_PARAMS, "unknown text document");
+            return;
+        }
+        std::optional<std::pair<size_t, size_t>> position;
+        if (!isSemanticTokens) {
+            position = getPosition(getMember(params, "position"));
+            if (!position.has_value()) [[unlikely]] {
+                sendError(id, ErrorCode::INVALID_PARAMS, "invalid position");
+                return;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            pendingRequests.emplace(id, false);
+        }
+        submit([this, id, document, position, isCompletion, isHover]() {
+            RequestScope requestScope(*this, id);
+            if (replyIfCancelled(id)) {
+                return;
+            }
+            if (isCompletion) {
+                completion(id, document, position->first, position->second);
+            } else if (isHover) {
+                hover(id, document, position->first, position->second);
+            } else {
+                semanticTokens(id, document);
+            }
+        });
+    }
+
+    void LspServer::handleNotification(const std::string &method, const rapidjson::Value &params) {
+        if (method == "$/cancelRequest") {
+            const rapidjson::Value *id = getMember(params, "id");
+            if (id == nullptr) [[unlikely]] {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(pendingMutex);
+            auto it = pendingRequests.find(toJson(*id));
+            if (it != pendingRequests.end()) {
+                it->second = true;
+            }
+            return;
+        }
+        const rapidjson::Value *textDocument = getMember(params, "textDocument");
+        const rapidjson::Value *uri = textDocument == nullptr ? nullptr : getMember(*textDocument, "uri");
+        if (uri == nullptr || !uri->IsString()) [[unlikely]] {
+            return;
+        }
+        std::string uriStr(uri->GetString(), uri->GetStringLength());
+        const rapidjson::Value *version = getMember(*textDocument, "version");
+        int64_t versionValue = version != nullptr && version->IsInt64() ? version->GetInt64() : 0;
+        if (method == "textDocument/didOpen") {
+            const rapidjson::Value *text = getMember(*textDocument, "text");
+            if (text == nullptr || !text->IsString()) [[unlikely]] {
+                return;
+            }
+            auto document = std::make_shared<Document>();
+            document->version = versionValue;
+            document->lines = splitLines(toU16String(*text));
+            {
+                std::lock_guard<std::mutex> lock(documentsMutex);
+                documents[uriStr] = document;
+            }
+            schedulePublishDiagnostics(uriStr, document, versionValue);
+        } else if (method == "textDocument/didChange") {
+            std::shared_ptr<Document> document = getDocument(params);
+            const rapidjson::Value *contentChanges = getMember(params, "contentChanges");
+            if (document == nullptr || contentChanges == nullptr || !contentChanges->IsArray()) [[unlikely]] {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(document->mutex);
+                document->version = versionValue;
+                for (const auto &change: contentChanges->GetArray()) {
+                    applyChange(*document, change);
+                }
+            }
+            schedulePublishDiagnostics(uriStr, document, versionValue);
+        } else if (method == "textDocument/didClose") {
+            {
+                std::lock_guard<std::mutex> lock(documentsMutex);
+                documents.erase(uriStr);
+            }
+            sendNotification("textDocument/publishDiagnostics", [&uriStr](JsonWriter &writer) {
+                writer.StartObject();
+                writer.Key("uri");
+                writer.String(uriStr.data(), static_cast<rapidjson::SizeType>(uriStr.size()));
+                writer.Key("diagnostics");
+                writer.StartArray();
+                writer.EndArray();
+                writer.EndObject();
+            });
+        }
+    }
+
+    void LspServer::schedulePublishDiagnostics(const std::string &uri, const std::shared_ptr<Document> &document, int64_t version) {
+        submit([this, uri, document, version]() {
+            publishDiagnostics(uri, document, version);
+        });
+    }
+
+    void LspServer::publishDiagnostics(const std::string &uri, const std::shared_ptr<Document> &document, int64_t version) {
+        std::lock_guard<std::mutex> lock(document->mutex);
+        if (document->version != version) {
+            // 文档已经被修改，新的修改会重新发送诊断
+            return;
+        }
+        sendNotification("textDocument/publishDiagnostics", [this, &uri, &document, version](JsonWriter &writer) {
+            writer.StartObject();
+            writer.Key("uri");
+            writer.String(uri.data(), static_cast<rapidjson::SizeType>(uri.size()));
+            writer.Key("version");
+            writer.Int64(version);
+            writer.Key("diagnostics");
+            writer.StartArray();
+            for (size_t i = 0; i < document->lines.size(); ++i) {
+                Line &line = document->lines[i];
+                if (!isCommandLine(line.text)) {
+                    continue;
+                }
+                // 只有修改过的行需要重新检查
+                for (const auto &errorReason: getErrorReasons(line)) {
+                    writer.StartObject();
+                    writer.Key("range");
+                    writeRange(writer, i, errorReason->start, errorReason->end);
+                    writer.Key("severity");
+                    writer.Int(1);
+                    writer.Key("source");
+                    writer.String("CHelper");
+                    writer.Key("message");
+                    writeString(writer, errorReason->errorReason);
+                    writer.EndObject();
+                }
+            }
+            writer.EndArray();
+            writer.EndObject();
+        });
+    }
+
+    void LspServer::completion(const std::string &id, const std::shared_ptr<Document> &document, size_t line, size_t character) {
+        std::lock_guard<std::mutex> lock(document->mutex);
+        if (line >= document->lines.size() || !isCommandLine(document->lines[line].text)) {
+            sendResult(id, [](JsonWriter &writer) {
+                writer.Null();
+            });
+            return;
+        }
+        Line &item = document->lines[line];
+        CHelperCore &core = getCore(item);
+        core.onSelectionChanged(std::min(character, item.text.size()));
+        std::vector<AutoSuggestion::Suggestion> *suggestions = core.getSuggestions();
+        sendResult(id, [line, &item, suggestions](JsonWriter &writer) {
+            writer.StartObject();
+            writer.Key("isIncomplete");
+            writer.Bool(false);
+            writer.Key("items");
+            writer.StartArray();
+            for (const auto &suggestion: *suggestions) {
+                writer.StartObject();
+                writer.Key("label");
+                writeString(writer, suggestion.content->name);
+                if (suggestion.content->description.has_value()) {
+                    writer.Key("detail");
+                    writeString(writer, suggestion.content->description.value());
+                }
+                writer.Key("textEdit");
+                writer.StartObject();
+                writer.Key("range");
+                writeRange(writer, line, suggestion.start, suggestion.end);
+                writer.Key("newText");
+                if (suggestion.isAddSpace && suggestion.end == item.text.size()) {
+                    writeString(writer, suggestion.content->name + u' ');
+                } else {
+                    writeString(writer, suggestion.content->name);
+                }
+                writer.EndObject();
+                writer.EndObject();
+            }
+            writer.EndArray();
+            writer.EndObject();
+        });
+    }
+
+    void LspServer::hover(const std::string &id, const std::shared_ptr<Document> &document, size_t line, size_t character) {
+        std::lock_guard<std::mutex> lock(document->mutex);
+        if (line >= document->lines.size() || !isCommandLine(document->lines[line].text)) {
+            sendResult(id, [](JsonWriter &writer) {
+                writer.Null();
+            });
+            return;
+        }
+        Line &item = document->lines[line];
+        CHelperCore &core = getCore(item);
+        core.onSelectionChanged(std::min(character, item.text.size()));
+        std::u16string paramHint = core.getParamHint();
+        std::u16string structure = core.getStructure();
+        sendResult(id, [&paramHint, &structure](JsonWriter &writer) {
+            writer.StartObject();
+            writer.Key("contents");
+            writer.StartObject();
+            writer.Key("kind");
+            writer.String("plaintext");
+            writer.Key("value");
+            writeString(writer, paramHint.empty() ? structure : paramHint + u"\n\n" + structure);
+            writer.EndObject();
+            writer.EndObject();
+        });
+    }
+
+    void LspServer::semanticTokens(const std::string &id, const std::shared_ptr<Document> &document) {
+        std::lock_guard<std::mutex> lock(document->mutex);
+        // 每个高亮区间用5个整数表示，位置相对于上一个区间
+        std::vector<uint32_t> data;
+        size_t lastLine = 0, lastStart = 0;
+        for (size_t i = 0; i < document->lines.size(); ++i) {
+            // 整个文档的语义高亮耗时较长，定期检查请求是否被取消
+            if (i % 256 == 255 && isCancelled(id)) [[unlikely]] {
+                sendError(id, ErrorCode::REQUEST_CANCELLED, "request cancelled");
+                return;
+            }
+            Line &line = document->lines[i];
+            if (!isCommandLine(line.text)) {
+                continue;
+            }
+            SyntaxHighlight::SyntaxResult syntaxResult = getCore(line).getSyntaxResult();
+            const auto &tokenTypes = syntaxResult.tokenTypes;
+            size_t start = 0;
+            while (start < tokenTypes.size()) {
+                size_t end = start + 1;
+                while (end < tokenTypes.size() && tokenTypes[end] == tokenTypes[start]) {
+                    ++end;
+                }
+                int8_t tokenTypeIndex = SEMANTIC_TOKEN_TYPE_INDEX[tokenTypes[start]];
+                if (tokenTypeIndex >= 0) {
+                    data.push_back(static_cast<uint32_t>(i - lastLine));
+                    data.push_back(static_cast<uint32_t>(i == lastLine ? start - lastStart : start));
+                    data.push_back(static_cast<uint32_t>(end - start));
+                    data.push_back(static_cast<uint32_t>(tokenTypeIndex));
+                    data.push_back(0);
+                    lastLine = i;
+                    lastStart = start;
+                }
+                start = end;
+            }
+        }
+        sendResult(id, [&data](JsonWriter &writer) {
+            writer.StartObject();
+            writer.Key("data");
+            writer.StartArray();
+            for (uint32_t item: data) {
+                writer.Uint(item);
+            }
+            writer.EndArray();
+            writer.EndObject();
+        });
+    }
+
+}// namespace CHelper::Lsp
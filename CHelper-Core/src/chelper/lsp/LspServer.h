@@ -0,0 +1,169 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_LSPSERVER_H
+#define CHELPER_LSPSERVER_H
+
+#include <chelper/CHelperCore.h>
+#include <pch.h>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace CHelper::Lsp {
+
+    /**
+     * 文档中的一行，每一行是一条命令，使用时才创建内核
+     *
+     * 修改文档时只替换被修改的行，没有修改的行保留内核和诊断结果
+     */
+    class Line {
+    public:
+        std::u16string text;
+        std::unique_ptr<CHelperCore> core;
+        // 诊断结果的缓存，第一次发送诊断时计算
+        std::optional<std::vector<std::shared_ptr<ErrorReason>>> errorReasons;
+
+        explicit Line(std::u16string text);
+    };
+
+    class Document {
+    public:
+        // 后台线程读取文档时加锁，主线程修改文档时也要加锁
+        std::mutex mutex;
+        int64_t version = 0;
+        std::vector<Line> lines;
+    };
+
+    /**
+     * 通过LSP协议提供补全、诊断、语义高亮和悬浮提示，所有文档共享同一个资源包
+     *
+     * 消息在调用者的线程中按顺序处理，请求在后台线程池中执行，可以通过$/cancelRequest取消
+     *
+     * 不同文档的请求会在不同的线程中同时使用资源包，资源包中延迟加载的命令、ID的节点和哈希值都是线程安全的
+     */
+    class LspServer {
+    public:
+        using Output = std::function<void(const std::string &message)>;
+        using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+
+    private:
+        class RequestScope;
+
+        std::shared_ptr<const CPack> cpack;
+        Output output;
+        std::mutex outputMutex;
+        // 文档
+        std::mutex documentsMutex;
+        std::unordered_map<std::string, std::shared_ptr<Document>> documents;
+        // 还没有回复的请求，值为是否已经被取消，键为序列化后的请求id
+        std::mutex pendingMutex;
+        std::unordered_map<std::string, bool> pendingRequests;
+        // 线程池
+        std::mutex taskMutex;
+        std::condition_variable taskCondition;
+        std::condition_variable idleCondition;
+        std::deque<std::function<void()>> tasks;
+        size_t runningTaskCount = 0;
+        bool isStopping = false;
+        std::vector<std::thread> workers;
+        bool isShutdown = false;
+
+    public:
+        /**
+         * @param threadCount 后台线程数，为0时使用硬件线程数
+         */
+        LspServer(std::shared_ptr<const CPack> cpack, Output output, size_t threadCount = 0);
+
+        LspServer(const LspServer &) = delete;
+
+        LspServer &operator=(const LspServer &) = delete;
+
+        ~LspServer();
+
+        /**
+         * 处理一条JSON-RPC消息
+         *
+         * @return 是否收到了exit通知
+         */
+        bool handleMessage(std::string_view message);
+
+        /**
+         * 等待所有后台任务完成
+         */
+        void waitIdle();
+
+        /**
+         * 从输入流中读取带Content-Length头的消息，直到收到exit通知或输入结束
+         *
+         * @return 进程的退出码
+         */
+        static int run(std::shared_ptr<const CPack> cpack, std::istream &istream, std::ostream &ostream, size_t threadCount = 0);
+
+        static std::optional<std::string> readMessage(std::istream &istream);
+
+        static void writeMessage(std::ostream &ostream, std::string_view message);
+
+    private:
+        void submit(std::function<void()> task);
+
+        void send(const std::function<void(JsonWriter &writer)> &write);
+
+        void sendResult(const std::string &id, const std::function<void(JsonWriter &writer)> &writeResult);
+
+        void sendError(const std::string &id, int code, std::string_view message);
+
+        void sendNotification(std::string_view method, const std::function<void(JsonWriter &writer)> &writeParams);
+
+        bool isCancelled(const std::string &id);
+
+        /**
+         * 请求被取消时回复错误
+         *
+         * @return 请求是否被取消
+         */
+        bool replyIfCancelled(const std::string &id);
+
+        void finishRequest(const std::string &id);
+
+        std::shared_ptr<Document> getDocument(const rapidjson::Value &params);
+
+        CHelperCore &getCore(Line &line);
+
+        const std::vector<std::shared_ptr<ErrorReason>> &getErrorReasons(Line &line);
+
+        void handleRequest(const std::string &method, const std::string &id, const rapidjson::Value &params);
+
+        void handleNotification(const std::string &method, const rapidjson::Value &params);
+
+        void schedulePublishDiagnostics(const std::string &uri, const std::shared_ptr<Document> &document, int64_t version);
+
+        void publishDiagnostics(const std::string &uri, const std::shared_ptr<Document> &document, int64_t version);
+
+        void completion(const std::string &id, const std::shared_ptr<Document> &document, size_t line, size_t character);
+
+        void hover(const std::string &id, const std::shared_ptr<Document> &document, size_t line, size_t character);
+
+        void semanticTokens(const std::string &id, const std::shared_ptr<Document> &document);
+    };
+
+}// namespace CHelper::Lsp
+
+#endif//CHELPER_LSPSERVER_H
@@ -336,6 +336,22 @@ namespace CHelper {
             NodeBlock() = default;
         };
 
+        /**
+         * 从二进制资源包加载时还没有解析的命令数据
+         *
+         * 同一个资源包可能被多个线程同时使用，解析时加锁，解析完成后才对其它线程可见
+         */
+        class LazyCommandData {
+        public:
+            std::mutex mutex;
+            std::atomic<bool> isLoaded = false;
+            std::string data;
+            bool isNeedConvert = false;
+            const CPack *cpack = nullptr;
+            //data中的字符串引用的字符串池，为空时字符串直接写在data中，所有命令解析完成后字符串池会被释放
+            std::shared_ptr<StringPool> stringPool;
+        };
+
         class NodePerCommand : public NodeBase {
         public:
             static constexpr NodeTypeId::NodeTypeId nodeTypeId = NodeTypeId::PER_COMMAND;
@@ -343,10 +359,21 @@ namespace CHelper {
             std::optional<std::u16string> description;
             std::vector<std::u16string> syntax;
             FreeableNodeWithTypes nodes;
+            //加载资源包时去重得到的节点，和其它命令中完全相同的节点共用，所有权在其它命令的nodes中
+            std::vector<NodeWithType> sharedNodes;
             std::vector<NodeWrapped> wrappedNodes;
             std::vector<NodeWrapped *> startNodes;
+            //从二进制资源包加载时，命令的节点在第一次使用时才解析，创建后不再改变指向
+            std::unique_ptr<LazyCommandData> lazyData;
 
             NodePerCommand() = default;
+
+            //如果节点还没有解析，进行解析和初始化，可以在多个线程中同时调用
+            void load() const;
+
+            [[nodiscard]] bool isLoaded() const {
+                return lazyData == nullptr || lazyData->isLoaded.load(std::memory_order_acquire);
+            }
         };
 
         class NodeCommand : public NodeSerializable {
@@ -410,6 +437,7 @@ namespace CHelper {
             NodeItemType::NodeItemType nodeItemType = NodeItemType::ITEM_GIVE;
             NodeNamespaceId nodeItemId;
             std::shared_ptr<std::vector<std::shared_ptr<ItemId>>> itemIds;
+            std::shared_ptr<IdNodeCache> itemNodeCache;
             NodeJson nodeComponent;
 
             NodeItem() = default;
@@ -71,6 +71,7 @@ namespace CHelper::Node {
     struct NodeInitialization<NodeItem> {
         static void init(NodeItem &node, const CPack &cpack) {
             node.itemIds = cpack.itemIds;
+            node.itemNodeCache = cpack.itemNodeCache;
             node.nodeItemId = NodeNamespaceId("ITEM_ID", u"物品ID", "item", true);
             node.nodeComponent = NodeJson("ITEM_COMPONENT", u"物品组件", "components");
             initNode(node.nodeItemId, cpack);
@@ -142,6 +143,15 @@ namespace CHelper::Node {
     template<>
     struct NodeInitialization<NodePerCommand> {
         static void init(NodePerCommand &node, const CPack &cpack) {
+            if (!node.isLoaded()) [[likely]] {
+                // 等到第一次使用的时候再初始化
+                node.lazyData->cpack = &cpack;
+                return;
+            }
+            initNodes(node, cpack);
+        }
+
+        static void initNodes(NodePerCommand &node, const CPack &cpack) {
             for (auto &definition: node.nodes.nodes) {
                 Profile::push(R"(init node {}: "{}")",
                               FORMAT_ARG(getNodeTypeName(definition.nodeTypeId)),
@@ -341,6 +351,69 @@ namespace CHelper::Node {
         }
     };
 
+    /**
+     * 在作用域内切换节点的创建阶段，离开作用域时恢复，抛出异常时也会恢复
+     */
+    class NodeCreateStageScope {
+    private:
+        NodeCreateStage::NodeCreateStage lastCreateStage;
+
+    public:
+        explicit NodeCreateStageScope(NodeCreateStage::NodeCreateStage createStage)
+            : lastCreateStage(currentCreateStage) {
+            currentCreateStage = createStage;
+        }
+
+        NodeCreateStageScope(const NodeCreateStageScope &) = delete;
+
+        NodeCreateStageScope &operator=(const NodeCreateStageScope &) = delete;
+
+        ~NodeCreateStageScope() {
+            currentCreateStage = lastCreateStage;
+        }
+    };
+
+    void NodePerCommand::load() const {
+        if (isLoaded()) [[likely]] {
+            return;
+        }
+        std::lock_guard lock(lazyData->mutex);
+        if (lazyData->isLoaded.load(std::memory_order_relaxed)) {
+            // 其它线程已经解析完成
+            return;
+        }
+        Profile::Scope profileScope(R"(loading command: "{}")", FORMAT_ARG(utf8::utf16to8(name[0])));
+        // 先解析到临时的命令中，成功后再替换，解析失败时保留原来的数据
+        NodePerCommand command;
+        std::vector<XXH64_hash_t> nodeHashes;
+        {
+            NodeCreateStageScope createStageScope(NodeCreateStage::COMMAND_PARAM_NODE);
+            // 节点中的字符串引用的是加载资源包时读取的字符串池
+            StringPool::Scope stringPoolScope(lazyData->stringPool.get());
+            std::istringstream istream(lazyData->data);
+            if (lazyData->isNeedConvert) {
+                serialization::Codec<NodePerCommand>::from_binary_body<true>(istream, command, nodeHashes);
+            } else {
+                serialization::Codec<NodePerCommand>::from_binary_body<false>(istream, command, nodeHashes);
+            }
+        }
+        if (lazyData->cpack != nullptr) [[likely]] {
+            NodeInitialization<NodePerCommand>::initNodes(command, *lazyData->cpack);
+            // 和已经加载的命令共用完全相同的节点，这是最后一个可能失败的步骤
+            lazyData->cpack->shareIdenticalNodes(command, nodeHashes);
+        }
+        // 对外表现为只读，解析只是把数据从另一种形式展开，其它线程在解析完成之前不会读取这些数据
+        auto &node = const_cast<NodePerCommand &>(*this);
+        node.nodes = std::move(command.nodes);
+        node.sharedNodes = std::move(command.sharedNodes);
+        node.wrappedNodes = std::move(command.wrappedNodes);
+        node.startNodes = std::move(command.startNodes);
+        std::string().swap(lazyData->data);
+        // 最后一条命令解析完成后字符串池被释放，解析出来的字符串都是复制的，不会再引用字符串池
+        lazyData->stringPool = nullptr;
+        lazyData->isLoaded.store(true, std::memory_order_release);
+    }
+
     void initNode(Node::NodeWithType node, const CPack &cpack) {
         switch (node.nodeTypeId) {
             CODEC_PASTE(CHELPER_INIT, CHELPER_NODE_TYPES)
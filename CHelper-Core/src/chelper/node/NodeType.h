@@ -335,6 +335,18 @@ namespace CHelper {
             static constexpr auto name = "OPTIONAL";
         };
 
+        /**
+         * 生成以节点类型为下标的函数表，用来代替每次访问节点时的switch
+         *
+         * Function<nodeTypeId>::call是这种节点类型的实现，所有节点类型的call必须是相同的函数类型
+         */
+        template<template<NodeTypeId::NodeTypeId> class Function>
+        consteval auto createNodeTypeTable() {
+            return []<size_t... index>(std::index_sequence<index...>) {
+                return std::array{&Function<NodeTypeIds::ALL[index]>::call...};
+            }(std::make_index_sequence<NODE_TYPE_COUNT>());
+        }
+
         const char *getNodeTypeName(NodeTypeId::NodeTypeId id);
 
         std::optional<NodeTypeId::NodeTypeId> getNodeTypeIdByName(const std::string_view &name);
@@ -70,6 +70,14 @@ namespace CHelper::Node {
         };
     }// namespace NodeTypeId
 
+    namespace NodeTypeIds {
+        using namespace NodeTypeId;
+        // 和NodeTypeId的定义使用同一个列表，新增节点类型时数量会自动更新
+        constexpr std::array ALL = {CHELPER_NODE_TYPES};
+    }// namespace NodeTypeIds
+
+    constexpr size_t NODE_TYPE_COUNT = NodeTypeIds::ALL.size();
+
     class NodeBase;
 
     class NodeWithType {
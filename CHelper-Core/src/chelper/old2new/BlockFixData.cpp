@@ -0,0 +1,163 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/old2new/BlockFixData.h>
+
+namespace CHelper::Old2New {
+
+    // 平均每个桶的键的数量
+    static constexpr size_t KEY_PER_BUCKET = 4;
+    // 找不到合适的种子时放弃构建
+    static constexpr uint32_t MAX_SEED = 1 << 24;
+
+    static uint32_t appendString(std::u16string &strings,
+                                 std::unordered_map<std::u16string, uint32_t> &offsets,
+                                 const std::u16string &str) {
+        auto [it, isInserted] = offsets.try_emplace(str, static_cast<uint32_t>(strings.size()));
+        if (isInserted) {
+            strings.append(str);
+        }
+        return it->second;
+    }
+
+    BlockFixData::BlockFixData(const std::vector<Item> &items) {
+        // 去重，保留第一个
+        std::vector<const Item *> uniqueItems;
+        uniqueItems.reserve(items.size());
+        {
+            std::unordered_set<std::u16string> keys;
+            for (const auto &item: items) {
+                std::u16string key = item.name;
+                key.push_back(static_cast<char16_t>(item.data >> 16));
+                key.push_back(static_cast<char16_t>(item.data & 0xFFFF));
+                if (keys.insert(std::move(key)).second) {
+                    uniqueItems.push_back(&item);
+                }
+            }
+        }
+        if (uniqueItems.empty()) [[unlikely]] {
+            return;
+        }
+        // 字符串去重
+        std::unordered_map<std::u16string, uint32_t> offsets;
+        auto toEntry = [this, &offsets](const Item &item) {
+            Entry entry{};
+            entry.nameOffset = appendString(strings, offsets, item.name);
+            entry.nameLength = static_cast<uint32_t>(item.name.size());
+            entry.data = item.data;
+            if (item.newBlockId.has_value()) {
+                entry.newBlockIdOffset = appendString(strings, offsets, item.newBlockId.value());
+                entry.newBlockIdLength = static_cast<uint32_t>(item.newBlockId.value().size());
+            } else {
+                entry.newBlockIdOffset = UINT32_MAX;
+                entry.newBlockIdLength = 0;
+            }
+            if (item.blockState.has_value()) {
+                entry.blockStateOffset = appendString(strings, offsets, item.blockState.value());
+                entry.blockStateLength = static_cast<uint32_t>(item.blockState.value().size());
+            } else {
+                entry.blockStateOffset = UINT32_MAX;
+                entry.blockStateLength = 0;
+            }
+            return entry;
+        };
+        // 分桶，键多的桶先放，这时空位比较多，容易找到种子
+        size_t entryCount = uniqueItems.size();
+        size_t bucketCount = (entryCount + KEY_PER_BUCKET - 1) / KEY_PER_BUCKET;
+        std::vector<std::vector<const Item *>> buckets(bucketCount);
+        for (const auto &item: uniqueItems) {
+            buckets[hash(item->name, item->data, 0) % bucketCount].push_back(item);
+        }
+        std::vector<size_t> bucketOrder(bucketCount);
+        for (size_t i = 0; i < bucketCount; ++i) {
+            bucketOrder[i] = i;
+        }
+        std::ranges::stable_sort(bucketOrder, [&buckets](size_t a, size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+        seeds.assign(bucketCount, 0);
+        entries.resize(entryCount);
+        std::vector<bool> isUsed(entryCount, false);
+        std::vector<size_t> slots;
+        for (size_t bucketIndex: bucketOrder) {
+            const auto &bucket = buckets[bucketIndex];
+            if (bucket.empty()) {
+                break;
+            }
+            bool isFound = false;
+            for (uint32_t seed = 1; seed < MAX_SEED; ++seed) {
+                slots.clear();
+                for (const auto &item: bucket) {
+                    size_t slot = hash(item->name, item->data, seed) % entryCount;
+                    if (isUsed[slot] || std::ranges::find(slots, slot) != slots.end()) {
+                        break;
+                    }
+                    slots.push_back(slot);
+                }
+                if (slots.size() == bucket.size()) {
+                    seeds[bucketIndex] = seed;
+                    isFound = true;
+                    break;
+                }
+            }
+            if (!isFound) [[unlikely]] {
+                Profile::push("fail to build perfect hash of block fix data, bucket size: {}", FORMAT_ARG(bucket.size()));
+                throw std::runtime_error("fail to build perfect hash of block fix data");
+            }
+            for (size_t i = 0; i < bucket.size(); ++i) {
+                isUsed[slots[i]] = true;
+                entries[slots[i]] = toEntry(*bucket[i]);
+            }
+        }
+    }
+
+    std::optional<BlockFixData::Result> BlockFixData::find(std::u16string_view name, uint32_t data) const {
+        if (entries.empty()) [[unlikely]] {
+            return std::nullopt;
+        }
+        uint32_t seed = seeds[hash(name, data, 0) % seeds.size()];
+        if (seed == 0) {
+            // 空桶
+            return std::nullopt;
+        }
+        const Entry &entry = entries[hash(name, data, seed) % entries.size()];
+        if (entry.data != data || std::u16string_view(strings).substr(entry.nameOffset, entry.nameLength) != name) {
+            return std::nullopt;
+        }
+        return Result{getString(entry.newBlockIdOffset, entry.newBlockIdLength),
+                      getString(entry.blockStateOffset, entry.blockStateLength)};
+    }
+
+    size_t BlockFixData::size() const {
+        return entries.size();
+    }
+
+    uint64_t BlockFixData::hash(std::u16string_view name, uint32_t data, uint32_t seed) {
+        // 二进制文件中的种子依赖这个哈希函数，修改后需要重新生成
+        return XXH3_64bits_withSeed(name.data(), name.size() * sizeof(char16_t),
+                                    (static_cast<uint64_t>(seed) << 32) | data);
+    }
+
+    std::optional<std::u16string_view> BlockFixData::getString(uint32_t offset, uint32_t length) const {
+        if (offset == UINT32_MAX) {
+            return std::nullopt;
+        }
+        return std::u16string_view(strings).substr(offset, length);
+    }
+
+}// namespace CHelper::Old2New
@@ -0,0 +1,178 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_BLOCKFIXDATA_H
+#define CHELPER_BLOCKFIXDATA_H
+
+#include <pch.h>
+
+namespace CHelper::Old2New {
+
+    /**
+     * 旧版方块ID和数据值到新版方块ID和方块状态的映射
+     *
+     * 所有字符串去重后拼接在一起，通过偏移和长度引用。
+     * 使用hash and displace构建最小完美哈希，查询时只需要计算两次哈希、比较一次键，
+     * 二进制文件中的数组可以直接整块读取
+     */
+    class BlockFixData {
+    public:
+        //二进制文件开头的标识，内容为"CHBF"
+        static constexpr uint32_t BINARY_MAGIC = 0x46424843;
+        //二进制文件的格式版本，格式改变时加一，版本不同的文件需要用资源生成器重新生成
+        static constexpr uint32_t BINARY_FORMAT_VERSION = 1;
+
+        class Item {
+        public:
+            std::u16string name;
+            uint32_t data = 0;
+            std::optional<std::u16string> newBlockId;
+            std::optional<std::u16string> blockState;
+        };
+
+        class Result {
+        public:
+            std::optional<std::u16string_view> newBlockId;
+            std::optional<std::u16string_view> blockState;
+        };
+
+        class Entry {
+        public:
+            uint32_t nameOffset;
+            uint32_t nameLength;
+            uint32_t data;
+            // 字符串不存在时偏移为UINT32_MAX
+            uint32_t newBlockIdOffset;
+            uint32_t newBlockIdLength;
+            uint32_t blockStateOffset;
+            uint32_t blockStateLength;
+        };
+
+        // 所有字符串
+        std::u16string strings;
+        // 每个桶的哈希种子
+        std::vector<uint32_t> seeds;
+        // 按完美哈希排列的数据
+        std::vector<Entry> entries;
+
+        BlockFixData() = default;
+
+        /**
+         * 构建完美哈希，键重复时保留第一个
+         */
+        explicit BlockFixData(const std::vector<Item> &items);
+
+        [[nodiscard]] std::optional<Result> find(std::u16string_view name, uint32_t data) const;
+
+        [[nodiscard]] size_t size() const;
+
+        static uint64_t hash(std::u16string_view name, uint32_t data, uint32_t seed);
+
+    private:
+        [[nodiscard]] std::optional<std::u16string_view> getString(uint32_t offset, uint32_t length) const;
+    };
+
+}// namespace CHelper::Old2New
+
+template<>
+struct serialization::Codec<CHelper::Old2New::BlockFixData> : BaseCodec<CHelper::Old2New::BlockFixData> {
+
+    using Type = CHelper::Old2New::BlockFixData;
+
+    constexpr static bool enable = true;
+
+    static_assert(std::is_trivially_copyable_v<Type::Entry> && sizeof(Type::Entry) == 7 * sizeof(uint32_t));
+
+    template<bool isNeedConvert, class T>
+    static void to_binary_array(std::ostream &ostream, const std::vector<T> &t) {
+        Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, static_cast<uint32_t>(t.size()));
+        if constexpr (isNeedConvert) {
+            const auto *data = reinterpret_cast<const uint32_t *>(t.data());
+            for (size_t i = 0; i < t.size() * sizeof(T) / sizeof(uint32_t); ++i) {
+                Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, data[i]);
+            }
+        } else {
+            ostream.write(reinterpret_cast<const char *>(t.data()), static_cast<std::streamsize>(t.size() * sizeof(T)));
+        }
+    }
+
+    template<bool isNeedConvert, class T>
+    static void from_binary_array(std::istream &istream, std::vector<T> &t) {
+        uint32_t size;
+        Codec<uint32_t>::template from_binary<isNeedConvert>(istream, size);
+        t.resize(static_cast<size_t>(size));
+        if constexpr (isNeedConvert) {
+            auto *data = reinterpret_cast<uint32_t *>(t.data());
+            for (size_t i = 0; i < t.size() * sizeof(T) / sizeof(uint32_t); ++i) {
+                Codec<uint32_t>::template from_binary<isNeedConvert>(istream, data[i]);
+            }
+        } else {
+            istream.read(reinterpret_cast<char *>(t.data()), static_cast<std::streamsize>(t.size() * sizeof(T)));
+        }
+    }
+
+    template<bool isNeedConvert>
+    static void to_binary(std::ostream &ostream,
+                          const Type &t) {
+        Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, Type::BINARY_MAGIC);
+        Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, Type::BINARY_FORMAT_VERSION);
+        Codec<decltype(t.strings)>::template to_binary<isNeedConvert>(ostream, t.strings);
+        to_binary_array<isNeedConvert>(ostream, t.seeds);
+        to_binary_array<isNeedConvert>(ostream, t.entries);
+    }
+
+    template<bool isNeedConvert>
+    static void from_binary(std::istream &istream,
+                            Type &t) {
+        uint32_t magic = 0;
+        Codec<uint32_t>::template from_binary<isNeedConvert>(istream, magic);
+        if (!istream || magic != Type::BINARY_MAGIC) [[unlikely]] {
+            CHelper::Profile::push("block fix data should start with \"CHBF\", it may be written by an old version");
+            throw std::runtime_error("unknown block fix data format");
+        }
+        uint32_t formatVersion = 0;
+        Codec<uint32_t>::template from_binary<isNeedConvert>(istream, formatVersion);
+        if (!istream || formatVersion != Type::BINARY_FORMAT_VERSION) [[unlikely]] {
+            CHelper::Profile::push("block fix data format version is {}, but {} is required", FORMAT_ARG(formatVersion), FORMAT_ARG(Type::BINARY_FORMAT_VERSION));
+            throw std::runtime_error("unsupported block fix data format version");
+        }
+        Codec<decltype(t.strings)>::template from_binary<isNeedConvert>(istream, t.strings);
+        from_binary_array<isNeedConvert>(istream, t.seeds);
+        from_binary_array<isNeedConvert>(istream, t.entries);
+        if (t.seeds.empty() != t.entries.empty()) [[unlikely]] {
+            throw std::runtime_error("error block fix data");
+        }
+        auto isValidString = [&t](uint32_t offset, uint32_t length, bool isOptional) {
+            if (offset == UINT32_MAX) {
+                return isOptional;
+            }
+            return static_cast<size_t>(offset) + length <= t.strings.size();
+        };
+        for (const auto &item: t.entries) {
+            if (!isValidString(item.nameOffset, item.nameLength, false) ||
+                !isValidString(item.newBlockIdOffset, item.newBlockIdLength, true) ||
+                !isValidString(item.blockStateOffset, item.blockStateLength, true)) [[unlikely]] {
+                throw std::runtime_error("error block fix data");
+            }
+        }
+    }
+};
+
+#endif//CHELPER_BLOCKFIXDATA_H
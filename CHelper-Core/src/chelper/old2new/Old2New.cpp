@@ -36,22 +36,68 @@ namespace CHelper::Old2New {
           end(tokens.endIndex),
           content(std::move(content)) {}
 
-    std::u16string trip(std::u16string str) {
-        str.erase(0, str.find_first_not_of(' '));
-        str.erase(str.find_last_not_of(' ') + 1);
-        return str;
+    /**
+     * 收集start到当前指针的token
+     */
+    TokensView collect(const TokenReader &tokenReader, size_t start) {
+        return {tokenReader.lexerResult, start, tokenReader.index};
     }
 
-    bool expect(TokenReader &tokenReader, const std::function<bool(const Token &token)> &check) {
-        tokenReader.push();
-        tokenReader.skipSpace();
-        const Token *token = tokenReader.read();
-        if (token == nullptr || !check(*token)) {
-            tokenReader.restore();
-            return false;
+    std::u16string_view trip(std::u16string_view str) {
+        size_t start = str.find_first_not_of(u' ');
+        if (start == std::u16string_view::npos) {
+            return {};
+        }
+        return str.substr(start, str.find_last_not_of(u' ') + 1 - start);
+    }
+
+    /**
+     * 解析方块数据值，和strtoimax一样允许前导空格和正负号，超出范围时取最大值
+     *
+     * @return 不是非负整数时返回空
+     */
+    std::optional<uint32_t> parseDataValue(std::u16string_view str) {
+        size_t index = 0;
+        while (index < str.size() && str[index] == u' ') {
+            index++;
+        }
+        bool isNegative = false;
+        if (index < str.size() && (str[index] == u'+' || str[index] == u'-')) {
+            isNegative = str[index] == u'-';
+            index++;
+        }
+        if (index == str.size()) {
+            return std::nullopt;
+        }
+        std::intmax_t result = 0;
+        for (; index < str.size(); index++) {
+            char16_t ch = str[index];
+            if (ch < u'0' || ch > u'9') {
+                return std::nullopt;
+            }
+            int digit = ch - u'0';
+            if (result > (INTMAX_MAX - digit) / 10) {
+                result = INTMAX_MAX;
+            } else {
+                result = result * 10 + digit;
+            }
+        }
+        if (isNegative && result != 0) {
+            return std::nullopt;
+        }
+        return static_cast<uint32_t>(result);
+    }
+
+    /**
+     * 把方块状态中的冒号替换为等号
+     */
+    void fixBlockStateSeparator(const TokensView &tokens, std::vector<DataFix> &dataFixList) {
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            const Token &token = tokens[i];
+            if (token.type == TokenType::SYMBOL && token.content == u":") {
+                dataFixList.emplace_back(token.getStartIndex(), token.getEndIndex(), u"=");
+            }
         }
-        tokenReader.pop();
-        return true;
     }
 
     bool expectString(TokenReader &tokenReader) {
@@ -60,14 +106,14 @@ namespace CHelper::Old2New {
         });
     }
 
-    bool expectString(TokenReader &tokenReader, const std::u16string &str) {
-        return expect(tokenReader, [&str](const Token &token) {
+    bool expectString(TokenReader &tokenReader, std::u16string_view str) {
+        return expect(tokenReader, [str](const Token &token) {
             return token.type == TokenType::STRING && token.content == str;
         });
     }
 
     bool expectSymbol(TokenReader &tokenReader, char16_t ch) {
-        return expect(tokenReader, [&ch](const Token &token) {
+        return expect(tokenReader, [ch](const Token &token) {
             return token.type == TokenType::SYMBOL && token.content.length() == 1 && token.content[0] == ch;
         });
     }
@@ -79,16 +125,14 @@ namespace CHelper::Old2New {
     }
 
     bool expectList(TokenReader &tokenReader, char16_t leftSymbol, char16_t rightSymbol) {
-        tokenReader.push();
+        size_t start = tokenReader.index;
         if (!expectSymbol(tokenReader, leftSymbol)) {
-            tokenReader.restore();
             return false;
         }
         size_t left = 1;
         size_t right = 0;
         while (true) {
             if (left == right) {
-                tokenReader.pop();
                 return true;
             }
             if (expectSymbol(tokenReader, leftSymbol)) {
@@ -100,7 +144,7 @@ namespace CHelper::Old2New {
                 continue;
             }
             if (!tokenReader.skip()) {
-                tokenReader.restore();
+                tokenReader.index = start;
                 return false;
             }
         }
@@ -110,13 +154,12 @@ namespace CHelper::Old2New {
         if (expectString(tokenReader)) {
             return true;
         }
-        tokenReader.push();
+        size_t start = tokenReader.index;
         if (!expectSymbol(tokenReader, u'@')) {
-            tokenReader.restore();
             return false;
         }
         if (!expectString(tokenReader)) {
-            tokenReader.restore();
+            tokenReader.index = start;
             return false;
         }
         expectList(tokenReader, u'[', u']');
@@ -124,80 +167,60 @@ namespace CHelper::Old2New {
     }
 
     bool expectRelativeFloat(TokenReader &tokenReader) {
-        tokenReader.push();
         if (expectSymbol(tokenReader, u'~') || expectSymbol(tokenReader, u'^')) {
-            tokenReader.push();
-            if (!tokenReader.skipSpace()) {
-                tokenReader.pop();
+            size_t start = tokenReader.index;
+            if (tokenReader.skipSpace() == 0) {
                 expectNumber(tokenReader);
             } else {
-                tokenReader.restore();
+                tokenReader.index = start;
             }
-            tokenReader.pop();
-            return true;
-        }
-        if (!expectNumber(tokenReader)) {
-            tokenReader.restore();
-            return false;
-        } else {
-            tokenReader.pop();
             return true;
         }
+        return expectNumber(tokenReader);
     }
 
     bool expectPosition(TokenReader &tokenReader) {
-        tokenReader.push();
-        if (!expectRelativeFloat(tokenReader)) {
-            tokenReader.restore();
+        size_t start = tokenReader.index;
+        if (!expectRelativeFloat(tokenReader) ||
+            !expectRelativeFloat(tokenReader) ||
+            !expectRelativeFloat(tokenReader)) {
+            tokenReader.index = start;
             return false;
         }
-        if (!expectRelativeFloat(tokenReader)) {
-            tokenReader.restore();
-            return false;
-        }
-        if (!expectRelativeFloat(tokenReader)) {
-            tokenReader.restore();
-            return false;
-        }
-        tokenReader.pop();
         return true;
     }
 
     std::u16string blockOld2New(const BlockFixData &blockFixData, const TokensView &blockIdToken, const TokensView &dataValueToken) {
         // get block id
-        auto blockId = std::u16string(blockIdToken.string());
+        std::u16string_view blockId = blockIdToken.string();
         // get block data value
-        char *end;
-        std::string dataValueStr = utf8::utf16to8(dataValueToken.string());
-        std::intmax_t dataValue = std::strtoimax(dataValueStr.c_str(), &end, 10);
-        if (end == dataValueStr.c_str() || *end != '\0' ||
-            dataValue == HUGE_VALF || dataValue == -HUGE_VALF ||
-            dataValue < 0) [[unlikely]] {
+        std::optional<uint32_t> dataValue = parseDataValue(dataValueToken.string());
+        if (!dataValue.has_value()) [[unlikely]] {
             // if it is not an integer or in range, return block id directly
-            return blockId;
+            return std::u16string(blockId);
         }
         // get key
-        std::u16string front = u"minecraft:";
-        std::u16string key = trip(blockId);
+        constexpr std::u16string_view front = u"minecraft:";
+        std::u16string_view key = trip(blockId);
         if (key.size() > front.size() && key.starts_with(front)) {
-            key = key.substr(front.size());
+            key.remove_prefix(front.size());
         }
         // find fixed block state by key
-        auto blockIdIter = blockFixData.find(key);
-        if (blockIdIter == blockFixData.end()) {
-            return blockId;
-        }
-        const auto &dataValueToBlockState = blockIdIter->second;
-        auto dataValueIter = dataValueToBlockState.find(static_cast<uint32_t>(dataValue));
-        if (dataValueIter == dataValueToBlockState.end()) {
-            return blockId;
-        }
-        const auto &blockIdWithBlockState = dataValueIter->second;
-        if (blockIdWithBlockState.first.has_value()) {
-            return front + blockIdWithBlockState.first.value() + blockIdWithBlockState.second.value_or(u"");
+        auto blockIdWithBlockState = blockFixData.find(key, dataValue.value());
+        if (!blockIdWithBlockState.has_value()) {
+            return std::u16string(blockId);
+        }
+        std::u16string_view blockState = blockIdWithBlockState->blockState.value_or(u"");
+        std::u16string result;
+        if (blockIdWithBlockState->newBlockId.has_value()) {
+            result.reserve(front.size() + blockIdWithBlockState->newBlockId->size() + blockState.size());
+            result.append(front).append(blockIdWithBlockState->newBlockId.value());
         } else {
-            return blockIdWithBlockState.first.value_or(blockId) + blockIdWithBlockState.second.value_or(u"");
+            result.reserve(blockId.size() + blockState.size());
+            result.append(blockId);
         }
+        result.append(blockState);
+        return result;
     }
 
     /**
@@ -206,120 +229,111 @@ namespace CHelper::Old2New {
      * 新语法例子：execute as @e at @s positioned ~~~ if block ~~-1~ stone setblock command_block ~~~
      */
     bool expectCommandExecute(const BlockFixData &blockFixData, TokenReader &tokenReader, std::vector<DataFix> &dataFixList, size_t depth) {
-        tokenReader.push();
+        size_t start = tokenReader.index;
         // execute
-        tokenReader.push();
         if (!expectString(tokenReader, u"execute")) {
-            tokenReader.restore();
-            tokenReader.restore();
             return false;
         }
-        TokensView tokens1 = tokenReader.collect();
+        TokensView tokens1 = collect(tokenReader, start);
         // @e
-        tokenReader.push();
+        size_t start2 = tokenReader.index;
         if (!expectTargetSelector(tokenReader)) {
-            tokenReader.restore();
-            tokenReader.restore();
+            tokenReader.index = start;
             return false;
         }
-        TokensView tokens2 = tokenReader.collect();
+        TokensView tokens2 = collect(tokenReader, start2);
         // ~~~
-        tokenReader.push();
+        size_t start3 = tokenReader.index;
         if (!expectPosition(tokenReader)) {
-            tokenReader.restore();
-            tokenReader.restore();
+            tokenReader.index = start;
             return false;
         }
-        TokensView tokens3 = tokenReader.collect();
+        TokensView tokens3 = collect(tokenReader, start3);
         // end?
-        tokenReader.pop();
         if (depth > 0) {
             dataFixList.emplace_back(tokens1, u"");
         }
-        auto targetSelector = std::u16string(tokens2.string());
+        std::u16string_view targetSelector = tokens2.string();
         if (trip(targetSelector) != u"@s") {
-            dataFixList.emplace_back(tokens2, u" as" + targetSelector + u" at @s");
+            std::u16string content;
+            content.reserve(targetSelector.size() + 9);
+            content.append(u" as").append(targetSelector).append(u" at @s");
+            dataFixList.emplace_back(tokens2, std::move(content));
         } else {
             dataFixList.emplace_back(tokens2, u"");
         }
         bool isHavePosition = false;
-        tokens3.forEach([&isHavePosition](const Token &token) {
-            if (token.type == TokenType::NUMBER) {
+        for (size_t i = 0; i < tokens3.size(); ++i) {
+            if (tokens3[i].type == TokenType::NUMBER) {
                 isHavePosition = true;
+                break;
             }
-        });
+        }
         if (isHavePosition) {
-            dataFixList.emplace_back(tokens3, u" positioned" + std::u16string(tokens3.string()));
+            std::u16string_view position = tokens3.string();
+            std::u16string content;
+            content.reserve(position.size() + 11);
+            content.append(u" positioned").append(position);
+            dataFixList.emplace_back(tokens3, std::move(content));
         } else {
             dataFixList.emplace_back(tokens3, u"");
         }
-        tokenReader.push();
         // detect
-        tokenReader.push();
+        size_t start4 = tokenReader.index;
         if (!expectString(tokenReader, u"detect")) {
-            tokenReader.pop();
             return true;
         }
-        TokensView tokens4 = tokenReader.collect();
+        TokensView tokens4 = collect(tokenReader, start4);
         // ~~-1~
         if (!expectPosition(tokenReader)) {
-            tokenReader.restore();
+            tokenReader.index = start4;
             return true;
         }
         // stone
-        tokenReader.push();
+        size_t start5 = tokenReader.index;
         if (!expectString(tokenReader)) {
-            tokenReader.restore();
-            tokenReader.restore();
+            tokenReader.index = start4;
             return true;
         }
-        TokensView tokens5 = tokenReader.collect();
+        TokensView tokens5 = collect(tokenReader, start5);
         // 0
-        tokenReader.push();
+        size_t start6 = tokenReader.index;
         if (expectNumber(tokenReader)) {
-            TokensView tokens6 = tokenReader.collect();
+            TokensView tokens6 = collect(tokenReader, start6);
             dataFixList.emplace_back(tokens4, u" if block");
             dataFixList.emplace_back(tokens5, blockOld2New(blockFixData, tokens5, tokens6));
             dataFixList.emplace_back(tokens6, u"");
         } else if (expectSymbol(tokenReader, u'[')) {
-            tokenReader.restore();
-            tokenReader.push();
+            tokenReader.index = start6;
             expectList(tokenReader, u'[', u']');
-            TokensView tokens6 = tokenReader.collect();
+            TokensView tokens6 = collect(tokenReader, start6);
             dataFixList.emplace_back(tokens4, u" if block");
-            tokens6.forEach([&dataFixList](const Token &token) {
-                if (token.type == TokenType::SYMBOL && token.content == u":") {
-                    dataFixList.emplace_back(token.getStartIndex(), token.getEndIndex(), u"=");
-                }
-            });
+            fixBlockStateSeparator(tokens6, dataFixList);
         } else {
-            tokenReader.restore();
-            tokenReader.restore();
+            tokenReader.index = start4;
             return true;
         }
         // end
-        tokenReader.pop();
         return true;
     }
 
     bool expectCommandExecuteRepeat(const BlockFixData &blockFixData, TokenReader &tokenReader, std::vector<DataFix> &dataFixList) {
         size_t depth = 0;
         while (true) {
-            tokenReader.push();
+            size_t start = tokenReader.index;
             expectSymbol(tokenReader, u'/');
             if (!expectCommandExecute(blockFixData, tokenReader, dataFixList, depth)) {
-                tokenReader.restore();
+                tokenReader.index = start;
                 break;
             }
-            tokenReader.pop();
             depth++;
         }
         if (depth == 0) {
             return false;
         }
-        tokenReader.push();
+        size_t start = tokenReader.index;
         tokenReader.skipSpace();
-        TokensView tokens = tokenReader.collect();
+        TokensView tokens = collect(tokenReader, start);
         dataFixList.emplace_back(tokens, u" run ");
         return true;
     }
@@ -330,26 +344,22 @@ namespace CHelper::Old2New {
      * 新语法例子：summon creeper ~ ~ ~ ~ ~ minecraft:become_charged "充能苦力怕"
      */
     bool expectCommandSummon(TokenReader &tokenReader, std::vector<DataFix> &dataFixList) {
-        tokenReader.push();
+        size_t start = tokenReader.index;
         // summon
         if (!expectString(tokenReader, u"summon")) {
-            tokenReader.restore();
             return false;
         }
         // creeper
         if (!expectString(tokenReader)) {
-            tokenReader.restore();
+            tokenReader.index = start;
             return false;
         }
-        // end?
-        tokenReader.pop();
         // ~~~
         if (!expectPosition(tokenReader)) {
             return true;
         }
         // end?
-        tokenReader.push();
-        TokensView tokens1 = tokenReader.collect();
+        TokensView tokens1 = collect(tokenReader, tokenReader.index);
         dataFixList.emplace_back(tokens1, u" 0 0");
         // minecraft:become_charged
         if (!expectString(tokenReader)) {
@@ -369,19 +379,16 @@ namespace CHelper::Old2New {
      * 新语法例子：structure load <name: string> <to:x y z> [rotation: Rotation] [mirror: Mirror] [includeEntities: Boolean] [includeBlocks: Boolean] [waterlogged: Boolean] [integrity: float] [seed: string]
      */
     bool expectCommandStructure(TokenReader &tokenReader, std::vector<DataFix> &dataFixList) {
-        tokenReader.push();
+        size_t start = tokenReader.index;
         // structure
         if (!expectString(tokenReader, u"structure")) {
-            tokenReader.restore();
             return false;
         }
         // load
         if (!expectString(tokenReader, u"load")) {
-            tokenReader.restore();
+            tokenReader.index = start;
             return false;
         }
-        // end?
-        tokenReader.pop();
         // <name: string>
         if (!expectString(tokenReader)) {
             return false;
@@ -410,8 +417,7 @@ namespace CHelper::Old2New {
             return true;
         }
         // end?
-        tokenReader.push();
-        TokensView tokens1 = tokenReader.collect();
+        TokensView tokens1 = collect(tokenReader, tokenReader.index);
         dataFixList.emplace_back(tokens1, u" true");
         // [integrity: float]
         if (!expectNumber(tokenReader)) {
@@ -431,50 +437,40 @@ namespace CHelper::Old2New {
      * 新语法例子：setblock ~~~ stone["stone_type":"granite"] replace
      */
     bool expectCommandSetBlock(const BlockFixData &blockFixData, TokenReader &tokenReader, std::vector<DataFix> &dataFixList) {
-        tokenReader.push();
+        size_t start = tokenReader.index;
         // setblock
         if (!expectString(tokenReader, u"setblock")) {
-            tokenReader.restore();
             return false;
         }
         // ~~~
         if (!expectPosition(tokenReader)) {
-            tokenReader.restore();
+            tokenReader.index = start;
             return false;
         }
         // stone
-        tokenReader.push();
+        size_t start1 = tokenReader.index;
         if (!expectString(tokenReader)) {
-            tokenReader.restore();
-            tokenReader.restore();
+            tokenReader.index = start;
             return true;
         }
-        TokensView tokens1 = tokenReader.collect();
+        TokensView tokens1 = collect(tokenReader, start1);
         // 0
-        tokenReader.push();
+        size_t start2 = tokenReader.index;
         if (expectNumber(tokenReader)) {
-            TokensView tokens2 = tokenReader.collect();
+            TokensView tokens2 = collect(tokenReader, start2);
             dataFixList.emplace_back(tokens1, blockOld2New(blockFixData, tokens1, tokens2));
             dataFixList.emplace_back(tokens2, u"");
         } else if (expectSymbol(tokenReader, u'[')) {
-            tokenReader.restore();
-            tokenReader.push();
+            tokenReader.index = start2;
             expectList(tokenReader, u'[', u']');
-            TokensView tokens2 = tokenReader.collect();
-            tokens2.forEach([&dataFixList](const Token &token) {
-                if (token.type == TokenType::SYMBOL && token.content == u":") {
-                    dataFixList.emplace_back(token.getStartIndex(), token.getEndIndex(), u"=");
-                }
-            });
+            fixBlockStateSeparator(collect(tokenReader, start2), dataFixList);
         } else {
-            tokenReader.restore();
-            tokenReader.restore();
+            tokenReader.index = start;
             return true;
         }
         // replace
         tokenReader.skipToLF();
         // end
-        tokenReader.pop();
         return true;
     }
 
@@ -484,51 +480,40 @@ namespace CHelper::Old2New {
      * 新语法例子：fill ~~~~~~ stone["stone_type":"granite"] replace stone["stone_type":"granite_smooth"]
      */
     bool expectCommandFill(const BlockFixData &blockFixData, TokenReader &tokenReader, std::vector<DataFix> &dataFixList) {
-        tokenReader.push();
+        size_t start = tokenReader.index;
         // fill
         if (!expectString(tokenReader, u"fill")) {
-            tokenReader.restore();
             return false;
         }
         // ~~~
         if (!expectPosition(tokenReader)) {
-            tokenReader.restore();
+            tokenReader.index = start;
             return false;
         }
         // ~~~
         if (!expectPosition(tokenReader)) {
-            tokenReader.restore();
+            tokenReader.index = start;
             return false;
         }
         // stone
-        tokenReader.push();
+        size_t start1 = tokenReader.index;
         if (!expectString(tokenReader)) {
-            tokenReader.restore();
-            tokenReader.restore();
+            tokenReader.index = start;
             return true;
         }
-        TokensView tokens1 = tokenReader.collect();
-        // end?
-        tokenReader.pop();
+        TokensView tokens1 = collect(tokenReader, start1);
         // 0
-        tokenReader.push();
+        size_t start2 = tokenReader.index;
         if (expectNumber(tokenReader)) {
-            TokensView tokens2 = tokenReader.collect();
+            TokensView tokens2 = collect(tokenReader, start2);
             dataFixList.emplace_back(tokens1, blockOld2New(blockFixData, tokens1, tokens2));
             dataFixList.emplace_back(tokens2, u"");
         } else if (expectSymbol(tokenReader, u'[')) {
-            tokenReader.restore();
-            tokenReader.push();
+            tokenReader.index = start2;
             expectList(tokenReader, u'[', u']');
-            TokensView tokens2 = tokenReader.collect();
-            tokens2.forEach([&dataFixList](const Token &token) {
-                if (token.type == TokenType::SYMBOL && token.content == u":") {
-                    dataFixList.emplace_back(token.getStartIndex(), token.getEndIndex(), u"=");
-                }
-            });
+            fixBlockStateSeparator(collect(tokenReader, start2), dataFixList);
         } else {
-            tokenReader.restore();
-            tokenReader.restore();
+            tokenReader.index = start;
             return true;
         }
         // replace
@@ -536,31 +521,23 @@ namespace CHelper::Old2New {
             return true;
         }
         // stone
-        tokenReader.push();
+        size_t start3 = tokenReader.index;
         if (!expectString(tokenReader)) {
-            tokenReader.pop();
             return true;
         }
-        TokensView tokens3 = tokenReader.collect();
+        TokensView tokens3 = collect(tokenReader, start3);
         // 0
-        tokenReader.push();
+        size_t start4 = tokenReader.index;
         if (expectNumber(tokenReader)) {
-            TokensView tokens4 = tokenReader.collect();
+            TokensView tokens4 = collect(tokenReader, start4);
             dataFixList.emplace_back(tokens3, blockOld2New(blockFixData, tokens3, tokens4));
             dataFixList.emplace_back(tokens4, u"");
         } else if (expectSymbol(tokenReader, u'[')) {
-            tokenReader.restore();
-            tokenReader.push();
+            tokenReader.index = start4;
             expectList(tokenReader, u'[', u']');
-            TokensView tokens4 = tokenReader.collect();
-            tokens4.forEach([&dataFixList](const Token &token) {
-                if (token.type == TokenType::SYMBOL && token.content == u":") {
-                    dataFixList.emplace_back(token.getStartIndex(), token.getEndIndex(), u"=");
-                }
-            });
+            fixBlockStateSeparator(collect(tokenReader, start4), dataFixList);
         } else {
-            tokenReader.restore();
-            tokenReader.restore();
+            tokenReader.index = start;
             return true;
         }
         return true;
@@ -572,37 +549,32 @@ namespace CHelper::Old2New {
      * 新语法例子：testforblock ~~~ stone["stone_type":"granite"]
      */
     bool expectCommandTestForSetBlock(const BlockFixData &blockFixData, TokenReader &tokenReader, std::vector<DataFix> &dataFixList) {
-        tokenReader.push();
+        size_t start = tokenReader.index;
         // testforblock
         if (!expectString(tokenReader, u"testforblock")) {
-            tokenReader.restore();
             return false;
         }
         // ~~~
         if (!expectPosition(tokenReader)) {
-            tokenReader.restore();
+            tokenReader.index = start;
             return false;
         }
         // stone
-        tokenReader.push();
+        size_t start1 = tokenReader.index;
         if (!expectString(tokenReader)) {
-            tokenReader.restore();
-            tokenReader.restore();
+            tokenReader.index = start;
             return true;
         }
-        TokensView tokens1 = tokenReader.collect();
+        TokensView tokens1 = collect(tokenReader, start1);
         // 0
-        tokenReader.push();
+        size_t start2 = tokenReader.index;
         if (!expectNumber(tokenReader)) {
-            tokenReader.pop();
-            tokenReader.pop();
             return true;
         }
-        TokensView tokens2 = tokenReader.collect();
+        TokensView tokens2 = collect(tokenReader, start2);
         // end
         dataFixList.emplace_back(tokens1, blockOld2New(blockFixData, tokens1, tokens2));
         dataFixList.emplace_back(tokens2, u"");
-        tokenReader.pop();
         return true;
     }
 
@@ -628,16 +600,23 @@ namespace CHelper::Old2New {
         std::ranges::sort(dataFixList, [](const DataFix &dataFix1, const DataFix &dataFix2) {
             return dataFix1.start < dataFix2.start;
         });
+        std::u16string_view content = tokenReader.lexerResult->content;
+        // 结果的长度不会超过原文加上所有替换内容的长度，提前分配好内存
+        size_t capacity = content.size();
+        for (const auto &item: dataFixList) {
+            capacity += item.content.size();
+        }
         std::u16string result;
+        result.reserve(capacity);
         size_t index = 0;
         for (const auto &item: dataFixList) {
             if (item.start > index) {
-                result.append(tokenReader.lexerResult->content.substr(index, item.start - index));
+                result.append(content.substr(index, item.start - index));
             }
             result.append(item.content);
             index = item.end;
         }
-        result.append(tokenReader.lexerResult->content.substr(index));
+        result.append(content.substr(index));
         return result;
     }
 
@@ -646,7 +625,8 @@ namespace CHelper::Old2New {
         if (!j.IsArray()) [[unlikely]] {
             throw serialization::exceptions::JsonSerializationTypeException("array", serialization::getJsonTypeStr(j.GetType()));
         }
-        BlockFixData blockFixData;
+        std::vector<BlockFixData::Item> items;
+        items.reserve(j.GetArray().Size());
         for (const auto &item: j.GetArray()) {
             if (!item.IsObject()) [[unlikely]] {
                 throw serialization::exceptions::JsonSerializationTypeException("object", serialization::getJsonTypeStr(j.GetType()));
@@ -659,10 +639,9 @@ namespace CHelper::Old2New {
             serialization::Codec<decltype(newBlockId)>::template from_json_member<typename JsonValueType::ValueType>(item, serialization::details::JsonKey<DataFix, JsonValueType::Ch>::newBlockId_(), newBlockId);
             std::optional<std::u16string> blockState;
             serialization::Codec<decltype(blockState)>::template from_json_member<typename JsonValueType::ValueType>(item, serialization::details::JsonKey<DataFix, JsonValueType::Ch>::blockState_(), blockState);
-            const auto &iter = blockFixData.try_emplace(std::move(name)).first;
-            iter->second.insert({data, {std::move(newBlockId), std::move(blockState)}});
+            items.push_back({std::move(name), data, std::move(newBlockId), std::move(blockState)});
         }
-        return blockFixData;
+        return BlockFixData(items);
     }
 
 }// namespace CHelper::Old2New
@@ -21,12 +21,11 @@
 
 #include <chelper/lexer/Lexer.h>
 #include <chelper/lexer/TokenReader.h>
+#include <chelper/old2new/BlockFixData.h>
 #include <pch.h>
 
 namespace CHelper::Old2New {
 
-    using BlockFixData = std::unordered_map<std::u16string, std::unordered_map<uint32_t, std::pair<std::optional<std::u16string>, std::optional<std::u16string>>>>;
-
     class DataFix {
     public:
         size_t start, end;
@@ -37,11 +36,26 @@ namespace CHelper::Old2New {
         DataFix(const TokensView &tokens, std::u16string content);
     };
 
-    bool expect(TokenReader &tokenReader, const std::function<bool(const Token &token)> &check);
+    /**
+     * 跳过空格后读取一个token，不满足条件时恢复指针
+     *
+     * 判断条件直接内联，指针保存在局部变量中，不使用TokenReader的指针栈
+     */
+    template<class Check>
+    bool expect(TokenReader &tokenReader, Check &&check) {
+        size_t start = tokenReader.index;
+        tokenReader.skipSpace();
+        const Token *token = tokenReader.read();
+        if (token == nullptr || !check(*token)) {
+            tokenReader.index = start;
+            return false;
+        }
+        return true;
+    }
 
     bool expectString(TokenReader &tokenReader);
 
-    bool expectString(TokenReader &tokenReader, const std::u16string &str);
+    bool expectString(TokenReader &tokenReader, std::u16string_view str);
 
     bool expectSymbol(TokenReader &tokenReader, char16_t ch);
 
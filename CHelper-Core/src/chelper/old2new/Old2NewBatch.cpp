@@ -0,0 +1,326 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/old2new/Old2NewBatch.h>
+
+namespace CHelper::Old2New {
+
+    BatchResult &BatchResult::operator+=(const BatchResult &batchResult) {
+        fileCount += batchResult.fileCount;
+        lineCount += batchResult.lineCount;
+        changedLineCount += batchResult.changedLineCount;
+        byteCount += batchResult.byteCount;
+        return *this;
+    }
+
+    bool old2newLine(const BlockFixData &blockFixData, std::string &line) {
+        // 保留Windows的换行符
+        bool isEndWithCR = !line.empty() && line.back() == '\r';
+        std::string_view content(line.data(), line.size() - (isEndWithCR ? 1 : 0));
+        size_t start = content.find_first_not_of(" \t");
+        if (start == std::string_view::npos || content[start] == '#') {
+            return false;
+        }
+#ifndef CHELPER_NO_FILESYSTEM
+        const size_t stackSize = Profile::stack.size();
+#endif
+        try {
+            std::u16string old;
+            old.reserve(content.size());
+            utf8::utf8to16(content.begin(), content.end(), std::back_inserter(old));
+            std::u16string result = old2new(blockFixData, old);
+            if (result == old) [[likely]] {
+                return false;
+            }
+            line.clear();
+            utf8::utf16to8(result.begin(), result.end(), std::back_inserter(line));
+            if (isEndWithCR) {
+                line.push_back('\r');
+            }
+            return true;
+        } catch (const std::exception &) {
+            // 无法转换的行保持不变，只丢弃转换这一行时记录的调用栈，调用者记录的调用栈还要继续使用
+#ifndef CHELPER_NO_FILESYSTEM
+            while (Profile::stack.size() > stackSize) {
+                Profile::pop();
+            }
+#endif
+            return false;
+        }
+    }
+
+    /**
+     * 转换时使用的线程，所有批次和文件共用，不需要每一批都创建线程
+     */
+    class BatchThreadPool {
+    private:
+        std::mutex mutex;
+        std::condition_variable taskCondition;
+        std::condition_variable finishCondition;
+        const std::function<void(size_t)> *task = nullptr;
+        // 每次提交任务加一，后台线程通过它判断是否有新的任务
+        size_t generation = 0;
+        size_t runningCount = 0;
+        bool isStopping = false;
+        std::vector<std::thread> workers;
+
+    public:
+        explicit BatchThreadPool(size_t threadCount) {
+            if (threadCount == 0) {
+                threadCount = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+            }
+            // 调用者的线程也参与转换
+            workers.reserve(threadCount - 1);
+            for (size_t i = 1; i < threadCount; ++i) {
+                workers.emplace_back([this, i]() {
+                    size_t lastGeneration = 0;
+                    while (true) {
+                        const std::function<void(size_t)> *currentTask;
+                        {
+                            std::unique_lock lock(mutex);
+                            taskCondition.wait(lock, [this, lastGeneration]() {
+                                return isStopping || generation != lastGeneration;
+                            });
+                            if (isStopping) {
+                                return;
+                            }
+                            lastGeneration = generation;
+                            currentTask = task;
+                        }
+                        (*currentTask)(i);
+                        std::lock_guard lock(mutex);
+                        if (--runningCount == 0) {
+                            finishCondition.notify_one();
+                        }
+                    }
+                });
+            }
+        }
+
+        BatchThreadPool(const BatchThreadPool &) = delete;
+
+        BatchThreadPool &operator=(const BatchThreadPool &) = delete;
+
+        ~BatchThreadPool() {
+            {
+                std::lock_guard lock(mutex);
+                isStopping = true;
+            }
+            taskCondition.notify_all();
+            for (auto &worker: workers) {
+                worker.join();
+            }
+        }
+
+        [[nodiscard]] size_t size() const {
+            return workers.size() + 1;
+        }
+
+        /**
+         * 每个线程执行一次task，参数为线程的序号，全部完成后返回
+         */
+        void run(const std::function<void(size_t)> &currentTask) {
+            if (workers.empty()) {
+                currentTask(0);
+                return;
+            }
+            {
+                std::lock_guard lock(mutex);
+                task = &currentTask;
+                runningCount = workers.size();
+                ++generation;
+            }
+            taskCondition.notify_all();
+            currentTask(0);
+            std::unique_lock lock(mutex);
+            finishCondition.wait(lock, [this]() {
+                return runningCount == 0;
+            });
+        }
+    };
+
+    static size_t old2newLines(const BlockFixData &blockFixData, std::vector<std::string> &lines, BatchThreadPool &threadPool) {
+        const size_t threadCount = threadPool.size();
+        std::vector<size_t> changedLineCounts(threadCount);
+        // 每个线程负责连续的一段，结果直接写回原来的位置，输出时不需要重新排序
+        threadPool.run([&blockFixData, &lines, &changedLineCounts, threadCount](size_t index) {
+            size_t start = lines.size() * index / threadCount;
+            size_t end = lines.size() * (index + 1) / threadCount;
+            for (size_t i = start; i < end; ++i) {
+                if (old2newLine(blockFixData, lines[i])) {
+                    ++changedLineCounts[index];
+                }
+            }
+        });
+        size_t result = 0;
+        for (const auto &item: changedLineCounts) {
+            result += item;
+        }
+        return result;
+    }
+
+    static BatchResult old2newStream(const BlockFixData &blockFixData,
+                                     std::istream &istream,
+                                     std::ostream &ostream,
+                                     BatchThreadPool &threadPool,
+                                     size_t batchSize) {
+        batchSize = std::max(batchSize, static_cast<size_t>(1));
+        BatchResult result;
+        std::vector<std::string> lines;
+        lines.reserve(batchSize);
+        while (true) {
+            lines.clear();
+            // 只有文件的最后一行可能没有换行符
+            bool isEndWithNewLine = true;
+            std::string line;
+            while (lines.size() < batchSize && std::getline(istream, line)) {
+                isEndWithNewLine = !istream.eof();
+                result.byteCount += line.size() + (isEndWithNewLine ? 1 : 0);
+                lines.push_back(std::move(line));
+            }
+            if (lines.empty()) {
+                break;
+            }
+            result.lineCount += lines.size();
+            result.changedLineCount += old2newLines(blockFixData, lines, threadPool);
+            for (size_t i = 0; i < lines.size(); ++i) {
+                ostream << lines[i];
+                if (i + 1 < lines.size() || isEndWithNewLine) [[likely]] {
+                    ostream << '\n';
+                }
+            }
+        }
+        return result;
+    }
+
+    BatchResult old2newStream(const BlockFixData &blockFixData,
+                              std::istream &istream,
+                              std::ostream &ostream,
+                              size_t threadCount,
+                              size_t batchSize) {
+        BatchThreadPool threadPool(threadCount);
+        return old2newStream(blockFixData, istream, ostream, threadPool, batchSize);
+    }
+
+#ifndef CHELPER_NO_FILESYSTEM
+    /**
+     * 转换失败时删除写了一半的临时文件
+     */
+    class TempFileScope {
+    private:
+        std::filesystem::path path;
+
+    public:
+        explicit TempFileScope(std::filesystem::path path)
+            : path(std::move(path)) {}
+
+        TempFileScope(const TempFileScope &) = delete;
+
+        TempFileScope &operator=(const TempFileScope &) = delete;
+
+        ~TempFileScope() {
+            std::error_code errorCode;
+            std::filesystem::remove(path, errorCode);
+        }
+    };
+
+    static BatchResult old2newFile(const BlockFixData &blockFixData,
+                                   const std::filesystem::path &input,
+                                   const std::filesystem::path &output,
+                                   BatchThreadPool &threadPool) {
+        std::ifstream istream(input, std::ios::binary);
+        if (!istream.is_open()) [[unlikely]] {
+            Profile::push(R"(fail to open file: "{}")", FORMAT_ARG(input.string()));
+            throw std::runtime_error("fail to open file");
+        }
+        // 先写到临时文件，这样输入和输出可以是同一个文件
+        std::filesystem::path temp = output;
+        temp += ".tmp";
+        if (output.has_parent_path()) {
+            std::filesystem::create_directories(output.parent_path());
+        }
+        TempFileScope tempFileScope(temp);
+        std::ofstream ostream(temp, std::ios::binary);
+        if (!ostream.is_open()) [[unlikely]] {
+            Profile::push(R"(fail to open file: "{}")", FORMAT_ARG(temp.string()));
+            throw std::runtime_error("fail to open file");
+        }
+        BatchResult result = old2newStream(blockFixData, istream, ostream, threadPool, 8192);
+        result.fileCount = 1;
+        istream.close();
+        ostream.close();
+        if (!ostream) [[unlikely]] {
+            Profile::push(R"(fail to write file: "{}")", FORMAT_ARG(temp.string()));
+            throw std::runtime_error("fail to write file");
+        }
+        std::filesystem::rename(temp, output);
+        return result;
+    }
+
+    BatchResult old2newFile(const BlockFixData &blockFixData,
+                            const std::filesystem::path &input,
+                            const std::filesystem::path &output,
+                            size_t threadCount) {
+        BatchThreadPool threadPool(threadCount);
+        return old2newFile(blockFixData, input, output, threadPool);
+    }
+
+    BatchResult old2newDirectory(const BlockFixData &blockFixData,
+                                 const std::filesystem::path &input,
+                                 const std::filesystem::path &output,
+                                 size_t threadCount) {
+        if (std::filesystem::is_regular_file(input)) {
+            return old2newFile(blockFixData, input, output, threadCount);
+        }
+        if (!std::filesystem::is_directory(input)) [[unlikely]] {
+            Profile::push(R"(fail to find file or directory: "{}")", FORMAT_ARG(input.string()));
+            throw std::runtime_error("fail to find file or directory");
+        }
+        // 先列出所有文件再转换，输出的文件在输入文件夹中时不会被再次读取
+        const std::filesystem::path outputPath = std::filesystem::weakly_canonical(output);
+        std::vector<std::filesystem::path> files;
+        for (auto it = std::filesystem::recursive_directory_iterator(input); it != std::filesystem::recursive_directory_iterator(); ++it) {
+            if (it->is_directory()) {
+                // 输出文件夹在输入文件夹中时跳过上次输出的内容
+                if (std::filesystem::weakly_canonical(it->path()) == outputPath) {
+                    it.disable_recursion_pending();
+                }
+                continue;
+            }
+            if (it->is_regular_file()) {
+                files.push_back(it->path());
+            }
+        }
+        BatchThreadPool threadPool(threadCount);
+        BatchResult result;
+        for (const auto &file: files) {
+            std::filesystem::path target = output / std::filesystem::relative(file, input);
+            if (file.extension() == ".mcfunction") {
+                Profile::push(R"(converting file: "{}")", FORMAT_ARG(file.string()));
+                result += old2newFile(blockFixData, file, target, threadPool);
+                Profile::pop();
+            } else if (!std::filesystem::exists(target) || !std::filesystem::equivalent(file, target)) {
+                std::filesystem::create_directories(target.parent_path());
+                std::filesystem::copy_file(file, target, std::filesystem::copy_options::overwrite_existing);
+            }
+        }
+        return result;
+    }
+#endif
+
+}// namespace CHelper::Old2New
@@ -0,0 +1,86 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_OLD2NEWBATCH_H
+#define CHELPER_OLD2NEWBATCH_H
+
+#include <chelper/old2new/Old2New.h>
+#include <pch.h>
+
+namespace CHelper::Old2New {
+
+    class BatchResult {
+    public:
+        // 读取的文件数
+        size_t fileCount = 0;
+        // 读取的行数
+        size_t lineCount = 0;
+        // 内容被修改的行数
+        size_t changedLineCount = 0;
+        // 读取的字节数
+        size_t byteCount = 0;
+
+        BatchResult &operator+=(const BatchResult &batchResult);
+    };
+
+    /**
+     * 转换一行UTF-8编码的旧版命令，空行和注释保持不变
+     *
+     * @return 内容是否被修改
+     */
+    bool old2newLine(const BlockFixData &blockFixData, std::string &line);
+
+    /**
+     * 逐行读取旧版命令，分批交给多个线程同时转换，按原来的顺序输出，所有批次使用同一组线程
+     *
+     * BlockFixData在转换过程中只读，所有线程共用同一份
+     *
+     * @param threadCount 线程数，为0时使用硬件的线程数
+     * @param batchSize 每批读取的行数，决定了占用内存的上限
+     */
+    BatchResult old2newStream(const BlockFixData &blockFixData,
+                              std::istream &istream,
+                              std::ostream &ostream,
+                              size_t threadCount = 0,
+                              size_t batchSize = 8192);
+
+#ifndef CHELPER_NO_FILESYSTEM
+    /**
+     * 转换一个文件，输入和输出可以是同一个文件
+     */
+    BatchResult old2newFile(const BlockFixData &blockFixData,
+                            const std::filesystem::path &input,
+                            const std::filesystem::path &output,
+                            size_t threadCount = 0);
+
+    /**
+     * 转换文件夹（存档或者行为包）中所有的.mcfunction文件，其它文件原样复制
+     *
+     * 输出文件夹可以在输入文件夹中，其中的内容不会被当作输入
+     */
+    BatchResult old2newDirectory(const BlockFixData &blockFixData,
+                                 const std::filesystem::path &input,
+                                 const std::filesystem::path &output,
+                                 size_t threadCount = 0);
+#endif
+
+}// namespace CHelper::Old2New
+
+#endif//CHELPER_OLD2NEWBATCH_H
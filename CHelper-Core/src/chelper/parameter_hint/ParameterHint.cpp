@@ -19,11 +19,6 @@
 #include <chelper/node/NodeType.h>
 #include <chelper/parameter_hint/ParameterHint.h>
 
-#define CHELPER_GET_PARAMETER_HINT(v1)                                                                              \
-    case Node::NodeTypeId::v1:                                                                                      \
-        parameterHint = ParameterHint<typename Node::NodeTypeDetail<Node::NodeTypeId::v1>::Type>::getHint(astNode); \
-        break;
-
 namespace CHelper::ParameterHint {
 
     template<class NodeType, class = void>
@@ -82,20 +77,25 @@ namespace CHelper::ParameterHint {
         }
     };
 
+    template<Node::NodeTypeId::NodeTypeId nodeTypeId>
+    struct GetHintByNodeType {
+        static std::optional<std::u16string> call(const ASTNode &astNode) {
+            return ParameterHint<typename Node::NodeTypeDetail<nodeTypeId>::Type>::getHint(astNode);
+        }
+    };
+
+    static constexpr auto getHintFunctions = Node::createNodeTypeTable<GetHintByNodeType>();
+
     std::optional<std::u16string> getParameterHint(const ASTNode &astNode, size_t index) {
         if (index < astNode.tokens.startIndex || index > astNode.tokens.endIndex) [[unlikely]] {
             return std::nullopt;
         }
         if (!astNode.isAllSpaceError()) [[unlikely]] {
+            CHELPER_TRACE_SCOPE_ARG("get parameter hint", "nodeType", Node::getNodeTypeName(astNode.node.nodeTypeId));
 #ifdef CHelperTest
             Profile::push("get parameter hint: {} {}", FORMAT_ARG(utf8::utf16to8(astNode.tokens.toString())), FORMAT_ARG(Node::getNodeTypeName(astNode.node.nodeTypeId)));
 #endif
-            std::optional<std::u16string> parameterHint;
-            switch (astNode.node.nodeTypeId) {
-                CODEC_PASTE(CHELPER_GET_PARAMETER_HINT, CHELPER_NODE_TYPES)
-                default:
-                    CHELPER_UNREACHABLE();
-            }
+            std::optional<std::u16string> parameterHint = getHintFunctions[astNode.node.nodeTypeId](astNode);
 #ifdef CHelperTest
             Profile::pop();
 #endif
@@ -19,6 +19,7 @@
 #include <chelper/lexer/Lexer.h>
 #include <chelper/node/NodeType.h>
 #include <chelper/parser/Parser.h>
+#include <chelper/profile/NodeProfile.h>
 #include <chelper/resources/CPack.h>
 
 #ifdef CHelperDebug
@@ -39,10 +40,6 @@
 #define DEBUG_GET_NODE_END(node, index) ;
 #endif
 
-#define CHELPER_GET_AST_NODE(v1) \
-    case Node::NodeTypeId::v1:   \
-        return Parser<typename Node::NodeTypeDetail<Node::NodeTypeId::v1>::Type>::getASTNode(*reinterpret_cast<const typename Node::NodeTypeDetail<Node::NodeTypeId::v1>::Type *>(node.data), tokenReader);
-
 namespace CHelper::Parser {
 
     ASTNode parse(const Node::NodeWithType &node, TokenReader &tokenReader);
@@ -171,6 +168,7 @@ namespace CHelper::Parser {
         if (convertResult.errorReason != nullptr) [[unlikely]] {
             return {ASTNode::simpleNode(node, tokens, convertResult.errorReason), std::move(convertResult)};
         }
+        CHELPER_TRACE_SCOPE_ARG("parse json string", "content", std::u16string_view(convertResult.result));
 #ifdef CHelperTest
         Profile::push("start parsing: {}", FORMAT_ARG(utf8::utf16to8(convertResult.result)));
 #endif
@@ -233,14 +231,14 @@ namespace CHelper::Parser {
             XXH64_hash_t strHash = XXH3_64bits(str.data(), str.size() * sizeof(decltype(str)::value_type));
             std::shared_ptr<NamespaceId> currentBlock = nullptr;
             for (const auto &item: *node.blockIds->blockStateValues) {
-                if (item->fastMatch(strHash) || item->getIdWithNamespace()->fastMatch(strHash)) [[unlikely]] {
+                if (item->fastMatch(strHash) || item->fastMatchWithNamespace(strHash)) [[unlikely]] {
                     currentBlock = item;
                     break;
                 }
             }
             auto nodeBlockState = currentBlock == nullptr
                                           ? BlockId::getNodeAllBlockState()
-                                          : std::static_pointer_cast<BlockId>(currentBlock)->getNode(node.blockIds->blockPropertyDescriptions);
+                                          : std::static_pointer_cast<BlockId>(currentBlock)->getNode(*node.blockIds);
             auto astNodeBlockState = parseByChildNode(node, tokenReader, nodeBlockState, ASTNodeId::NODE_BLOCK_BLOCK_STATE);
             return ASTNode::andNode(node, {(std::move(blockId)), (std::move(astNodeBlockState))}, tokenReader.collect(),
                                     nullptr, ASTNodeId::NODE_BLOCK_BLOCK_AND_BLOCK_STATE);
@@ -339,13 +337,13 @@ namespace CHelper::Parser {
             XXH64_hash_t strHash = XXH3_64bits(str.data(), str.size() * sizeof(decltype(str)::value_type));
             std::shared_ptr<NamespaceId> currentItem = nullptr;
             for (const auto &item: *node.itemIds) {
-                if (item->fastMatch(strHash) || item->getIdWithNamespace()->fastMatch(strHash)) [[unlikely]] {
+                if (item->fastMatch(strHash) || item->fastMatchWithNamespace(strHash)) [[unlikely]] {
                     currentItem = item;
                     break;
                 }
             }
             std::vector<ASTNode> childNodes = {std::move(itemId)};
-            Node::NodeWithType nodeData = currentItem == nullptr ? CHelper::Node::NodeItem::nodeAllData : std::static_pointer_cast<ItemId>(currentItem)->getNode();
+            Node::NodeWithType nodeData = currentItem == nullptr ? CHelper::Node::NodeItem::nodeAllData : std::static_pointer_cast<ItemId>(currentItem)->getNode(node.itemNodeCache);
             switch (node.nodeItemType) {
                 case Node::NodeItemType::ITEM_GIVE:
                     childNodes.push_back(getOptionalASTNode(
@@ -406,7 +404,7 @@ namespace CHelper::Parser {
                 std::u16string_view str = tokens.string();
                 XXH64_hash_t strHash = XXH3_64bits(str.data(), str.size() * sizeof(decltype(str)::value_type));
                 if (std::ranges::all_of(*node.customContents, [&strHash](const auto &item) {
-                        return !item->fastMatch(strHash) && !item->getIdWithNamespace()->fastMatch(strHash);
+                        return !item->fastMatch(strHash) && !item->fastMatchWithNamespace(strHash);
                     })) [[unlikely]] {
                     return ASTNode::andNode(node, {std::move(result)}, tokens, ErrorReason::incomplete(tokens, fmt::format(u"找不到含义 -> {}", str)));
                 }
@@ -453,6 +451,7 @@ namespace CHelper::Parser {
     template<>
     struct Parser<Node::NodePerCommand> {
         static ASTNode getASTNode(const Node::NodePerCommand &node, TokenReader &tokenReader) {
+            node.load();
             std::vector<ASTNode> childASTNodes;
             childASTNodes.reserve(node.startNodes.size());
             for (const auto &item: node.startNodes) {
@@ -978,26 +977,45 @@ namespace CHelper::Parser {
         }
     };
 
-    ASTNode parse(const Node::NodeWithType &node, TokenReader &tokenReader) {
-        switch (node.nodeTypeId) {
-            CODEC_PASTE(CHELPER_GET_AST_NODE, CHELPER_NODE_TYPES)
-            default:
-                CHELPER_UNREACHABLE();
+    template<Node::NodeTypeId::NodeTypeId nodeTypeId>
+    struct ParseByNodeType {
+        static ASTNode call(const Node::NodeWithType &node, TokenReader &tokenReader) {
+            using NodeType = typename Node::NodeTypeDetail<nodeTypeId>::Type;
+            return Parser<NodeType>::getASTNode(*reinterpret_cast<const NodeType *>(node.data), tokenReader);
         }
+    };
+
+    static constexpr auto parseFunctions = Node::createNodeTypeTable<ParseByNodeType>();
+
+    static ASTNode parseByNodeType(const Node::NodeWithType &node, TokenReader &tokenReader) {
+        return parseFunctions[node.nodeTypeId](node, tokenReader);
+    }
+
+    ASTNode parse(const Node::NodeWithType &node, TokenReader &tokenReader) {
+        CHELPER_TRACE_SCOPE_ARG("parse", "nodeType", Node::getNodeTypeName(node.nodeTypeId));
+#ifdef CHELPER_NODE_PROFILE
+        NodeProfile::Timer timer(NodeProfile::Phase::PARSE, node);
+        ASTNode result = parseByNodeType(node, tokenReader);
+        timer.tokenCount = result.tokens.size();
+        return result;
+#else
+        return parseByNodeType(node, tokenReader);
+#endif
     }
 
     ASTNode parse(std::u16string content, const Node::NodeWithType &mainNode) {
+        CHELPER_TRACE_SCOPE("parse command");
         TokenReader tokenReader(Lexer::lex(std::move(content)));
-#ifdef CHelperTest
-        Profile::push("start parsing: {}", FORMAT_ARG(utf8::utf16to8(tokenReader.lexerResult->content)));
-#endif
-        DEBUG_GET_NODE_BEGIN(mainNode, index);
-        auto result = parse(mainNode, tokenReader);
-        DEBUG_GET_NODE_END(mainNode, index);
-#ifdef CHelperTest
-        Profile::pop();
-#endif
-        return result;
+        try {
+            DEBUG_GET_NODE_BEGIN(mainNode, index);
+            auto result = parse(mainNode, tokenReader);
+            DEBUG_GET_NODE_END(mainNode, index);
+            return result;
+        } catch (const std::exception &) {
+            // 只在出错时记录正在解析的命令，由捕获异常的地方打印，正常解析时没有额外的开销
+            Profile::push("start parsing: {}", FORMAT_ARG(utf8::utf16to8(tokenReader.lexerResult->content)));
+            throw;
+        }
     }
 
     ASTNode parse(std::u16string content, const CPack &cpack) {
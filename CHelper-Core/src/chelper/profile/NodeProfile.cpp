@@ -0,0 +1,134 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/node/NodeType.h>
+#include <chelper/profile/NodeProfile.h>
+
+#define CHELPER_GET_NODE_ID(v1) \
+    case Node::NodeTypeId::v1:  \
+        return getNodeId<typename Node::NodeTypeDetail<Node::NodeTypeId::v1>::Type>(data);
+
+namespace CHelper::NodeProfile {
+
+    thread_local Recorder *Recorder::current = nullptr;
+
+    template<class NodeType>
+    static const std::optional<std::string> *getNodeId(const Node::NodeBase *data) {
+        if constexpr (std::is_base_of_v<Node::NodeSerializable, NodeType>) {
+            return &static_cast<const Node::NodeSerializable *>(reinterpret_cast<const NodeType *>(data))->id;
+        } else {
+            return nullptr;
+        }
+    }
+
+    static const std::optional<std::string> *getNodeId(Node::NodeTypeId::NodeTypeId nodeTypeId, const Node::NodeBase *data) {
+        switch (nodeTypeId) {
+            CODEC_PASTE(CHELPER_GET_NODE_ID, CHELPER_NODE_TYPES)
+            default:
+                return nullptr;
+        }
+    }
+
+    const char *getPhaseName(Phase::Phase phase) {
+        switch (phase) {
+            case Phase::PARSE:
+                return "parse";
+            case Phase::SUGGESTION:
+                return "suggestion";
+            case Phase::LINT:
+                return "lint";
+            case Phase::SYNTAX_HIGHLIGHT:
+                return "syntax highlight";
+            default:
+                return "unknown";
+        }
+    }
+
+    void Counter::add(const Counter &counter) {
+        callCount += counter.callCount;
+        inclusiveTime += counter.inclusiveTime;
+        exclusiveTime += counter.exclusiveTime;
+        tokenCount += counter.tokenCount;
+    }
+
+    std::string Report::toString() const {
+        std::string result;
+        for (const auto &[title, items]: {std::make_pair("node type", &nodeTypes), std::make_pair("node id", &nodeIds)}) {
+            fmt::format_to(std::back_inserter(result), "{:<18}{:<32}{:>10}{:>16}{:>16}{:>10}\n",
+                           "phase", title, "calls", "inclusive(us)", "exclusive(us)", "tokens");
+            for (const auto &item: *items) {
+                fmt::format_to(std::back_inserter(result), "{:<18}{:<32}{:>10}{:>16.1f}{:>16.1f}{:>10}\n",
+                               getPhaseName(item.phase),
+                               item.name,
+                               item.counter.callCount,
+                               static_cast<double>(item.counter.inclusiveTime) / 1000,
+                               static_cast<double>(item.counter.exclusiveTime) / 1000,
+                               item.counter.tokenCount);
+            }
+        }
+        return result;
+    }
+
+    void Recorder::record(Phase::Phase phase, const Node::NodeWithType &node, uint64_t inclusiveTime, uint64_t exclusiveTime, size_t tokenCount) {
+        Counter counter{1, inclusiveTime, exclusiveTime, tokenCount};
+        nodeTypeCounters[phase][node.nodeTypeId].add(counter);
+        auto it = nodeCounters[phase].try_emplace(node.data, NodeCounter{node.nodeTypeId, {}}).first;
+        it->second.counter.add(counter);
+    }
+
+    void Recorder::clear() {
+        for (auto &item: nodeTypeCounters) {
+            item.fill({});
+        }
+        for (auto &item: nodeCounters) {
+            item.clear();
+        }
+        childTime = 0;
+    }
+
+    Report Recorder::getReport() const {
+        Report report;
+        for (uint8_t phase = 0; phase < Phase::COUNT; ++phase) {
+            for (size_t nodeTypeId = 0; nodeTypeId < nodeTypeCounters[phase].size(); ++nodeTypeId) {
+                const Counter &counter = nodeTypeCounters[phase][nodeTypeId];
+                if (counter.callCount != 0) {
+                    report.nodeTypes.push_back({static_cast<Phase::Phase>(phase),
+                                                Node::getNodeTypeName(static_cast<Node::NodeTypeId::NodeTypeId>(nodeTypeId)),
+                                                counter});
+                }
+            }
+            std::unordered_map<std::string, Counter> idCounters;
+            for (const auto &[data, nodeCounter]: nodeCounters[phase]) {
+                const std::optional<std::string> *id = getNodeId(nodeCounter.nodeTypeId, data);
+                if (id != nullptr && id->has_value()) {
+                    idCounters[id->value()].add(nodeCounter.counter);
+                }
+            }
+            for (auto &[id, counter]: idCounters) {
+                report.nodeIds.push_back({static_cast<Phase::Phase>(phase), id, counter});
+            }
+        }
+        auto compare = [](const ReportItem &item1, const ReportItem &item2) {
+            return item1.counter.exclusiveTime > item2.counter.exclusiveTime;
+        };
+        std::stable_sort(report.nodeTypes.begin(), report.nodeTypes.end(), compare);
+        std::stable_sort(report.nodeIds.begin(), report.nodeIds.end(), compare);
+        return report;
+    }
+
+}// namespace CHelper::NodeProfile
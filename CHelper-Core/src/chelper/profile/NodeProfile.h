@@ -0,0 +1,170 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_NODEPROFILE_H
+#define CHELPER_NODEPROFILE_H
+
+#include <chelper/node/NodeWithType.h>
+#include <pch.h>
+
+// 开启CHELPER_NODE_PROFILE后统计每种节点的耗时，关闭时不会生成任何代码
+#ifdef CHELPER_NODE_PROFILE
+#define CHELPER_NODE_PROFILE_SCOPE(phase, node, tokenCount) ::CHelper::NodeProfile::Timer chelperNodeProfileTimer(phase, node, tokenCount)
+#else
+#define CHELPER_NODE_PROFILE_SCOPE(phase, node, tokenCount) ;
+#endif
+
+namespace CHelper::NodeProfile {
+
+    namespace Phase {
+        enum Phase : uint8_t {
+            PARSE,
+            SUGGESTION,
+            LINT,
+            SYNTAX_HIGHLIGHT,
+            COUNT
+        };
+    }// namespace Phase
+
+    using Node::NODE_TYPE_COUNT;
+
+    const char *getPhaseName(Phase::Phase phase);
+
+    class Counter {
+    public:
+        uint64_t callCount = 0;
+        // 包含子节点的耗时，单位为纳秒
+        uint64_t inclusiveTime = 0;
+        // 不包含子节点的耗时，单位为纳秒
+        uint64_t exclusiveTime = 0;
+        uint64_t tokenCount = 0;
+
+        void add(const Counter &counter);
+    };
+
+    class ReportItem {
+    public:
+        Phase::Phase phase;
+        // 节点类型的名称或者节点的id
+        std::string name;
+        Counter counter;
+    };
+
+    class Report {
+    public:
+        // 按节点类型统计，按不包含子节点的耗时从大到小排序
+        std::vector<ReportItem> nodeTypes;
+        // 按节点id统计，只包含有id的节点
+        std::vector<ReportItem> nodeIds;
+
+        [[nodiscard]] std::string toString() const;
+    };
+
+    class Recorder {
+    public:
+        class NodeCounter {
+        public:
+            Node::NodeTypeId::NodeTypeId nodeTypeId;
+            Counter counter;
+        };
+
+        std::array<std::array<Counter, NODE_TYPE_COUNT>, Phase::COUNT> nodeTypeCounters;
+        // 按节点统计，生成报告时再按节点id合并
+        std::array<std::unordered_map<const Node::NodeBase *, NodeCounter>, Phase::COUNT> nodeCounters;
+        // 当前节点的子节点的总耗时
+        uint64_t childTime = 0;
+
+        // 当前线程正在使用的记录器，为空时不统计
+        static thread_local Recorder *current;
+
+        void record(Phase::Phase phase, const Node::NodeWithType &node, uint64_t inclusiveTime, uint64_t exclusiveTime, size_t tokenCount);
+
+        void clear();
+
+        [[nodiscard]] Report getReport() const;
+    };
+
+    /**
+     * 在作用域内把记录器设置为当前线程的记录器
+     */
+    class Scope {
+    private:
+        Recorder *last;
+
+    public:
+        explicit Scope(Recorder &recorder)
+            : last(Recorder::current) {
+            Recorder::current = &recorder;
+        }
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() {
+            Recorder::current = last;
+        }
+    };
+
+    /**
+     * 统计一次节点调用，子节点的耗时会从父节点的独占耗时中扣除
+     */
+    class Timer {
+    private:
+        Recorder *recorder;
+        Phase::Phase phase;
+        const Node::NodeWithType &node;
+        uint64_t lastChildTime = 0;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        size_t tokenCount;
+
+        Timer(Phase::Phase phase, const Node::NodeWithType &node, size_t tokenCount = 0)
+            : recorder(Recorder::current),
+              phase(phase),
+              node(node),
+              tokenCount(tokenCount) {
+            if (recorder == nullptr) [[likely]] {
+                return;
+            }
+            lastChildTime = recorder->childTime;
+            recorder->childTime = 0;
+            start = std::chrono::steady_clock::now();
+        }
+
+        Timer(const Timer &) = delete;
+
+        Timer &operator=(const Timer &) = delete;
+
+        ~Timer() {
+            if (recorder == nullptr) [[likely]] {
+                return;
+            }
+            auto inclusiveTime = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            uint64_t exclusiveTime = inclusiveTime > recorder->childTime ? inclusiveTime - recorder->childTime : 0;
+            recorder->childTime = lastChildTime + inclusiveTime;
+            recorder->record(phase, node, inclusiveTime, exclusiveTime, tokenCount);
+        }
+    };
+
+}// namespace CHelper::NodeProfile
+
+#endif//CHELPER_NODEPROFILE_H
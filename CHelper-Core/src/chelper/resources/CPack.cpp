@@ -20,6 +20,7 @@
 #include <chelper/node/NodeType.h>
 #include <chelper/resources/CPack.h>
 #include <chelper/resources/Manifest.h>
+#include <chelper/serialization/IdJsonReader.h>
 #include <chelper/serialization/Serialization.h>
 
 namespace CHelper {
@@ -36,7 +37,7 @@ namespace CHelper {
         Profile::next("loading id data");
         for (const auto &file: std::filesystem::recursive_directory_iterator(path / "id")) {
             Profile::next(R"(loading id data in path "{}")", FORMAT_ARG(file.path().string()));
-            applyId(serialization::get_json_from_file(file));
+            applyId(file.path());
         }
         Profile::next("loading json data");
         currentCreateStage = Node::NodeCreateStage::JSON_NODE;
@@ -106,11 +107,194 @@ namespace CHelper {
 #endif
     }
 
+#ifndef CHELPER_NO_FILESYSTEM
+    CPack::CPack(const CPack &base, const std::filesystem::path &path) {
+#if defined(CHelperDebug) && !defined(CHELPER_NO_FILESYSTEM)
+        size_t stackSize = Profile::stack.size();
+#endif
+        currentCreateStage = Node::NodeCreateStage::NONE;
+        Profile::push("loading manifest");
+        auto jsonManifest = serialization::get_json_from_file(path / "manifest.json");
+        serialization::Codec<Manifest>::from_json(jsonManifest, manifest);
+        Profile::next("loading base cpack");
+        applyOverlayBase(base);
+        Profile::next("loading id data");
+        if (std::filesystem::exists(path / "id")) {
+            for (const auto &file: std::filesystem::recursive_directory_iterator(path / "id")) {
+                Profile::next(R"(loading id data in path "{}")", FORMAT_ARG(file.path().string()));
+                applyOverlayId(serialization::get_json_from_file(file));
+            }
+        }
+        Profile::next("loading json data");
+        currentCreateStage = Node::NodeCreateStage::JSON_NODE;
+        if (std::filesystem::exists(path / "json")) {
+            for (const auto &file: std::filesystem::recursive_directory_iterator(path / "json")) {
+                Profile::next(R"(loading json data in path "{}")", FORMAT_ARG(file.path().string()));
+                applyJson(serialization::get_json_from_file(file));
+            }
+        }
+        Profile::next("loading repeat data");
+        currentCreateStage = Node::NodeCreateStage::REPEAT_NODE;
+        if (std::filesystem::exists(path / "repeat")) {
+            for (const auto &file: std::filesystem::recursive_directory_iterator(path / "repeat")) {
+                Profile::next(R"(loading repeat data in path "{}")", FORMAT_ARG(file.path().string()));
+                applyRepeat(serialization::get_json_from_file(file));
+            }
+        }
+        Profile::next("loading commands");
+        currentCreateStage = Node::NodeCreateStage::COMMAND_PARAM_NODE;
+        if (std::filesystem::exists(path / "command")) {
+            for (const auto &file: std::filesystem::recursive_directory_iterator(path / "command")) {
+                Profile::next(R"(loading command in path "{}")", FORMAT_ARG(file.path().string()));
+                applyCommand(serialization::get_json_from_file(file));
+            }
+        }
+        Profile::next("loading base nodes");
+        applyOverlayNodes(base);
+        Profile::next("init cpack");
+        currentCreateStage = Node::NodeCreateStage::NONE;
+        afterApply();
+        Profile::pop();
+#if defined(CHelperDebug) && !defined(CHELPER_NO_FILESYSTEM)
+        if (Profile::stack.size() != stackSize) [[unlikely]] {
+            SPDLOG_WARN("error profile stack after loading cpack");
+        }
+#endif
+    }
+#endif
+
+    CPack::CPack(const CPack &base, const rapidjson::GenericDocument<rapidjson::UTF8<>> &j) {
+        using JsonValueType = rapidjson::GenericDocument<rapidjson::UTF8<>>;
+#if defined(CHelperDebug) && !defined(CHELPER_NO_FILESYSTEM)
+        size_t stackSize = Profile::stack.size();
+#endif
+        currentCreateStage = Node::NodeCreateStage::NONE;
+        Profile::push("loading manifest");
+        serialization::Codec<Manifest>::template from_json_member<JsonValueType>(j, "manifest", manifest);
+        Profile::next("loading base cpack");
+        applyOverlayBase(base);
+        Profile::next("loading id data");
+        if (j.HasMember("id")) {
+            for (const auto &item: serialization::find_array_member_or_throw(j, "id")) {
+                applyOverlayId(item);
+            }
+        }
+        Profile::next("loading json data");
+        currentCreateStage = Node::NodeCreateStage::JSON_NODE;
+        if (j.HasMember("json")) {
+            for (const auto &item: serialization::find_array_member_or_throw(j, "json")) {
+                applyJson(item);
+            }
+        }
+        Profile::next("loading repeat data");
+        currentCreateStage = Node::NodeCreateStage::REPEAT_NODE;
+        if (j.HasMember("repeat")) {
+            for (const auto &item: serialization::find_array_member_or_throw(j, "repeat")) {
+                applyRepeat(item);
+            }
+        }
+        Profile::next("loading command data");
+        currentCreateStage = Node::NodeCreateStage::COMMAND_PARAM_NODE;
+        if (j.HasMember("command")) {
+            for (const auto &item: serialization::find_array_member_or_throw(j, "command")) {
+                applyCommand(item);
+            }
+        }
+        Profile::next("loading base nodes");
+        applyOverlayNodes(base);
+        Profile::next("init cpack");
+        currentCreateStage = Node::NodeCreateStage::NONE;
+        afterApply();
+        Profile::pop();
+#if defined(CHelperDebug) && !defined(CHELPER_NO_FILESYSTEM)
+        if (Profile::stack.size() != stackSize) [[unlikely]] {
+            SPDLOG_WARN("error profile stack after loading cpack");
+        }
+#endif
+    }
+
     CPack::CPack(std::istream &istream) {
 #if defined(CHelperDebug) && !defined(CHELPER_NO_FILESYSTEM)
         size_t stackSize = Profile::stack.size();
 #endif
         currentCreateStage = Node::NodeCreateStage::NONE;
+        Profile::push("loading binary cpack header");
+        const std::istream::pos_type start = istream.tellg();
+        uint32_t magic = 0;
+        serialization::from_binary(istream, magic);
+        if (!istream) [[unlikely]] {
+            Profile::push("binary cpack is too short to contain a header");
+            throw std::runtime_error("unknown binary cpack format");
+        }
+        if (magic != BINARY_MAGIC) [[unlikely]] {
+            // 旧格式直接从manifest开始，第一个字节是optional的标记，只能是0或1，不会和"CHPK"混淆
+            istream.seekg(start);
+            if (!istream) [[unlikely]] {
+                Profile::push("binary cpack should start with \"CHPK\", and the stream cannot go back to read the old format");
+                throw std::runtime_error("unknown binary cpack format");
+            }
+            Profile::next("loading legacy binary cpack");
+            applyLegacyBinary(istream);
+        } else {
+            uint32_t formatVersion = 0;
+            serialization::from_binary(istream, formatVersion);
+            if (!istream || formatVersion != BINARY_FORMAT_VERSION) [[unlikely]] {
+                Profile::push("binary cpack format version is {}, but {} is required", FORMAT_ARG(formatVersion), FORMAT_ARG(BINARY_FORMAT_VERSION));
+                throw std::runtime_error("unsupported binary cpack format version");
+            }
+            Profile::next("loading manifest");
+            serialization::from_binary(istream, manifest);
+            Profile::next("loading string pool");
+            // 字符串读取时会复制，字符串池只由还没有解析的命令持有，所有命令解析完成后释放
+            auto stringPool = std::make_shared<StringPool>();
+            uint32_t stringCount;
+            serialization::from_binary(istream, stringCount);
+            for (uint32_t i = 0; i < stringCount; ++i) {
+                std::u16string str;
+                serialization::from_binary(istream, str);
+                stringPool->intern(str);
+            }
+            StringPool::Scope stringPoolScope(stringPool.get());
+            Profile::next("loading normal id data");
+            serialization::from_binary(istream, normalIds);
+            Profile::next("loading namespace id data");
+            serialization::from_binary(istream, namespaceIds);
+            Profile::next("loading item id data");
+            serialization::from_binary(istream, itemIds);
+            Profile::next("loading block id data");
+            serialization::from_binary(istream, blockIds);
+            Profile::next("loading json data");
+            currentCreateStage = Node::NodeCreateStage::JSON_NODE;
+            serialization::from_binary(istream, jsonNodes);
+            Profile::next("loading repeat data");
+            currentCreateStage = Node::NodeCreateStage::REPEAT_NODE;
+            serialization::from_binary(istream, repeatNodeData);
+            Profile::next("loading command data");
+            currentCreateStage = Node::NodeCreateStage::COMMAND_PARAM_NODE;
+            serialization::from_binary(istream, commands);
+            for (auto &item: *commands) {
+                if (item.lazyData != nullptr) [[likely]] {
+                    item.lazyData->stringPool = stringPool;
+                }
+            }
+            Profile::next("loading precomputed id hashes");
+            applyIdHashes(istream);
+        }
+        Profile::next("init cpack");
+        currentCreateStage = Node::NodeCreateStage::NONE;
+        afterApply();
+        Profile::pop();
+#if defined(CHelperDebug) && !defined(CHELPER_NO_FILESYSTEM)
+        if (Profile::stack.size() != stackSize) [[unlikely]] {
+            SPDLOG_WARN("error profile stack after loading cpack");
+        }
+#endif
+    }
+
+    void CPack::applyLegacyBinary(std::istream &istream) {
+        // 旧格式没有字符串池和命令数据的长度，所有数据都在这里解析，也没有初始化快照
+        LegacyBinaryFormat::Scope legacyBinaryFormatScope;
+        StringPool::Scope stringPoolScope(nullptr);
         Profile::push("loading manifest");
         serialization::from_binary(istream, manifest);
         Profile::next("loading normal id data");
@@ -130,16 +314,41 @@ namespace CHelper {
         Profile::next("loading command data");
         currentCreateStage = Node::NodeCreateStage::COMMAND_PARAM_NODE;
         serialization::from_binary(istream, commands);
-        Profile::next("init cpack");
-        currentCreateStage = Node::NodeCreateStage::NONE;
-        afterApply();
         Profile::pop();
-#if defined(CHelperDebug) && !defined(CHELPER_NO_FILESYSTEM)
-        if (Profile::stack.size() != stackSize) [[unlikely]] {
-            SPDLOG_WARN("error profile stack after loading cpack");
+    }
+
+#ifndef CHELPER_NO_FILESYSTEM
+    void CPack::applyId(const std::filesystem::path &path) {
+        // ID文件比较大，使用SAX的方式直接读取，避免生成完整的json DOM
+        std::ifstream istream(path, std::ios::binary);
+        if (!istream.is_open()) [[unlikely]] {
+            Profile::push(R"(fail to open file: "{}")", FORMAT_ARG(path.string()));
+            throw std::runtime_error("fail to open file");
+        }
+        IdJsonReader reader;
+        if (!reader.read(istream)) [[unlikely]] {
+            istream.close();
+            applyId(serialization::get_json_from_file(path));
+            return;
+        }
+        switch (reader.type) {
+            case IdType::NORMAL:
+                normalIds.emplace(std::move(reader.id), std::move(reader.normalIds));
+                break;
+            case IdType::NAMESPACE:
+                namespaceIds.emplace(std::move(reader.id), std::move(reader.namespaceIds));
+                break;
+            case IdType::BLOCK:
+                blockIds = std::move(reader.blockIds);
+                break;
+            case IdType::ITEM:
+                itemIds = std::move(reader.itemIds);
+                break;
+            default:
+                CHELPER_UNREACHABLE();
         }
-#endif
     }
+#endif
 
     void CPack::applyId(const rapidjson::GenericValue<rapidjson::UTF8<>> &j) {
         using JsonValueType = rapidjson::GenericValue<rapidjson::UTF8<>>;
@@ -188,9 +397,227 @@ namespace CHelper {
         commands->push_back(std::move(item));
     }
 
+    template<class T>
+    static void copyByBinary(const T &from, T &to) {
+        std::stringstream stream;
+        serialization::Codec<T>::template to_binary<false>(stream, from);
+        serialization::Codec<T>::template from_binary<false>(stream, to);
+    }
+
+    static void copyCommand(const Node::NodePerCommand &from, Node::NodePerCommand &to) {
+        // 还没有解析的命令直接复制原始数据，和基础资源包共用字符串池，不需要解析
+        if (!from.isLoaded()) [[likely]] {
+            std::lock_guard lock(from.lazyData->mutex);
+            if (!from.lazyData->isLoaded.load(std::memory_order_relaxed)) {
+                to.name = from.name;
+                to.description = from.description;
+                to.syntax = from.syntax;
+                to.lazyData = std::make_unique<Node::LazyCommandData>();
+                to.lazyData->data = from.lazyData->data;
+                to.lazyData->isNeedConvert = from.lazyData->isNeedConvert;
+                to.lazyData->stringPool = from.lazyData->stringPool;
+                return;
+            }
+        }
+        copyByBinary(from, to);
+    }
+
+    template<class T>
+    static std::u16string getOverlayKey(const std::shared_ptr<T> &id) {
+        if constexpr (std::is_base_of_v<NamespaceId, T>) {
+            return id->getIdWithNamespace()->name;
+        } else {
+            return id->name;
+        }
+    }
+
+    template<class T>
+    static std::shared_ptr<std::vector<std::shared_ptr<T>>> mergeIds(const std::vector<std::shared_ptr<T>> &base,
+                                                                    const std::vector<std::shared_ptr<T>> &overlay) {
+        // ID列表是新的，但是没有修改的ID对象和基础资源包共享
+        auto result = std::make_shared<std::vector<std::shared_ptr<T>>>(base);
+        std::unordered_map<std::u16string, size_t> indexes;
+        indexes.reserve(result->size() + overlay.size());
+        for (size_t i = 0; i < result->size(); ++i) {
+            indexes.emplace(getOverlayKey((*result)[i]), i);
+        }
+        for (const auto &item: overlay) {
+            auto [it, isInserted] = indexes.emplace(getOverlayKey(item), result->size());
+            if (isInserted) {
+                result->push_back(item);
+            } else {
+                (*result)[it->second] = item;
+            }
+        }
+        return result;
+    }
+
+    static void remapPropertyValue(PropertyType::PropertyType type, PropertyValue &value,
+                                   const StringPool &from, StringPool &to) {
+        if (type == PropertyType::STRING) {
+            value.string = to.intern(from.get(value.string));
+        }
+    }
+
+    static void remapPropertyValues(std::vector<BlockPropertyDescription> &descriptions,
+                                    const StringPool &from, StringPool &to) {
+        for (auto &item: descriptions) {
+            for (auto &item1: item.values) {
+                remapPropertyValue(item.type, item1.valueName, from, to);
+            }
+        }
+    }
+
+    /**
+     * 把叠加资源包的方块状态的值改为合并后的字符串池中的下标
+     */
+    static void remapPropertyValues(BlockIds &overlay, StringPool &to) {
+        const StringPool &from = overlay.propertyValues;
+        for (const auto &item: *overlay.blockStateValues) {
+            if (!item->properties.has_value()) {
+                continue;
+            }
+            for (auto &item1: item->properties.value()) {
+                remapPropertyValue(item1.type, item1.defaultValue, from, to);
+                if (item1.valid.has_value()) {
+                    for (auto &item2: item1.valid.value()) {
+                        remapPropertyValue(item1.type, item2, from, to);
+                    }
+                }
+            }
+        }
+        remapPropertyValues(overlay.blockPropertyDescriptions.common, from, to);
+        for (auto &item: overlay.blockPropertyDescriptions.block) {
+            remapPropertyValues(item.properties, from, to);
+        }
+    }
+
+    static std::shared_ptr<BlockIds> mergeBlockIds(const BlockIds &base, BlockIds &overlay) {
+        auto result = std::make_shared<BlockIds>();
+        // 基础资源包的方块ID直接共用，所以字符串池保持基础资源包的下标
+        result->propertyValues = base.propertyValues;
+        remapPropertyValues(overlay, result->propertyValues);
+        const BlockPropertyDescriptions &overlayDescriptions = overlay.blockPropertyDescriptions;
+        if (overlayDescriptions.common.empty() && overlayDescriptions.block.empty()) [[likely]] {
+            result->blockPropertyDescriptions = base.blockPropertyDescriptions;
+            result->blockStateValues = mergeIds(*base.blockStateValues, *overlay.blockStateValues);
+            return result;
+        }
+        // 针对某些方块的描述优先匹配，所以叠加资源包的放在前面
+        BlockPropertyDescriptions &descriptions = result->blockPropertyDescriptions;
+        descriptions.block = overlayDescriptions.block;
+        descriptions.block.insert(descriptions.block.end(), base.blockPropertyDescriptions.block.begin(), base.blockPropertyDescriptions.block.end());
+        descriptions.common = base.blockPropertyDescriptions.common;
+        for (const auto &item: overlayDescriptions.common) {
+            auto it = std::ranges::find_if(descriptions.common, [&item](const BlockPropertyDescription &item1) {
+                return item1.propertyName == item.propertyName;
+            });
+            if (it == descriptions.common.end()) {
+                descriptions.common.push_back(item);
+            } else {
+                *it = item;
+            }
+        }
+        // 方块状态的描述改变了，方块缓存的节点不能继续共享，需要复制一份
+        std::vector<std::shared_ptr<BlockId>> blockStateValues;
+        blockStateValues.reserve(base.blockStateValues->size());
+        for (const auto &item: *base.blockStateValues) {
+            auto blockId = std::make_shared<BlockId>();
+            copyByBinary(*item, *blockId);
+            blockStateValues.push_back(std::move(blockId));
+        }
+        result->blockStateValues = mergeIds(blockStateValues, *overlay.blockStateValues);
+        return result;
+    }
+
+    void CPack::applyOverlayBase(const CPack &base) {
+        // ID不会在加载之后修改，只有延迟生成的节点和哈希值是线程安全的缓存，所以可以直接共享
+        normalIds = base.normalIds;
+        namespaceIds = base.namespaceIds;
+        blockIds = base.blockIds;
+        itemIds = base.itemIds;
+    }
+
+    void CPack::applyOverlayId(const rapidjson::GenericValue<rapidjson::UTF8<>> &j) {
+        using JsonValueType = rapidjson::GenericValue<rapidjson::UTF8<>>;
+        std::u16string type;
+        serialization::Codec<decltype(type)>::template from_json_member<JsonValueType>(j, "type", type);
+        if (type == u"normal") [[likely]] {
+            std::string id;
+            serialization::Codec<decltype(id)>::template from_json_member<JsonValueType>(j, "id", id);
+            std::shared_ptr<std::vector<std::shared_ptr<NormalId>>> content;
+            serialization::Codec<decltype(content)>::template from_json_member<JsonValueType>(j, "content", content);
+            auto &ids = normalIds[id];
+            ids = ids == nullptr ? std::move(content) : mergeIds(*ids, *content);
+        } else if (type == u"namespace") [[likely]] {
+            std::string id;
+            serialization::Codec<decltype(id)>::template from_json_member<JsonValueType>(j, "id", id);
+            std::shared_ptr<std::vector<std::shared_ptr<NamespaceId>>> content;
+            serialization::Codec<decltype(content)>::template from_json_member<JsonValueType>(j, "content", content);
+            auto &ids = namespaceIds[id];
+            ids = ids == nullptr ? std::move(content) : mergeIds(*ids, *content);
+        } else if (type == u"block") [[likely]] {
+            std::shared_ptr<BlockIds> content;
+            serialization::Codec<decltype(content)>::template from_json_member<JsonValueType>(j, "content", content);
+            blockIds = blockIds == nullptr ? std::move(content) : mergeBlockIds(*blockIds, *content);
+        } else if (type == u"item") [[likely]] {
+            std::shared_ptr<std::vector<std::shared_ptr<ItemId>>> content;
+            serialization::Codec<decltype(content)>::template from_json_member<JsonValueType>(j, "content", content);
+            itemIds = itemIds == nullptr ? std::move(content) : mergeIds(*itemIds, *content);
+        } else {
+            Profile::push("unknown id type -> {}", FORMAT_ARG(utf8::utf16to8(type)));
+            throw std::runtime_error("unknown id type");
+        }
+    }
+
+    void CPack::applyOverlayNodes(const CPack &base) {
+        // 节点初始化后会引用所在资源包的数据，所以不能共享，没有被叠加资源包修改的节点复制一份
+        // 复制时字符串直接写在数据中，不使用字符串池
+        StringPool::Scope stringPoolScope(nullptr);
+        // json nodes
+        currentCreateStage = Node::NodeCreateStage::JSON_NODE;
+        std::unordered_set<std::string> overlayJsonIds;
+        for (const auto &item: jsonNodes) {
+            overlayJsonIds.insert(item.id.value());
+        }
+        for (const auto &item: base.jsonNodes) {
+            if (!overlayJsonIds.contains(item.id.value())) {
+                copyByBinary(item, jsonNodes.emplace_back());
+            }
+        }
+        // repeat nodes
+        currentCreateStage = Node::NodeCreateStage::REPEAT_NODE;
+        std::unordered_set<std::string> overlayRepeatIds;
+        for (const auto &item: repeatNodeData) {
+            overlayRepeatIds.insert(item.id);
+        }
+        for (const auto &item: base.repeatNodeData) {
+            if (!overlayRepeatIds.contains(item.id)) {
+                copyByBinary(item, repeatNodeData.emplace_back());
+            }
+        }
+        // commands
+        currentCreateStage = Node::NodeCreateStage::COMMAND_PARAM_NODE;
+        std::unordered_set<std::u16string> overlayCommandNames;
+        for (const auto &item: *commands) {
+            overlayCommandNames.insert(item.name.begin(), item.name.end());
+        }
+        for (const auto &item: *base.commands) {
+            if (!overlayCommandNames.contains(item.name[0])) {
+                copyCommand(item, commands->emplace_back());
+            }
+        }
+        currentCreateStage = Node::NodeCreateStage::NONE;
+    }
+
     void CPack::afterApply() {
+        // block property descriptions
+        Profile::push("index block property descriptions");
+        if (blockIds != nullptr) [[likely]] {
+            blockIds->blockPropertyDescriptions.buildIndex();
+        }
         // selector nodes
-        Profile::push("init selector nodes");
+        Profile::next("init selector nodes");
         targetSelectorData.init(*this);
         // json nodes
         Profile::next("init json nodes");
@@ -250,6 +677,13 @@ namespace CHelper {
             Profile::next(R"(init command: "{}")", FORMAT_ARG(utf8::utf16to8(fmt::format(u"{}", fmt::join(item.name, u",")))));
             Node::initNode(item, *this);
         }
+        Profile::next("share identical command nodes");
+        for (auto &item: *commands) {
+            if (item.isLoaded()) [[likely]] {
+                // 还没有解析的命令在第一次使用时去重
+                shareIdenticalNodes(item);
+            }
+        }
         Profile::next("sort command nodes");
         std::ranges::sort(*commands, [](const auto &item1, const auto &item2) {
             return item1.name[0] < item2.name[0];
@@ -259,6 +693,212 @@ namespace CHelper {
         Profile::pop();
     }
 
+    /**
+     * 记录命令在去重表中注册的节点，没有提交就离开作用域时删除这些节点，避免去重表保留已经释放的节点
+     */
+    class CanonicalNodesRegistration {
+    private:
+        std::unordered_map<XXH64_hash_t, Node::NodeWithType> &canonicalNodes;
+        std::mutex &mutex;
+        std::vector<XXH64_hash_t> insertedHashes;
+        bool isCommitted = false;
+
+    public:
+        CanonicalNodesRegistration(std::unordered_map<XXH64_hash_t, Node::NodeWithType> &canonicalNodes, std::mutex &mutex)
+            : canonicalNodes(canonicalNodes),
+              mutex(mutex) {}
+
+        CanonicalNodesRegistration(const CanonicalNodesRegistration &) = delete;
+
+        CanonicalNodesRegistration &operator=(const CanonicalNodesRegistration &) = delete;
+
+        //需要持有锁
+        void add(XXH64_hash_t hash) {
+            insertedHashes.push_back(hash);
+        }
+
+        void commit() {
+            isCommitted = true;
+        }
+
+        ~CanonicalNodesRegistration() {
+            if (isCommitted || insertedHashes.empty()) [[likely]] {
+                return;
+            }
+            std::lock_guard lock(mutex);
+            for (const auto &hash: insertedHashes) {
+                canonicalNodes.erase(hash);
+            }
+        }
+    };
+
+    void CPack::shareIdenticalNodes(Node::NodePerCommand &command) const {
+        // 从json和旧格式加载的命令没有资源生成器计算的哈希值，在加锁之前计算
+        std::vector<XXH64_hash_t> nodeHashes;
+        nodeHashes.reserve(command.nodes.nodes.size());
+        for (const auto &node: command.nodes.nodes) {
+            nodeHashes.push_back(serialization::Codec<Node::NodePerCommand>::to_node_hash(node));
+        }
+        shareIdenticalNodes(command, nodeHashes);
+    }
+
+    void CPack::shareIdenticalNodes(Node::NodePerCommand &command, const std::vector<XXH64_hash_t> &nodeHashes) const {
+        if (nodeHashes.size() != command.nodes.nodes.size()) [[unlikely]] {
+            Profile::push("hash count: {}, node count: {}", FORMAT_ARG(nodeHashes.size()), FORMAT_ARG(command.nodes.nodes.size()));
+            throw std::runtime_error("node hash count does not match node count");
+        }
+        std::unordered_map<Node::NodeBase *, Node::NodeWithType> replacements;
+        std::vector<Node::NodeWithType> ownNodes;
+        ownNodes.reserve(command.nodes.nodes.size());
+        CanonicalNodesRegistration registration(canonicalNodes, canonicalNodesMutex);
+        {
+            // 多条命令可能在不同的线程中同时延迟加载，锁内只查找哈希值
+            std::lock_guard lock(canonicalNodesMutex);
+            for (size_t i = 0; i < command.nodes.nodes.size(); ++i) {
+                const auto &node = command.nodes.nodes[i];
+                auto [it, isInserted] = canonicalNodes.try_emplace(nodeHashes[i], node);
+                if (isInserted) {
+                    registration.add(nodeHashes[i]);
+                }
+                // 和NormalId::fastMatch一样认为哈希值相同时内容相同，类型不同时保留自己的节点
+                if (isInserted || it->second.nodeTypeId != node.nodeTypeId) {
+                    ownNodes.push_back(node);
+                    continue;
+                }
+                replacements.emplace(node.data, it->second);
+                command.sharedNodes.push_back(it->second);
+            }
+        }
+        if (!replacements.empty()) {
+            // 被替换的节点在函数结束时释放
+            Node::FreeableNodeWithTypes duplicateNodes;
+            duplicateNodes.nodes.reserve(replacements.size());
+            for (const auto &node: command.nodes.nodes) {
+                if (replacements.contains(node.data)) {
+                    duplicateNodes.nodes.push_back(node);
+                }
+            }
+            command.nodes.nodes = std::move(ownNodes);
+            for (auto &wrappedNode: command.wrappedNodes) {
+                auto it = replacements.find(wrappedNode.innerNode.data);
+                if (it != replacements.end()) {
+                    wrappedNode.innerNode = it->second;
+                }
+            }
+        }
+        registration.commit();
+    }
+
+    template<class T>
+    static std::vector<uint64_t> getNameHashes(const std::vector<std::shared_ptr<T>> *ids) {
+        std::vector<uint64_t> result;
+        if (ids == nullptr) [[unlikely]] {
+            return result;
+        }
+        result.reserve(ids->size());
+        for (const auto &item: *ids) {
+            result.push_back(item->getNameHash());
+        }
+        return result;
+    }
+
+    template<class T>
+    static std::vector<uint64_t> getIdWithNamespaceHashes(const std::vector<std::shared_ptr<T>> *ids) {
+        std::vector<uint64_t> result;
+        if (ids == nullptr) [[unlikely]] {
+            return result;
+        }
+        result.reserve(ids->size());
+        for (const auto &item: *ids) {
+            result.push_back(item->getIdWithNamespaceHash());
+        }
+        return result;
+    }
+
+    template<class T>
+    static void readNameHashes(std::istream &istream, const std::vector<std::shared_ptr<T>> *ids, bool isUsable) {
+        std::vector<uint64_t> hashes;
+        serialization::from_binary(istream, hashes);
+        if (!isUsable) [[unlikely]] {
+            return;
+        }
+        // 没有的ID按照空的ID列表处理
+        const size_t idCount = ids == nullptr ? 0 : ids->size();
+        if (hashes.size() != idCount) [[unlikely]] {
+            Profile::push("hash count: {}, id count: {}", FORMAT_ARG(hashes.size()), FORMAT_ARG(idCount));
+            throw std::runtime_error("precomputed id hashes do not match id data");
+        }
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            (*ids)[i]->setNameHash(hashes[i]);
+        }
+    }
+
+    template<class T>
+    static void readIdWithNamespaceHashes(std::istream &istream, const std::vector<std::shared_ptr<T>> *ids, bool isUsable) {
+        std::vector<uint64_t> hashes;
+        serialization::from_binary(istream, hashes);
+        if (!isUsable) [[unlikely]] {
+            return;
+        }
+        // 没有的ID按照空的ID列表处理
+        const size_t idCount = ids == nullptr ? 0 : ids->size();
+        if (hashes.size() != idCount) [[unlikely]] {
+            Profile::push("hash count: {}, id count: {}", FORMAT_ARG(hashes.size()), FORMAT_ARG(idCount));
+            throw std::runtime_error("precomputed id hashes do not match id data");
+        }
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            (*ids)[i]->setIdWithNamespaceHash(hashes[i]);
+        }
+    }
+
+    void CPack::applyIdHashes(std::istream &istream) {
+        // 哈希值是按照字符串的字节计算的，字节序不同的时候不能使用
+        bool isLittleEndian;
+        serialization::from_binary(istream, isLittleEndian);
+        bool isUsable = isLittleEndian == (std::endian::native == std::endian::little);
+        uint32_t size;
+        serialization::from_binary(istream, size);
+        for (uint32_t i = 0; i < size; ++i) {
+            std::string key;
+            serialization::from_binary(istream, key);
+            auto it = normalIds.find(key);
+            readNameHashes(istream, it == normalIds.end() ? nullptr : it->second.get(), isUsable);
+        }
+        serialization::from_binary(istream, size);
+        for (uint32_t i = 0; i < size; ++i) {
+            std::string key;
+            serialization::from_binary(istream, key);
+            auto it = namespaceIds.find(key);
+            readNameHashes(istream, it == namespaceIds.end() ? nullptr : it->second.get(), isUsable);
+            readIdWithNamespaceHashes(istream, it == namespaceIds.end() ? nullptr : it->second.get(), isUsable);
+        }
+        readNameHashes(istream, itemIds.get(), isUsable);
+        readIdWithNamespaceHashes(istream, itemIds.get(), isUsable);
+        const auto *blockStateValues = blockIds == nullptr ? nullptr : blockIds->blockStateValues.get();
+        readNameHashes(istream, blockStateValues, isUsable);
+        readIdWithNamespaceHashes(istream, blockStateValues, isUsable);
+    }
+
+    void CPack::writeIdHashes(std::ostream &ostream) const {
+        serialization::to_binary(ostream, std::endian::native == std::endian::little);
+        serialization::to_binary(ostream, static_cast<uint32_t>(normalIds.size()));
+        for (const auto &item: normalIds) {
+            serialization::to_binary(ostream, item.first);
+            serialization::to_binary(ostream, getNameHashes(item.second.get()));
+        }
+        serialization::to_binary(ostream, static_cast<uint32_t>(namespaceIds.size()));
+        for (const auto &item: namespaceIds) {
+            serialization::to_binary(ostream, item.first);
+            serialization::to_binary(ostream, getNameHashes(item.second.get()));
+            serialization::to_binary(ostream, getIdWithNamespaceHashes(item.second.get()));
+        }
+        serialization::to_binary(ostream, getNameHashes(itemIds.get()));
+        serialization::to_binary(ostream, getIdWithNamespaceHashes(itemIds.get()));
+        const auto *blockStateValues = blockIds == nullptr ? nullptr : blockIds->blockStateValues.get();
+        serialization::to_binary(ostream, getNameHashes(blockStateValues));
+        serialization::to_binary(ostream, getIdWithNamespaceHashes(blockStateValues));
+    }
+
 #ifndef CHELPER_NO_FILESYSTEM
     std::unique_ptr<CPack> CPack::createByDirectory(const std::filesystem::path &path) {
         Profile::push("start load CPack by DIRECTORY: {}", FORMAT_ARG(path.string()));
@@ -282,6 +922,22 @@ namespace CHelper {
         return cpack;
     }
 
+#ifndef CHELPER_NO_FILESYSTEM
+    std::unique_ptr<CPack> CPack::createByOverlay(const CPack &base, const std::filesystem::path &path) {
+        Profile::push("start load overlay CPack by DIRECTORY: {}", FORMAT_ARG(path.string()));
+        auto cpack = std::make_unique<CPack>(base, path);
+        Profile::pop();
+        return cpack;
+    }
+#endif
+
+    std::unique_ptr<CPack> CPack::createByOverlay(const CPack &base, const rapidjson::GenericDocument<rapidjson::UTF8<>> &j) {
+        Profile::push("start load overlay CPack by JSON");
+        auto cpack = std::make_unique<CPack>(base, j);
+        Profile::pop();
+        return cpack;
+    }
+
 #ifndef CHELPER_NO_FILESYSTEM
     template<class JsonType>
     void writeJsonToFileWithCreateDirectory(const std::filesystem::path &path, const JsonType &j) {
@@ -406,29 +1062,48 @@ namespace CHelper {
         writeJsonToFileWithCreateDirectory<rapidjson::GenericDocument<rapidjson::UTF8<>>>(path, toJson());
     }
 
-    void CPack::writeBinToFile(const std::filesystem::path &path) const {
+    StringPool CPack::writeBinToFile(const std::filesystem::path &path) const {
         std::filesystem::create_directories(path.parent_path());
         Profile::push("writing binary cpack to file: {}", FORMAT_ARG(path.string()));
+        //字符串池需要写在最前面，所以先把其它数据写到内存中
+        StringPool stringPool;
+        std::ostringstream body;
+        {
+            StringPool::Scope stringPoolScope(&stringPool);
+            //normal id
+            serialization::to_binary(body, normalIds);
+            //namespace id
+            serialization::to_binary(body, namespaceIds);
+            //item id
+            serialization::to_binary(body, itemIds);
+            //block id
+            serialization::to_binary(body, blockIds);
+            //json node
+            serialization::to_binary(body, jsonNodes);
+            //repeat node
+            serialization::to_binary(body, repeatNodeData);
+            //command
+            serialization::to_binary(body, commands);
+            //precomputed id hashes
+            writeIdHashes(body);
+        }
         std::ofstream ostream(path, std::ios::binary);
+        //header
+        serialization::to_binary(ostream, BINARY_MAGIC);
+        serialization::to_binary(ostream, BINARY_FORMAT_VERSION);
         //manifest
         serialization::to_binary(ostream, manifest);
-        //normal id
-        serialization::to_binary(ostream, normalIds);
-        //namespace id
-        serialization::to_binary(ostream, namespaceIds);
-        //item id
-        serialization::to_binary(ostream, itemIds);
-        //block id
-        serialization::to_binary(ostream, blockIds);
-        //json node
-        serialization::to_binary(ostream, jsonNodes);
-        //repeat node
-        serialization::to_binary(ostream, repeatNodeData);
-        //command
-        serialization::to_binary(ostream, commands);
-
+        //string pool
+        serialization::to_binary(ostream, static_cast<uint32_t>(stringPool.size()));
+        for (uint32_t i = 0; i < stringPool.size(); ++i) {
+            serialization::to_binary(ostream, stringPool.get(i));
+        }
+        //body
+        const std::string bodyData = body.str();
+        ostream.write(bodyData.data(), static_cast<std::streamsize>(bodyData.size()));
         ostream.close();
         Profile::pop();
+        return stringPool;
     }
 #endif
 
@@ -461,4 +1136,84 @@ namespace CHelper {
         return it->second;
     }
 
+    MemoryUsage::Report CPack::getMemoryUsage() const {
+        using namespace MemoryUsage;
+        Report report;
+        // id
+        Counter &normalIdCounter = report.categories[Category::NORMAL_IDS];
+        normalIdCounter.bytes += getHeapSize(normalIds);
+        for (const auto &[key, ids]: normalIds) {
+            normalIdCounter.bytes += getHeapSize(key);
+            addIds(normalIdCounter, ids);
+        }
+        Counter &namespaceIdCounter = report.categories[Category::NAMESPACE_IDS];
+        namespaceIdCounter.bytes += getHeapSize(namespaceIds);
+        for (const auto &[key, ids]: namespaceIds) {
+            namespaceIdCounter.bytes += getHeapSize(key);
+            addIds(namespaceIdCounter, ids);
+        }
+        if (blockIds != nullptr) [[likely]] {
+            Counter &blockIdCounter = report.categories[Category::BLOCK_IDS];
+            blockIdCounter.bytes += sizeof(BlockIds) + SHARED_CONTROL_BLOCK_SIZE +
+                                    getHeapSize(blockIds->propertyValues) +
+                                    getHeapSize(blockIds->blockPropertyDescriptions);
+            addIds(blockIdCounter, blockIds->blockStateValues);
+            blockIds->nodeCache->addMemoryUsage(report.categories[Category::BLOCK_NODE_CACHE]);
+        }
+        addIds(report.categories[Category::ITEM_IDS], itemIds);
+        itemNodeCache->addMemoryUsage(report.categories[Category::ITEM_NODE_CACHE]);
+        // json node
+        Counter &jsonNodeCounter = report.categories[Category::JSON_NODES];
+        jsonNodeCounter.bytes += getHeapSize(jsonNodes);
+        for (const auto &item: jsonNodes) {
+            jsonNodeCounter.objectCount++;
+            jsonNodeCounter.bytes += (item.id.has_value() ? getHeapSize(item.id.value()) : 0) + getHeapSize(item.startNodeId);
+            addNodes(jsonNodeCounter, item.nodes);
+        }
+        // repeat node
+        Counter &repeatNodeCounter = report.categories[Category::REPEAT_NODE_DATA];
+        repeatNodeCounter.bytes += getHeapSize(repeatNodeData) + getHeapSize(repeatNodes);
+        for (const auto &item: repeatNodeData) {
+            repeatNodeCounter.objectCount++;
+            repeatNodeCounter.bytes += getHeapSize(item.id) + getHeapSize(item.repeatNodes) + getHeapSize(item.isEnd);
+            addNodes(repeatNodeCounter, item.breakNodes);
+            for (const auto &nodes: item.repeatNodes) {
+                addNodes(repeatNodeCounter, nodes);
+            }
+        }
+        for (const auto &item: repeatNodes) {
+            repeatNodeCounter.bytes += getHeapSize(item.first);
+        }
+        // command
+        Counter &commandCounter = report.categories[Category::COMMANDS];
+        commandCounter.bytes += sizeof(*commands) + SHARED_CONTROL_BLOCK_SIZE + getHeapSize(*commands);
+        // 还没有解析的命令共用字符串池，只统计一次
+        std::unordered_set<const StringPool *> stringPools;
+        for (const auto &command: *commands) {
+            commandCounter.objectCount++;
+            // 统计时其它线程可能正在解析这条命令
+            std::unique_lock<std::mutex> lazyLock;
+            if (command.lazyData != nullptr) {
+                lazyLock = std::unique_lock(command.lazyData->mutex);
+                commandCounter.bytes += sizeof(Node::LazyCommandData) + getHeapSize(command.lazyData->data);
+                if (command.lazyData->stringPool != nullptr && stringPools.insert(command.lazyData->stringPool.get()).second) {
+                    commandCounter.bytes += sizeof(StringPool) + SHARED_CONTROL_BLOCK_SIZE + getHeapSize(*command.lazyData->stringPool);
+                }
+            }
+            commandCounter.bytes += getHeapSize(command.name) + getHeapSize(command.description) + getHeapSize(command.syntax) +
+                                    getHeapSize(command.sharedNodes) + getHeapSize(command.wrappedNodes) + getHeapSize(command.startNodes);
+            for (const auto &wrappedNode: command.wrappedNodes) {
+                commandCounter.bytes += getHeapSize(wrappedNode.nextNodes);
+            }
+            addNodes(commandCounter, command.nodes);
+        }
+        {
+            std::lock_guard lock(canonicalNodesMutex);
+            commandCounter.bytes += getHeapSize(canonicalNodes);
+        }
+        // cache node
+        addNodes(report.categories[Category::CACHE_NODES], cacheNodes);
+        return report;
+    }
+
 }// namespace CHelper
@@ -23,6 +23,8 @@
 
 #include <chelper/node/CommandNode.h>
 #include <chelper/resources/Manifest.h>
+#include <chelper/resources/MemoryUsage.h>
+#include <chelper/resources/StringPool.h>
 #include <chelper/resources/id/BlockId.h>
 #include <chelper/resources/id/ItemId.h>
 #include <pch.h>
@@ -31,11 +33,17 @@ namespace CHelper {
 
     class CPack {
     public:
+        //二进制资源包开头的标识，内容为"CHPK"
+        static constexpr uint32_t BINARY_MAGIC = 0x4B504843;
+        //二进制资源包的格式版本，格式改变时加一，版本不同的资源包需要用资源生成器重新生成
+        static constexpr uint32_t BINARY_FORMAT_VERSION = 2;
         Manifest manifest;
         std::unordered_map<std::string, std::shared_ptr<std::vector<std::shared_ptr<NormalId>>>> normalIds;
         std::unordered_map<std::string, std::shared_ptr<std::vector<std::shared_ptr<NamespaceId>>>> namespaceIds;
         std::shared_ptr<BlockIds> blockIds;
         std::shared_ptr<std::vector<std::shared_ptr<ItemId>>> itemIds;
+        //物品附加值的节点缓存
+        std::shared_ptr<IdNodeCache> itemNodeCache = std::make_shared<IdNodeCache>();
         std::vector<Node::NodeJsonElement> jsonNodes;
         std::vector<Node::RepeatData> repeatNodeData;
         std::unordered_map<std::string, std::pair<const Node::RepeatData *, Node::NodeWithType>> repeatNodes;
@@ -45,6 +53,9 @@ namespace CHelper {
 
     private:
         Node::FreeableNodeWithTypes cacheNodes;
+        //命令中已经出现过的节点，键为节点序列化后的哈希值，延迟加载的命令解析时也会在这里查找
+        mutable std::unordered_map<XXH64_hash_t, Node::NodeWithType> canonicalNodes;
+        mutable std::mutex canonicalNodesMutex;
 
     public:
 #ifndef CHELPER_NO_FILESYSTEM
@@ -55,7 +66,20 @@ namespace CHelper {
 
         explicit CPack(std::istream &istream);
 
+        //叠加资源包，只包含相对基础资源包添加或修改的内容，没有修改的ID和基础资源包共享
+        //共享的ID只有延迟生成的节点和哈希值会被修改，这些修改是线程安全的，所以两个资源包可以在不同的线程中同时使用
+        //节点和命令都会复制，不和基础资源包共享
+#ifndef CHELPER_NO_FILESYSTEM
+        CPack(const CPack &base, const std::filesystem::path &path);
+#endif
+
+        CPack(const CPack &base, const rapidjson::GenericDocument<rapidjson::UTF8<>> &j);
+
     private:
+#ifndef CHELPER_NO_FILESYSTEM
+        void applyId(const std::filesystem::path &path);
+#endif
+
         void applyId(const rapidjson::GenericValue<rapidjson::UTF8<>> &j);
 
         void applyJson(const rapidjson::GenericValue<rapidjson::UTF8<>> &j);
@@ -64,9 +88,29 @@ namespace CHelper {
 
         void applyCommand(const rapidjson::GenericValue<rapidjson::UTF8<>> &j) const;
 
+        void applyOverlayBase(const CPack &base);
+
+        void applyOverlayId(const rapidjson::GenericValue<rapidjson::UTF8<>> &j);
+
+        void applyOverlayNodes(const CPack &base);
+
+        //读取没有文件头的旧格式二进制资源包，命令不能延迟解析
+        void applyLegacyBinary(std::istream &istream);
+
         void afterApply();
 
+        //资源生成器预先计算的ID名字哈希值，写在二进制资源包的最后，加载时不用再计算
+        void applyIdHashes(std::istream &istream);
+
+        void writeIdHashes(std::ostream &ostream) const;
+
     public:
+        //命令中和已经加载的命令序列化后完全相同的节点只保留一个，命令需要已经初始化
+        void shareIdenticalNodes(Node::NodePerCommand &command) const;
+
+        //使用资源生成器预先计算的节点哈希值，失败时不会在去重表中留下节点
+        void shareIdenticalNodes(Node::NodePerCommand &command, const std::vector<XXH64_hash_t> &nodeHashes) const;
+
 #ifndef CHELPER_NO_FILESYSTEM
         static std::unique_ptr<CPack> createByDirectory(const std::filesystem::path &path);
 #endif
@@ -75,6 +119,12 @@ namespace CHelper {
 
         static std::unique_ptr<CPack> createByBinary(std::istream &istream);
 
+#ifndef CHELPER_NO_FILESYSTEM
+        static std::unique_ptr<CPack> createByOverlay(const CPack &base, const std::filesystem::path &path);
+#endif
+
+        static std::unique_ptr<CPack> createByOverlay(const CPack &base, const rapidjson::GenericDocument<rapidjson::UTF8<>> &j);
+
 #ifndef CHELPER_NO_FILESYSTEM
         void writeJsonToDirectory(const std::filesystem::path &path) const;
 #endif
@@ -84,7 +134,8 @@ namespace CHelper {
 #ifndef CHELPER_NO_FILESYSTEM
         void writeJsonToFile(const std::filesystem::path &path) const;
 
-        void writeBinToFile(const std::filesystem::path &path) const;
+        //返回写入时使用的字符串池，用来统计字符串池的效果
+        StringPool writeBinToFile(const std::filesystem::path &path) const;
 #endif
 
         [[nodiscard]] std::shared_ptr<std::vector<std::shared_ptr<NormalId>>>
@@ -92,6 +143,11 @@ namespace CHelper {
 
         [[nodiscard]] std::shared_ptr<std::vector<std::shared_ptr<NamespaceId>>>
         getNamespaceId(const std::string &key) const;
+
+        /**
+         * 统计每个部分占用的内存，包括使用时才创建的方块和物品节点
+         */
+        [[nodiscard]] MemoryUsage::Report getMemoryUsage() const;
     };
 
 }// namespace CHelper
@@ -0,0 +1,63 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_LEGACYBINARYFORMAT_H
+#define CHELPER_LEGACYBINARYFORMAT_H
+
+#include <pch.h>
+
+namespace CHelper {
+
+    /**
+     * 没有文件头的旧格式二进制资源包
+     *
+     * 旧格式没有字符串池，方块状态的字符串值直接写在数据中，命令的节点也直接写在数据中，不能延迟解析
+     */
+    class LegacyBinaryFormat {
+    public:
+        // 当前线程是否正在读取旧格式的二进制资源包
+        static thread_local bool isReading;
+
+        /**
+         * 在作用域内读取旧格式，离开作用域时恢复，抛出异常时也会恢复
+         */
+        class Scope {
+        private:
+            bool lastIsReading;
+
+        public:
+            Scope()
+                : lastIsReading(isReading) {
+                isReading = true;
+            }
+
+            Scope(const Scope &) = delete;
+
+            Scope &operator=(const Scope &) = delete;
+
+            ~Scope() {
+                isReading = lastIsReading;
+            }
+        };
+    };
+
+}// namespace CHelper
+
+#endif//CHELPER_LEGACYBINARYFORMAT_H
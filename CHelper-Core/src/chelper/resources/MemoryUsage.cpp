@@ -0,0 +1,162 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/node/NodeType.h>
+#include <chelper/resources/MemoryUsage.h>
+#include <chelper/resources/id/BlockId.h>
+#include <chelper/resources/id/ItemId.h>
+#include <chelper/serialization/Serialization.h>
+
+#define CHELPER_GET_NODE_SIZE(v1) \
+    case Node::NodeTypeId::v1:    \
+        return sizeof(typename Node::NodeTypeDetail<Node::NodeTypeId::v1>::Type);
+
+namespace CHelper::MemoryUsage {
+
+    const char *getCategoryName(Category::Category category) {
+        switch (category) {
+            case Category::NORMAL_IDS:
+                return "normalIds";
+            case Category::NAMESPACE_IDS:
+                return "namespaceIds";
+            case Category::BLOCK_IDS:
+                return "blockIds";
+            case Category::ITEM_IDS:
+                return "itemIds";
+            case Category::JSON_NODES:
+                return "jsonNodes";
+            case Category::REPEAT_NODE_DATA:
+                return "repeatNodeData";
+            case Category::COMMANDS:
+                return "commands";
+            case Category::CACHE_NODES:
+                return "cacheNodes";
+            case Category::BLOCK_NODE_CACHE:
+                return "blockNodeCache";
+            case Category::ITEM_NODE_CACHE:
+                return "itemNodeCache";
+            default:
+                return "unknown";
+        }
+    }
+
+    void Counter::add(const Counter &counter) {
+        objectCount += counter.objectCount;
+        bytes += counter.bytes;
+    }
+
+    Counter Report::getTotal() const {
+        Counter result;
+        for (const auto &item: categories) {
+            result.add(item);
+        }
+        return result;
+    }
+
+    std::string Report::toString() const {
+        std::string result;
+        fmt::format_to(std::back_inserter(result), "{:<18}{:>12}{:>16}\n", "category", "objects", "bytes");
+        for (uint8_t category = 0; category < Category::COUNT; ++category) {
+            fmt::format_to(std::back_inserter(result), "{:<18}{:>12}{:>16}\n",
+                           getCategoryName(static_cast<Category::Category>(category)),
+                           categories[category].objectCount,
+                           categories[category].bytes);
+        }
+        Counter total = getTotal();
+        fmt::format_to(std::back_inserter(result), "{:<18}{:>12}{:>16}\n", "total", total.objectCount, total.bytes);
+        result.append("node contents are estimated from their binary size\n");
+        return result;
+    }
+
+    std::streamsize CountingStreamBuf::xsputn(const char *s, std::streamsize count) {
+        size += static_cast<size_t>(count);
+        return count;
+    }
+
+    CountingStreamBuf::int_type CountingStreamBuf::overflow(int_type ch) {
+        size++;
+        return traits_type::not_eof(ch);
+    }
+
+    size_t getHeapSize(const StringPool &stringPool) {
+        size_t result = 0;
+        for (uint32_t i = 0; i < stringPool.size(); ++i) {
+            result += sizeof(std::u16string) + getHeapSize(stringPool.get(i));
+        }
+        return result;
+    }
+
+    size_t getHeapSize(const NormalId &id) {
+        return getHeapSize(id.name) + getHeapSize(id.description);
+    }
+
+    size_t getHeapSize(const NamespaceId &id) {
+        return getHeapSize(static_cast<const NormalId &>(id)) + getHeapSize(id.idNamespace);
+    }
+
+    size_t getHeapSize(const ItemId &id) {
+        return getHeapSize(static_cast<const NamespaceId &>(id)) + getHeapSize(id.descriptions);
+    }
+
+    size_t getHeapSize(const BlockId &id) {
+        size_t result = getHeapSize(static_cast<const NamespaceId &>(id));
+        if (id.properties.has_value()) {
+            result += getHeapSize(id.properties.value());
+            for (const auto &property: id.properties.value()) {
+                result += getHeapSize(property.name) + getHeapSize(property.valid);
+            }
+        }
+        return result;
+    }
+
+    static size_t getHeapSize(const std::vector<BlockPropertyDescription> &descriptions) {
+        size_t result = descriptions.capacity() * sizeof(BlockPropertyDescription);
+        for (const auto &description: descriptions) {
+            result += getHeapSize(description.propertyName) + getHeapSize(description.description) + getHeapSize(description.values);
+            for (const auto &value: description.values) {
+                result += getHeapSize(value.description);
+            }
+        }
+        return result;
+    }
+
+    size_t getHeapSize(const BlockPropertyDescriptions &blockPropertyDescriptions) {
+        size_t result = getHeapSize(blockPropertyDescriptions.common) + getHeapSize(blockPropertyDescriptions.block);
+        for (const auto &item: blockPropertyDescriptions.block) {
+            result += getHeapSize(item.blocks) + getHeapSize(item.properties);
+        }
+        return result;
+    }
+
+    size_t getNodeSize(Node::NodeTypeId::NodeTypeId nodeTypeId) {
+        switch (nodeTypeId) {
+            CODEC_PASTE(CHELPER_GET_NODE_SIZE, CHELPER_NODE_TYPES)
+            default:
+                return 0;
+        }
+    }
+
+    void addNodes(Counter &counter, const Node::FreeableNodeWithTypes &nodes) {
+        counter.objectCount += nodes.nodes.size();
+        counter.bytes += getHeapSize(nodes.nodes);
+        for (const auto &node: nodes.nodes) {
+            counter.bytes += getNodeSize(node.nodeTypeId) + getBinarySize(node);
+        }
+    }
+
+}// namespace CHelper::MemoryUsage
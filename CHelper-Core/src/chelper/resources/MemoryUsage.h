@@ -0,0 +1,181 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_MEMORYUSAGE_H
+#define CHELPER_MEMORYUSAGE_H
+
+#include <chelper/node/NodeWithType.h>
+#include <chelper/resources/StringPool.h>
+#include <pch.h>
+
+namespace CHelper {
+    class NormalId;
+    class NamespaceId;
+    class ItemId;
+    class BlockId;
+    class BlockPropertyDescriptions;
+}// namespace CHelper
+
+/**
+ * 统计资源包每个部分占用的内存
+ *
+ * ID和命令的字节数为对象本身的大小加上字符串和容器按容量计算的堆内存，不包括内存分配器的额外开销
+ * 节点的类型很多，节点中字符串和数组的内容通过二进制资源包的编码估算
+ */
+namespace CHelper::MemoryUsage {
+
+    namespace Category {
+        enum Category : uint8_t {
+            NORMAL_IDS,
+            NAMESPACE_IDS,
+            BLOCK_IDS,
+            ITEM_IDS,
+            JSON_NODES,
+            REPEAT_NODE_DATA,
+            COMMANDS,
+            CACHE_NODES,
+            // 使用时才创建的方块和物品节点
+            BLOCK_NODE_CACHE,
+            ITEM_NODE_CACHE,
+            COUNT
+        };
+    }// namespace Category
+
+    // make_shared创建的控制块的大小
+    constexpr size_t SHARED_CONTROL_BLOCK_SIZE = sizeof(void *) + 2 * sizeof(int32_t);
+
+    const char *getCategoryName(Category::Category category);
+
+    class Counter {
+    public:
+        size_t objectCount = 0;
+        size_t bytes = 0;
+
+        void add(const Counter &counter);
+    };
+
+    class Report {
+    public:
+        std::array<Counter, Category::COUNT> categories;
+
+        [[nodiscard]] Counter getTotal() const;
+
+        [[nodiscard]] std::string toString() const;
+    };
+
+    /**
+     * 只统计写入的字节数，不保存内容
+     */
+    class CountingStreamBuf : public std::streambuf {
+    public:
+        size_t size = 0;
+
+    protected:
+        std::streamsize xsputn(const char *s, std::streamsize count) override;
+
+        int_type overflow(int_type ch) override;
+    };
+
+    template<class Char>
+    size_t getHeapSize(const std::basic_string<Char> &str) {
+        // 短字符串保存在对象内部
+        if (str.capacity() <= std::basic_string<Char>().capacity()) {
+            return 0;
+        }
+        return (str.capacity() + 1) * sizeof(Char);
+    }
+
+    template<class T>
+    size_t getHeapSize(const std::vector<T> &vector) {
+        if constexpr (std::is_same_v<T, bool>) {
+            return (vector.capacity() + 7) / 8;
+        } else {
+            return vector.capacity() * sizeof(T);
+        }
+    }
+
+    template<class Char>
+    size_t getHeapSize(const std::vector<std::basic_string<Char>> &vector) {
+        size_t result = vector.capacity() * sizeof(std::basic_string<Char>);
+        for (const auto &item: vector) {
+            result += getHeapSize(item);
+        }
+        return result;
+    }
+
+    template<class T>
+    size_t getHeapSize(const std::optional<T> &optional) {
+        return optional.has_value() ? getHeapSize(optional.value()) : 0;
+    }
+
+    template<class Key, class Value, class Hash, class Equal, class Allocator>
+    size_t getHeapSize(const std::unordered_map<Key, Value, Hash, Equal, Allocator> &map) {
+        // 每个元素单独分配一个节点，节点中有一个指向下一个节点的指针
+        return map.bucket_count() * sizeof(void *) + map.size() * (sizeof(typename std::unordered_map<Key, Value, Hash, Equal, Allocator>::value_type) + sizeof(void *));
+    }
+
+    // 不包括查找字符串用的索引
+    size_t getHeapSize(const StringPool &stringPool);
+
+    size_t getHeapSize(const NormalId &id);
+
+    size_t getHeapSize(const NamespaceId &id);
+
+    size_t getHeapSize(const ItemId &id);
+
+    size_t getHeapSize(const BlockId &id);
+
+    // 不包括加载后构建的索引
+    size_t getHeapSize(const BlockPropertyDescriptions &blockPropertyDescriptions);
+
+    /**
+     * 按二进制资源包的格式编码后的大小，不使用字符串池，用于估算节点中字符串和数组的内容占用的内存
+     */
+    template<class T>
+    size_t getBinarySize(const T &t) {
+        CountingStreamBuf streamBuf;
+        std::ostream ostream(&streamBuf);
+        StringPool::Scope stringPoolScope(nullptr);
+        serialization::Codec<T>::template to_binary<false>(ostream, t);
+        return streamBuf.size;
+    }
+
+    /**
+     * 统计共享指针中的所有ID
+     */
+    template<class IdType>
+    void addIds(Counter &counter, const std::shared_ptr<std::vector<std::shared_ptr<IdType>>> &ids) {
+        if (ids == nullptr) [[unlikely]] {
+            return;
+        }
+        counter.bytes += sizeof(std::vector<std::shared_ptr<IdType>>) + SHARED_CONTROL_BLOCK_SIZE + getHeapSize(*ids);
+        for (const auto &id: *ids) {
+            counter.objectCount++;
+            counter.bytes += sizeof(IdType) + SHARED_CONTROL_BLOCK_SIZE + getHeapSize(*id);
+        }
+    }
+
+    size_t getNodeSize(Node::NodeTypeId::NodeTypeId nodeTypeId);
+
+    void addNodes(Counter &counter, const Node::FreeableNodeWithTypes &nodes);
+
+}// namespace CHelper::MemoryUsage
+
+#endif//CHELPER_MEMORYUSAGE_H
@@ -0,0 +1,84 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/resources/StringPool.h>
+
+namespace CHelper {
+
+    thread_local StringPool *StringPool::current = nullptr;
+
+    StringPool::StringPool(const StringPool &stringPool)
+        : strings(stringPool.strings),
+          referenceCount(stringPool.referenceCount),
+          referenceSize(stringPool.referenceSize) {
+        // 索引引用的是自己的字符串，不能直接复制
+        indexes.reserve(strings.size());
+        for (size_t i = 0; i < strings.size(); ++i) {
+            indexes.emplace(strings[i], static_cast<uint32_t>(i));
+        }
+    }
+
+    StringPool &StringPool::operator=(const StringPool &stringPool) {
+        if (this != &stringPool) [[likely]] {
+            *this = StringPool(stringPool);
+        }
+        return *this;
+    }
+
+    uint32_t StringPool::intern(std::u16string_view str) {
+        referenceCount++;
+        referenceSize += str.size() * sizeof(char16_t);
+        auto it = indexes.find(str);
+        if (it != indexes.end()) [[likely]] {
+            return it->second;
+        }
+        auto index = static_cast<uint32_t>(strings.size());
+        const std::u16string &stored = strings.emplace_back(str);
+        indexes.emplace(stored, index);
+        return index;
+    }
+
+    const std::u16string &StringPool::get(uint32_t index) const {
+        if (index >= strings.size()) [[unlikely]] {
+            Profile::push("string index: {}, string pool size: {}", FORMAT_ARG(index), FORMAT_ARG(strings.size()));
+            throw std::runtime_error("string index out of range");
+        }
+        return strings[index];
+    }
+
+    size_t StringPool::size() const {
+        return strings.size();
+    }
+
+    size_t StringPool::getUniqueSize() const {
+        size_t result = 0;
+        for (const auto &item: strings) {
+            result += item.size() * sizeof(char16_t);
+        }
+        return result;
+    }
+
+    size_t StringPool::getReferenceCount() const {
+        return referenceCount;
+    }
+
+    size_t StringPool::getReferenceSize() const {
+        return referenceSize;
+    }
+
+}// namespace CHelper
@@ -0,0 +1,141 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_STRINGPOOL_H
+#define CHELPER_STRINGPOOL_H
+
+#include <pch.h>
+
+namespace CHelper {
+
+    /**
+     * 资源包的字符串池
+     *
+     * 二进制资源包在开头写入所有不重复的字符串，后面的ID和节点通过下标引用字符串，
+     * 相同的字符串只需要存储和解码一次
+     */
+    class StringPool {
+    private:
+        // 使用deque保证添加字符串时已有字符串的地址不变
+        std::deque<std::u16string> strings;
+        std::unordered_map<std::u16string_view, uint32_t> indexes;
+        // 统计数据
+        size_t referenceCount = 0;
+        size_t referenceSize = 0;
+
+    public:
+        // 当前正在读写的二进制资源包的字符串池，为空时字符串直接写在数据中
+        static thread_local StringPool *current;
+
+        /**
+         * 在作用域内切换当前的字符串池，离开作用域时恢复，抛出异常时也会恢复
+         */
+        class Scope {
+        private:
+            StringPool *lastStringPool;
+
+        public:
+            explicit Scope(StringPool *stringPool)
+                : lastStringPool(current) {
+                current = stringPool;
+            }
+
+            Scope(const Scope &) = delete;
+
+            Scope &operator=(const Scope &) = delete;
+
+            ~Scope() {
+                current = lastStringPool;
+            }
+        };
+
+        StringPool() = default;
+
+        StringPool(const StringPool &stringPool);
+
+        StringPool(StringPool &&stringPool) noexcept = default;
+
+        StringPool &operator=(const StringPool &stringPool);
+
+        StringPool &operator=(StringPool &&stringPool) noexcept = default;
+
+        uint32_t intern(std::u16string_view str);
+
+        [[nodiscard]] const std::u16string &get(uint32_t index) const;
+
+        [[nodiscard]] size_t size() const;
+
+        // 所有不重复字符串占用的字节数
+        [[nodiscard]] size_t getUniqueSize() const;
+
+        // 引用字符串池的次数
+        [[nodiscard]] size_t getReferenceCount() const;
+
+        // 如果不使用字符串池，所有字符串占用的字节数
+        [[nodiscard]] size_t getReferenceSize() const;
+
+        template<bool isNeedConvert>
+        static void writeString(std::ostream &ostream, const std::u16string &str) {
+            if (current == nullptr) [[unlikely]] {
+                serialization::Codec<std::u16string>::template to_binary<isNeedConvert>(ostream, str);
+                return;
+            }
+            serialization::Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, current->intern(str));
+        }
+
+        template<bool isNeedConvert>
+        static void writeString(std::ostream &ostream, const std::optional<std::u16string> &str) {
+            if (current == nullptr) [[unlikely]] {
+                serialization::Codec<std::optional<std::u16string>>::template to_binary<isNeedConvert>(ostream, str);
+                return;
+            }
+            serialization::Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, str.has_value() ? current->intern(str.value()) : UINT32_MAX);
+        }
+
+        template<bool isNeedConvert>
+        static void readString(std::istream &istream, std::u16string &str) {
+            if (current == nullptr) [[unlikely]] {
+                serialization::Codec<std::u16string>::template from_binary<isNeedConvert>(istream, str);
+                return;
+            }
+            uint32_t index;
+            serialization::Codec<uint32_t>::template from_binary<isNeedConvert>(istream, index);
+            str = current->get(index);
+        }
+
+        template<bool isNeedConvert>
+        static void readString(std::istream &istream, std::optional<std::u16string> &str) {
+            if (current == nullptr) [[unlikely]] {
+                serialization::Codec<std::optional<std::u16string>>::template from_binary<isNeedConvert>(istream, str);
+                return;
+            }
+            uint32_t index;
+            serialization::Codec<uint32_t>::template from_binary<isNeedConvert>(istream, index);
+            if (index == UINT32_MAX) {
+                str = std::nullopt;
+            } else {
+                str = current->get(index);
+            }
+        }
+    };
+
+}// namespace CHelper
+
+#endif//CHELPER_STRINGPOOL_H
@@ -40,182 +40,104 @@ namespace CHelper {
             nodeBlockStateLeftBracket, nodeBlockStateAllEntry,
             nodeBlockStateSeparator, nodeBlockStateRightBracket);
 
-    Property::Property(const Property &aProperty) noexcept {
-        type = aProperty.type;
-        name = aProperty.name;
-        if (type == PropertyType::STRING) {
-            defaultValue.string = new std::u16string(*aProperty.defaultValue.string);
-            if (aProperty.valid.has_value()) {
-                size_t size = aProperty.valid.value().size();
-                valid = std::vector<PropertyValue>(size);
-                for (size_t i = 0; i < size; ++i) {
-                    valid.value()[i].string = new std::u16string(*aProperty.valid.value()[i].string);
-                }
-            } else {
-                valid = std::nullopt;
-            }
-        } else {
-            defaultValue = aProperty.defaultValue;
-            valid = aProperty.valid;
-        }
-    }
-
-    Property::Property(Property &&aProperty) noexcept {
-        type = aProperty.type;
-        aProperty.type = PropertyType::BOOLEAN;
-        name = std::move(aProperty.name);
-        defaultValue = aProperty.defaultValue;
-        aProperty.defaultValue.boolean = true;
-        valid = std::move(aProperty.valid);
-    }
-
-    Property &Property::operator=(const Property &aProperty) noexcept {
-        type = aProperty.type;
-        name = aProperty.name;
-        if (type == PropertyType::STRING) {
-            defaultValue.string = new std::u16string(*aProperty.defaultValue.string);
-            if (aProperty.valid.has_value()) {
-                size_t size = aProperty.valid.value().size();
-                valid = std::vector<PropertyValue>(size);
-                for (size_t i = 0; i < size; ++i) {
-                    valid.value()[i].string = new std::u16string(*aProperty.valid.value()[i].string);
-                }
-            } else {
-                valid = std::nullopt;
-            }
-        } else {
-            defaultValue = aProperty.defaultValue;
-            valid = aProperty.valid;
-        }
-        return *this;
-    }
-
-    Property &Property::operator=(Property &&aProperty) noexcept {
-        type = aProperty.type;
-        aProperty.type = PropertyType::BOOLEAN;
-        name = std::move(aProperty.name);
-        defaultValue = aProperty.defaultValue;
-        aProperty.defaultValue.boolean = true;
-        valid = std::move(aProperty.valid);
-        return *this;
-    }
-
-    Property::~Property() {
-        if (type == PropertyType::STRING) {
-            delete defaultValue.string;
-            if (valid.has_value()) {
-                for (const auto &item: valid.value()) {
-                    delete item.string;
-                }
-            }
+    BlockPropertyDescriptions::BlockPropertyDescriptions(const BlockPropertyDescriptions &aBlockPropertyDescriptions)
+        : common(aBlockPropertyDescriptions.common),
+          block(aBlockPropertyDescriptions.block) {
+        // 索引引用的是原来的数据，需要重新构建
+        if (aBlockPropertyDescriptions.isIndexed) {
+            buildIndex();
         }
     }
 
-    void Property::release() {
-        if (type == PropertyType::STRING) {
-            delete defaultValue.string;
-            if (valid.has_value()) {
-                for (const auto &item: valid.value()) {
-                    delete item.string;
-                }
-            }
-        }
-        type = PropertyType::BOOLEAN;
-        defaultValue.boolean = true;
-        valid = std::nullopt;
+    BlockPropertyDescriptions::BlockPropertyDescriptions(BlockPropertyDescriptions &&aBlockPropertyDescriptions) noexcept
+        : common(std::move(aBlockPropertyDescriptions.common)),
+          block(std::move(aBlockPropertyDescriptions.block)),
+          isIndexed(aBlockPropertyDescriptions.isIndexed),
+          commonIndex(std::move(aBlockPropertyDescriptions.commonIndex)),
+          blockIndex(std::move(aBlockPropertyDescriptions.blockIndex)) {
+        // 移动vector不会改变元素的地址，索引可以直接移动
+        aBlockPropertyDescriptions.isIndexed = false;
+        aBlockPropertyDescriptions.commonIndex.clear();
+        aBlockPropertyDescriptions.blockIndex.clear();
     }
 
-    BlockPropertyDescription::BlockPropertyDescription(const BlockPropertyDescription &aBlockPropertyDescription) noexcept {
-        type = aBlockPropertyDescription.type;
-        propertyName = aBlockPropertyDescription.propertyName;
-        description = aBlockPropertyDescription.description;
-        if (type == PropertyType::STRING) {
-            size_t size = aBlockPropertyDescription.values.size();
-            values.resize(size);
-            for (size_t i = 0; i < size; ++i) {
-                BlockPropertyValueDescription &t1 = values[i];
-                const BlockPropertyValueDescription &t2 = aBlockPropertyDescription.values[i];
-                t1.valueName.string = new std::u16string(*t2.valueName.string);
-                t1.description = t2.description;
-            }
-        } else {
-            values = aBlockPropertyDescription.values;
+    BlockPropertyDescriptions &BlockPropertyDescriptions::operator=(const BlockPropertyDescriptions &aBlockPropertyDescriptions) {
+        if (this == &aBlockPropertyDescriptions) [[unlikely]] {
+            return *this;
         }
-    }
-
-    BlockPropertyDescription::BlockPropertyDescription(BlockPropertyDescription &&aBlockPropertyDescription) noexcept {
-        type = aBlockPropertyDescription.type;
-        aBlockPropertyDescription.type = PropertyType::BOOLEAN;
-        propertyName = std::move(aBlockPropertyDescription.propertyName);
-        description = std::move(aBlockPropertyDescription.description);
-        values = std::move(aBlockPropertyDescription.values);
-    }
-
-    BlockPropertyDescription &BlockPropertyDescription::operator=(const BlockPropertyDescription &aBlockPropertyDescription) noexcept {
-        type = aBlockPropertyDescription.type;
-        propertyName = aBlockPropertyDescription.propertyName;
-        description = aBlockPropertyDescription.description;
-        if (type == PropertyType::STRING) {
-            size_t size = aBlockPropertyDescription.values.size();
-            values.resize(size);
-            for (size_t i = 0; i < size; ++i) {
-                BlockPropertyValueDescription &t1 = values[i];
-                const BlockPropertyValueDescription &t2 = aBlockPropertyDescription.values[i];
-                t1.valueName.string = new std::u16string(*t2.valueName.string);
-                t1.description = t2.description;
-            }
-        } else {
-            values = aBlockPropertyDescription.values;
+        common = aBlockPropertyDescriptions.common;
+        block = aBlockPropertyDescriptions.block;
+        isIndexed = false;
+        commonIndex.clear();
+        blockIndex.clear();
+        if (aBlockPropertyDescriptions.isIndexed) {
+            buildIndex();
         }
         return *this;
     }
 
-    BlockPropertyDescription &BlockPropertyDescription::operator=(BlockPropertyDescription &&aBlockPropertyDescription) noexcept {
-        type = aBlockPropertyDescription.type;
-        aBlockPropertyDescription.type = PropertyType::BOOLEAN;
-        propertyName = std::move(aBlockPropertyDescription.propertyName);
-        description = std::move(aBlockPropertyDescription.description);
-        values = std::move(aBlockPropertyDescription.values);
+    BlockPropertyDescriptions &BlockPropertyDescriptions::operator=(BlockPropertyDescriptions &&aBlockPropertyDescriptions) noexcept {
+        if (this == &aBlockPropertyDescriptions) [[unlikely]] {
+            return *this;
+        }
+        common = std::move(aBlockPropertyDescriptions.common);
+        block = std::move(aBlockPropertyDescriptions.block);
+        isIndexed = aBlockPropertyDescriptions.isIndexed;
+        commonIndex = std::move(aBlockPropertyDescriptions.commonIndex);
+        blockIndex = std::move(aBlockPropertyDescriptions.blockIndex);
+        aBlockPropertyDescriptions.isIndexed = false;
+        aBlockPropertyDescriptions.commonIndex.clear();
+        aBlockPropertyDescriptions.blockIndex.clear();
         return *this;
     }
 
-    BlockPropertyDescription::~BlockPropertyDescription() {
-        if (type == PropertyType::STRING) {
-            for (const auto &item: values) {
-                delete item.valueName.string;
-            }
+    void BlockPropertyDescriptions::buildIndex() {
+        if (isIndexed) {
+            return;
         }
-    }
-    void BlockPropertyDescription::release() {
-        if (type == PropertyType::STRING) {
-            for (const auto &item: values) {
-                delete item.valueName.string;
+        commonIndex.clear();
+        blockIndex.clear();
+        commonIndex.reserve(common.size());
+        // 和原来线性查找的顺序保持一致，名字重复时保留靠前的
+        for (const auto &item: common) {
+            commonIndex.emplace(item.propertyName, &item);
+        }
+        for (size_t i = 0; i < block.size(); ++i) {
+            for (const auto &blockId: block[i].blocks) {
+                auto &properties = blockIndex[blockId];
+                for (const auto &item: block[i].properties) {
+                    properties.emplace(item.propertyName, PerBlockIndex{i, &item});
+                }
             }
         }
-        type = PropertyType::BOOLEAN;
-        values.clear();
+        isIndexed = true;
     }
 
     const BlockPropertyDescription &BlockPropertyDescriptions::getPropertyDescription(
             const std::u16string &blockIdWithNamespace,
             const std::u16string &blockId,
             const std::u16string &propertyName) const {
-        for (const auto &item: block) {
-            if (std::ranges::find(item.blocks, blockId) != item.blocks.end() ||
-                std::ranges::find(item.blocks, blockIdWithNamespace) != item.blocks.end()) {
-                const auto &it = std::ranges::find_if(item.properties, [&propertyName](const BlockPropertyDescription &item1) -> bool {
-                    return item1.propertyName == propertyName;
-                });
-                if (it != item.properties.end()) [[likely]] {
-                    return *it;
-                }
+        if (!isIndexed) [[unlikely]] {
+            Profile::push("block property descriptions is not indexed");
+            throw std::runtime_error("block property descriptions is not indexed");
+        }
+        const PerBlockIndex *result = nullptr;
+        for (const auto &name: {std::u16string_view(blockId), std::u16string_view(blockIdWithNamespace)}) {
+            auto it = blockIndex.find(name);
+            if (it == blockIndex.end()) [[likely]] {
+                continue;
             }
+            auto it1 = it->second.find(propertyName);
+            if (it1 != it->second.end() && (result == nullptr || it1->second.index < result->index)) {
+                result = &it1->second;
+            }
+        }
+        if (result != nullptr) {
+            return *result->description;
         }
-        const auto &it = std::ranges::find_if(common, [&propertyName](const BlockPropertyDescription &item1) -> bool {
-            return item1.propertyName == propertyName;
-        });
-        if (it != common.end()) [[likely]] {
-            return *it;
+        auto it = commonIndex.find(propertyName);
+        if (it != commonIndex.end()) [[likely]] {
+            return *it->second;
         }
         Profile::push("fail to find block property value by block id {} and property name {}",
                       FORMAT_ARG(utf8::utf16to8(blockIdWithNamespace)),
@@ -224,6 +146,7 @@ namespace CHelper {
     }
 
     Node::NodeText *getBlockStateValueNode(
+            const StringPool &propertyValues,
             const BlockPropertyValueDescription &blockPropertyValueDescription,
             const PropertyType::PropertyType &type,
             const std::optional<std::u16string> &defaultDescription,
@@ -253,7 +176,7 @@ namespace CHelper {
             case PropertyType::STRING:
                 return new Node::NodeText(
                         "BLOCK_STATE_ENTRY_VALUE_STRING", u"方块状态键值对的键（字符串）",
-                        NormalId::make(u'\"' + *blockPropertyValueDescription.valueName.string + u'\"', description));
+                        NormalId::make(u'\"' + propertyValues.get(blockPropertyValueDescription.valueName.string) + u'\"', description));
             case PropertyType::INTEGER:
                 return new Node::NodeText(
                         "BLOCK_STATE_ENTRY_VALUE_INTEGER", u"方块状态键值对的键（整数）",
@@ -272,6 +195,7 @@ namespace CHelper {
 
     Node::NodeEntry *getBlockStateNode(
             std::vector<Node::NodeWithType> &nodeChildren,
+            const StringPool &propertyValues,
             const BlockPropertyDescription &blockPropertyDescription,
             PropertyValue defaultValue,
             const std::optional<std::vector<PropertyValue>> &valid) {
@@ -281,7 +205,7 @@ namespace CHelper {
             bool isDefaultValue;
             switch (blockPropertyDescription.type) {
                 case PropertyType::STRING:
-                    isDefaultValue = *item.valueName.string == *defaultValue.string;
+                    isDefaultValue = item.valueName.string == defaultValue.string;
                     break;
                 case PropertyType::BOOLEAN:
                     isDefaultValue = item.valueName.boolean == defaultValue.boolean;
@@ -298,7 +222,7 @@ namespace CHelper {
                 switch (blockPropertyDescription.type) {
                     case PropertyType::STRING:
                         for (const auto &item1: valid.value()) {
-                            if (*item.valueName.string == *item1.string) {
+                            if (item.valueName.string == item1.string) {
                                 isInvalid = false;
                                 break;
                             }
@@ -327,7 +251,7 @@ namespace CHelper {
                 isInvalid = false;
             }
             Node::NodeText *node = getBlockStateValueNode(
-                    item, blockPropertyDescription.type,
+                    propertyValues, item, blockPropertyDescription.type,
                     blockPropertyDescription.description, isDefaultValue, isInvalid);
             valueNodes.emplace_back(*node);
             nodeChildren.emplace_back(*node);
@@ -343,43 +267,109 @@ namespace CHelper {
         return result;
     }
 
-    const Node::NodeWithType &BlockId::getNode(const BlockPropertyDescriptions &blockPropertyDescriptions) {
-        if (!node.has_value()) {
-            std::vector<Node::NodeWithType> blockStateEntryChildNode2;
-            //已知的方块状态
-            if (properties.has_value()) [[likely]] {
-                blockStateEntryChildNode2.reserve(2);
-                std::vector<Node::NodeWithType> blockStateEntryChildNode1;
-                blockStateEntryChildNode1.reserve(properties.value().size());
-                std::ranges::transform(properties.value(),
-                               std::back_inserter(blockStateEntryChildNode1),
-                               [this, &blockPropertyDescriptions](const auto &item) -> Node::NodeWithType {
-                                   const BlockPropertyDescription &blockPropertyDescription = blockPropertyDescriptions.getPropertyDescription(
-                                           getIdWithNamespace()->name,
-                                           name,
-                                           item.name);
-                                   Node::NodeEntry *result = getBlockStateNode(
-                                           nodeChildren.nodes, blockPropertyDescription,
-                                           item.defaultValue, item.valid);
-                                   nodeChildren.nodes.emplace_back(*result);
-                                   return *result;
-                               });
-                auto nodeChild = new Node::NodeOr(std::move(blockStateEntryChildNode1), false);
-                blockStateEntryChildNode2.emplace_back(*nodeChild);
-                nodeChildren.nodes.emplace_back(*nodeChild);
+    template<class T>
+    static void appendKey(std::string &key, const T &value) {
+        key.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    static void appendKey(std::string &key, PropertyType::PropertyType type, const PropertyValue &value) {
+        switch (type) {
+            case PropertyType::STRING:
+                appendKey(key, value.string);
+                break;
+            case PropertyType::BOOLEAN:
+                appendKey(key, value.boolean);
+                break;
+            case PropertyType::INTEGER:
+                appendKey(key, value.integer);
+                break;
+            default:
+                CHELPER_UNREACHABLE();
+        }
+    }
+
+    static std::mutex nodeMutex;
+
+    BlockId::BlockId(const BlockId &blockId)
+        : NamespaceId(blockId),
+          properties(blockId.properties) {}
+
+    BlockId &BlockId::operator=(const BlockId &blockId) {
+        if (this == &blockId) [[unlikely]] {
+            return *this;
+        }
+        NamespaceId::operator=(blockId);
+        properties = blockId.properties;
+        // 方块状态可能改变，节点重新创建
+        nodeCache = nullptr;
+        node = std::nullopt;
+        isNodeCreated.store(false, std::memory_order_relaxed);
+        return *this;
+    }
+
+    const Node::NodeWithType &BlockId::getNode(const BlockIds &blockIds) {
+        // 节点在第一次使用时生成，同一个资源包可能被多个线程同时使用，生成之后不需要加锁
+        if (!isNodeCreated.load(std::memory_order_acquire)) [[unlikely]] {
+            std::lock_guard<std::mutex> lock(nodeMutex);
+            if (!isNodeCreated.load(std::memory_order_relaxed)) {
+                //方块状态的节点只和方块状态的描述、默认值、有效值有关，这些数据相同的方块共用节点
+                std::vector<const BlockPropertyDescription *> propertyDescriptions;
+                std::string key;
+                appendKey(key, properties.has_value());
+                if (properties.has_value()) [[likely]] {
+                    propertyDescriptions.reserve(properties.value().size());
+                    for (const auto &item: properties.value()) {
+                        const BlockPropertyDescription &blockPropertyDescription = blockIds.blockPropertyDescriptions.getPropertyDescription(
+                                getIdWithNamespace()->name,
+                                name,
+                                item.name);
+                        propertyDescriptions.push_back(&blockPropertyDescription);
+                        appendKey(key, &blockPropertyDescription);
+                        appendKey(key, blockPropertyDescription.type, item.defaultValue);
+                        appendKey(key, item.valid.has_value());
+                        if (item.valid.has_value()) {
+                            appendKey(key, static_cast<uint32_t>(item.valid.value().size()));
+                            for (const auto &item1: item.valid.value()) {
+                                appendKey(key, blockPropertyDescription.type, item1);
+                            }
+                        }
+                    }
+                }
+                nodeCache = blockIds.nodeCache;
+                node = nodeCache->get(key, [this, &blockIds, &propertyDescriptions](std::vector<Node::NodeWithType> &nodeChildren) -> Node::NodeWithType {
+                    std::vector<Node::NodeWithType> blockStateEntryChildNode2;
+                    //已知的方块状态
+                    if (properties.has_value()) [[likely]] {
+                        blockStateEntryChildNode2.reserve(2);
+                        std::vector<Node::NodeWithType> blockStateEntryChildNode1;
+                        blockStateEntryChildNode1.reserve(properties.value().size());
+                        for (size_t i = 0; i < properties.value().size(); ++i) {
+                            const Property &item = properties.value()[i];
+                            Node::NodeEntry *result = getBlockStateNode(
+                                    nodeChildren, blockIds.propertyValues, *propertyDescriptions[i],
+                                    item.defaultValue, item.valid);
+                            nodeChildren.emplace_back(*result);
+                            blockStateEntryChildNode1.emplace_back(*result);
+                        }
+                        auto nodeChild = new Node::NodeOr(std::move(blockStateEntryChildNode1), false);
+                        blockStateEntryChildNode2.emplace_back(*nodeChild);
+                        nodeChildren.emplace_back(*nodeChild);
+                    }
+                    //其他未知的方块状态
+                    blockStateEntryChildNode2.emplace_back(nodeBlockStateAllEntry);
+                    //把所有方块状态拼在一起
+                    auto nodeValue = new Node::NodeOr(std::move(blockStateEntryChildNode2), false, true);
+                    auto result = new Node::NodeList(
+                            nodeBlockStateLeftBracket,
+                            *nodeValue,
+                            nodeBlockStateSeparator,
+                            nodeBlockStateRightBracket);
+                    nodeChildren.emplace_back(*result);
+                    nodeChildren.emplace_back(*nodeValue);
+                    return *result;
+                });
+                isNodeCreated.store(true, std::memory_order_release);
             }
-            //其他未知的方块状态
-            blockStateEntryChildNode2.emplace_back(nodeBlockStateAllEntry);
-            //把所有方块状态拼在一起
-            auto nodeValue = new Node::NodeOr(std::move(blockStateEntryChildNode2), false, true);
-            auto result = new Node::NodeList(
-                    nodeBlockStateLeftBracket,
-                    *nodeValue,
-                    nodeBlockStateSeparator,
-                    nodeBlockStateRightBracket);
-            node = *result;
-            nodeChildren.nodes.emplace_back(*result);
-            nodeChildren.nodes.emplace_back(*nodeValue);
         }
         return node.value();
     }
@@ -388,4 +378,14 @@ namespace CHelper {
         return nodeAllBlockState;
     }
 
+    thread_local StringPool *BlockIds::currentPropertyValues = nullptr;
+
+    StringPool &BlockIds::getCurrentPropertyValues() {
+        if (currentPropertyValues == nullptr) [[unlikely]] {
+            Profile::push("reading or writing block property value without block ids");
+            throw std::runtime_error("no current block property value pool");
+        }
+        return *currentPropertyValues;
+    }
+
 }// namespace CHelper
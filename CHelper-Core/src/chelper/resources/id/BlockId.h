@@ -22,6 +22,9 @@
 #define CHELPER_BLOCKID_H
 
 #include <chelper/node/NodeWithType.h>
+#include <chelper/resources/LegacyBinaryFormat.h>
+#include <chelper/resources/StringPool.h>
+#include <chelper/resources/id/IdNodeCache.h>
 #include <chelper/resources/id/NamespaceId.h>
 #include <pch.h>
 
@@ -36,31 +39,20 @@ namespace CHelper {
     }
 
     union PropertyValue {
-        std::u16string *string;
+        // 字符串在方块ID的字符串池中的下标
+        uint32_t string;
         bool boolean = true;
         int32_t integer;
     };
 
+    static_assert(std::is_trivially_copyable_v<PropertyValue>);
+
     class Property {
     public:
         PropertyType::PropertyType type = PropertyType::BOOLEAN;
         std::u16string name;
         PropertyValue defaultValue;
         std::optional<std::vector<PropertyValue>> valid;
-
-        Property() = default;
-
-        Property(const Property &aProperty) noexcept;
-
-        Property(Property &&aProperty) noexcept;
-
-        Property &operator=(const Property &aProperty) noexcept;
-
-        Property &operator=(Property &&aProperty) noexcept;
-
-        ~Property();
-
-        void release();
     };
 
     class BlockPropertyValueDescription {
@@ -75,20 +67,6 @@ namespace CHelper {
         std::u16string propertyName;
         std::optional<std::u16string> description;
         std::vector<BlockPropertyValueDescription> values;
-
-        BlockPropertyDescription() = default;
-
-        BlockPropertyDescription(const BlockPropertyDescription &aBlockPropertyDescription) noexcept;
-
-        BlockPropertyDescription(BlockPropertyDescription &&aBlockPropertyDescription) noexcept;
-
-        BlockPropertyDescription &operator=(const BlockPropertyDescription &aBlockPropertyDescription) noexcept;
-
-        BlockPropertyDescription &operator=(BlockPropertyDescription &&aBlockPropertyDescription) noexcept;
-
-        ~BlockPropertyDescription();
-
-        void release();
     };
 
     class PerBlockPropertyDescription {
@@ -102,30 +80,102 @@ namespace CHelper {
         std::vector<BlockPropertyDescription> common;
         std::vector<PerBlockPropertyDescription> block;
 
+    private:
+        struct PerBlockIndex {
+            // 在block中的下标，同时匹配多个时取靠前的
+            size_t index;
+            const BlockPropertyDescription *description;
+        };
+
+        //索引引用了common和block里的字符串，复制时重新构建，移动时vector中元素的地址不变，索引直接移动
+        bool isIndexed = false;
+        std::unordered_map<std::u16string_view, const BlockPropertyDescription *> commonIndex;
+        std::unordered_map<std::u16string_view, std::unordered_map<std::u16string_view, PerBlockIndex>> blockIndex;
+
+    public:
+        BlockPropertyDescriptions() = default;
+
+        BlockPropertyDescriptions(const BlockPropertyDescriptions &aBlockPropertyDescriptions);
+
+        BlockPropertyDescriptions(BlockPropertyDescriptions &&aBlockPropertyDescriptions) noexcept;
+
+        BlockPropertyDescriptions &operator=(const BlockPropertyDescriptions &aBlockPropertyDescriptions);
+
+        BlockPropertyDescriptions &operator=(BlockPropertyDescriptions &&aBlockPropertyDescriptions) noexcept;
+
+        /**
+         * 构建方块ID和方块状态名字到方块状态描述的索引，在资源包加载完成后调用
+         */
+        void buildIndex();
+
         [[nodiscard]] const BlockPropertyDescription &getPropertyDescription(
                 const std::u16string &blockIdWithNamespace,
                 const std::u16string &blockId,
                 const std::u16string &propertyName) const;
     };
 
+    class BlockIds;
+
     class BlockId : public NamespaceId {
     public:
         std::optional<std::vector<Property>> properties;
 
     private:
-        Node::FreeableNodeWithTypes nodeChildren;
+        //节点由缓存持有，方块状态相同的方块共用节点
+        std::shared_ptr<IdNodeCache> nodeCache;
         std::optional<Node::NodeWithType> node;
+        // 第一次使用时创建，可能被多个线程同时访问
+        std::atomic<bool> isNodeCreated = false;
 
     public:
-        const Node::NodeWithType &getNode(const BlockPropertyDescriptions &blockPropertyDescriptions);
+        BlockId() = default;
+
+        BlockId(const BlockId &blockId);
+
+        BlockId &operator=(const BlockId &blockId);
+
+        ~BlockId() override = default;
+
+        const Node::NodeWithType &getNode(const BlockIds &blockIds);
 
         static Node::NodeWithType getNodeAllBlockState();
     };
 
     class BlockIds {
     public:
+        //方块状态中字符串类型的值，PropertyValue::string是其中的下标
+        StringPool propertyValues;
         std::shared_ptr<std::vector<std::shared_ptr<BlockId>>> blockStateValues;
         BlockPropertyDescriptions blockPropertyDescriptions;
+        //方块状态的节点缓存
+        std::shared_ptr<IdNodeCache> nodeCache = std::make_shared<IdNodeCache>();
+
+        //当前正在读写json的方块ID的字符串池
+        static thread_local StringPool *currentPropertyValues;
+
+        /**
+         * 在作用域内切换当前的方块状态字符串池，离开作用域时恢复，抛出异常时也会恢复
+         */
+        class PropertyValuesScope {
+        private:
+            StringPool *lastPropertyValues;
+
+        public:
+            explicit PropertyValuesScope(StringPool *propertyValues)
+                : lastPropertyValues(currentPropertyValues) {
+                currentPropertyValues = propertyValues;
+            }
+
+            PropertyValuesScope(const PropertyValuesScope &) = delete;
+
+            PropertyValuesScope &operator=(const PropertyValuesScope &) = delete;
+
+            ~PropertyValuesScope() {
+                currentPropertyValues = lastPropertyValues;
+            }
+        };
+
+        static StringPool &getCurrentPropertyValues();
     };
 
 }// namespace CHelper
@@ -144,7 +194,7 @@ struct serialization::Codec<CHelper::PropertyValue> {
                         const CHelper::PropertyType::PropertyType &propertyType) {
         switch (propertyType) {
             case CHelper::PropertyType::PropertyType::STRING:
-                Codec<std::remove_pointer_t<decltype(t.string)>>::template to_json<JsonValueType>(allocator, jsonValue, *t.string);
+                Codec<std::u16string>::template to_json<JsonValueType>(allocator, jsonValue, CHelper::BlockIds::getCurrentPropertyValues().get(t.string));
                 break;
             case CHelper::PropertyType::PropertyType::BOOLEAN:
                 Codec<decltype(t.boolean)>::template to_json<JsonValueType>(allocator, jsonValue, t.boolean);
@@ -162,8 +212,9 @@ struct serialization::Codec<CHelper::PropertyValue> {
     from_json(const JsonValueType &jsonValue,
               Type &t) {
         if (jsonValue.IsString()) [[likely]] {
-            t.string = new std::u16string();
-            Codec<std::remove_pointer_t<decltype(t.string)>>::template from_json<JsonValueType>(jsonValue, *t.string);
+            std::u16string string;
+            Codec<decltype(string)>::template from_json<JsonValueType>(jsonValue, string);
+            t.string = CHelper::BlockIds::getCurrentPropertyValues().intern(string);
             return CHelper::PropertyType::PropertyType::STRING;
         }
         if (jsonValue.IsBool()) [[likely]] {
@@ -206,7 +257,7 @@ struct serialization::Codec<CHelper::PropertyValue> {
                           const CHelper::PropertyType::PropertyType &propertyType) {
         switch (propertyType) {
             case CHelper::PropertyType::PropertyType::STRING:
-                Codec<std::remove_pointer_t<decltype(t.string)>>::template to_binary<isNeedConvert>(ostream, *t.string);
+                Codec<decltype(t.string)>::template to_binary<isNeedConvert>(ostream, t.string);
                 break;
             case CHelper::PropertyType::PropertyType::BOOLEAN:
                 Codec<decltype(t.boolean)>::template to_binary<isNeedConvert>(ostream, t.boolean);
@@ -225,8 +276,14 @@ struct serialization::Codec<CHelper::PropertyValue> {
                             const CHelper::PropertyType::PropertyType &propertyType) {
         switch (propertyType) {
             case CHelper::PropertyType::PropertyType::STRING:
-                t.string = new std::u16string();
-                Codec<std::remove_pointer_t<decltype(t.string)>>::template from_binary<isNeedConvert>(istream, *t.string);
+                if (CHelper::LegacyBinaryFormat::isReading) [[unlikely]] {
+                    // 旧格式的字符串直接写在数据中
+                    std::u16string string;
+                    Codec<decltype(string)>::template from_binary<isNeedConvert>(istream, string);
+                    t.string = CHelper::BlockIds::getCurrentPropertyValues().intern(string);
+                    break;
+                }
+                Codec<decltype(t.string)>::template from_binary<isNeedConvert>(istream, t.string);
                 break;
             case CHelper::PropertyType::PropertyType::BOOLEAN:
                 Codec<decltype(t.boolean)>::template from_binary<isNeedConvert>(istream, t.boolean);
@@ -277,7 +334,6 @@ struct serialization::Codec<CHelper::Property> : BaseCodec<CHelper::Property> {
         if (!jsonValue.IsObject()) [[unlikely]] {
             throw exceptions::JsonSerializationTypeException("object", getJsonTypeStr(jsonValue.GetType()));
         }
-        t.release();
         Codec<decltype(t.name)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<CHelper::Property, typename JsonValueType::Ch>::name_(), t.name);
         t.type = Codec<decltype(t.defaultValue)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<CHelper::Property, typename JsonValueType::Ch>::defaultValue_(), t.defaultValue);
         const typename JsonValueType::ConstMemberIterator &it = jsonValue.FindMember(details::JsonKey<CHelper::Property, typename JsonValueType::Ch>::valid_());
@@ -293,9 +349,6 @@ struct serialization::Codec<CHelper::Property> : BaseCodec<CHelper::Property> {
                 CHelper::PropertyValue propertyValue;
                 CHelper::PropertyType::PropertyType type = Codec<decltype(propertyValue)>::template from_json<typename JsonValueType::ValueType>(item, propertyValue);
                 if (t.type != type) [[unlikely]] {
-                    if (type == CHelper::PropertyType::PropertyType::STRING) {
-                        delete propertyValue.string;
-                    }
                     throw std::runtime_error("error block state property type");
                 }
                 t.valid.value().push_back(propertyValue);
@@ -326,7 +379,6 @@ struct serialization::Codec<CHelper::Property> : BaseCodec<CHelper::Property> {
     template<bool isNeedConvert>
     static void from_binary(std::istream &istream,
                             Type &t) {
-        t.release();
         Codec<decltype(t.name)>::template from_binary<isNeedConvert>(istream, t.name);
         Codec<decltype(t.type)>::template from_binary<isNeedConvert>(istream, t.type);
 #ifdef CHelperDebug
@@ -388,7 +440,8 @@ struct serialization::Codec<CHelper::BlockPropertyDescription> : BaseCodec<CHelp
         if (!jsonValue.IsObject()) [[unlikely]] {
             throw exceptions::JsonSerializationTypeException("object", getJsonTypeStr(jsonValue.GetType()));
         }
-        t.release();
+        t.type = CHelper::PropertyType::BOOLEAN;
+        t.values.clear();
         Codec<decltype(t.propertyName)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<CHelper::BlockPropertyDescription, typename JsonValueType::Ch>::propertyName_(), t.propertyName);
         Codec<decltype(t.description)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<CHelper::BlockPropertyDescription, typename JsonValueType::Ch>::description_(), t.description);
         bool hasPropertyType = false;
@@ -397,9 +450,6 @@ struct serialization::Codec<CHelper::BlockPropertyDescription> : BaseCodec<CHelp
             CHelper::PropertyType::PropertyType type = Codec<decltype(blockPropertyValueDescription.valueName)>::template from_json_member<typename JsonValueType::ValueType>(item, details::JsonKey<CHelper::BlockPropertyDescription, typename JsonValueType::Ch>::valueName_(), blockPropertyValueDescription.valueName);
             if (hasPropertyType) [[unlikely]] {
                 if (t.type != type) [[likely]] {
-                    if (type == CHelper::PropertyType::STRING) {
-                        delete blockPropertyValueDescription.valueName.string;
-                    }
                     throw std::runtime_error("error block state property type");
                 }
             } else {
@@ -427,7 +477,7 @@ struct serialization::Codec<CHelper::BlockPropertyDescription> : BaseCodec<CHelp
     template<bool isNeedConvert>
     static void from_binary(std::istream &istream,
                             Type &t) {
-        t.release();
+        t.values.clear();
         Codec<decltype(t.propertyName)>::template from_binary<isNeedConvert>(istream, t.propertyName);
         Codec<decltype(t.description)>::template from_binary<isNeedConvert>(istream, t.description);
         Codec<decltype(t.type)>::template from_binary<isNeedConvert>(istream, t.type);
@@ -449,6 +499,70 @@ CODEC(CHelper::BlockPropertyDescriptions, common, block)
 
 CODEC_WITH_PARENT(CHelper::BlockId, CHelper::NamespaceId, properties)
 
-CODEC(CHelper::BlockIds, blockStateValues, blockPropertyDescriptions)
+CODEC_REGISTER_JSON_KEY(CHelper::BlockIds, blockStateValues, blockPropertyDescriptions);
+
+template<>
+struct serialization::Codec<CHelper::BlockIds> : BaseCodec<CHelper::BlockIds> {
+
+    using Type = CHelper::BlockIds;
+
+    constexpr static bool enable = true;
+
+    template<class JsonValueType>
+    static void to_json(typename JsonValueType::AllocatorType &allocator,
+                        JsonValueType &jsonValue,
+                        const Type &t) {
+        CHelper::BlockIds::PropertyValuesScope propertyValuesScope(const_cast<CHelper::StringPool *>(&t.propertyValues));
+        jsonValue.SetObject();
+        Codec<decltype(t.blockStateValues)>::template to_json_member<JsonValueType>(allocator, jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::blockStateValues_(), t.blockStateValues);
+        Codec<decltype(t.blockPropertyDescriptions)>::template to_json_member<JsonValueType>(allocator, jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::blockPropertyDescriptions_(), t.blockPropertyDescriptions);
+    }
+
+    template<class JsonValueType>
+    static void from_json(const JsonValueType &jsonValue,
+                          Type &t) {
+        if (!jsonValue.IsObject()) [[unlikely]] {
+            throw exceptions::JsonSerializationTypeException("object", getJsonTypeStr(jsonValue.GetType()));
+        }
+        t.propertyValues = CHelper::StringPool();
+        CHelper::BlockIds::PropertyValuesScope propertyValuesScope(&t.propertyValues);
+        Codec<decltype(t.blockStateValues)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::blockStateValues_(), t.blockStateValues);
+        Codec<decltype(t.blockPropertyDescriptions)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::blockPropertyDescriptions_(), t.blockPropertyDescriptions);
+    }
+
+    template<bool isNeedConvert>
+    static void to_binary(std::ostream &ostream,
+                          const Type &t) {
+        // 先写入所有字符串，方块状态的值只写下标
+        Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, static_cast<uint32_t>(t.propertyValues.size()));
+        for (size_t i = 0; i < t.propertyValues.size(); ++i) {
+            Codec<std::u16string>::template to_binary<isNeedConvert>(ostream, t.propertyValues.get(static_cast<uint32_t>(i)));
+        }
+        Codec<decltype(t.blockStateValues)>::template to_binary<isNeedConvert>(ostream, t.blockStateValues);
+        Codec<decltype(t.blockPropertyDescriptions)>::template to_binary<isNeedConvert>(ostream, t.blockPropertyDescriptions);
+    }
+
+    template<bool isNeedConvert>
+    static void from_binary(std::istream &istream,
+                            Type &t) {
+        t.propertyValues = CHelper::StringPool();
+        if (CHelper::LegacyBinaryFormat::isReading) [[unlikely]] {
+            // 旧格式没有方块状态的字符串池，读取时再添加到字符串池中
+            CHelper::BlockIds::PropertyValuesScope propertyValuesScope(&t.propertyValues);
+            Codec<decltype(t.blockStateValues)>::template from_binary<isNeedConvert>(istream, t.blockStateValues);
+            Codec<decltype(t.blockPropertyDescriptions)>::template from_binary<isNeedConvert>(istream, t.blockPropertyDescriptions);
+            return;
+        }
+        uint32_t size;
+        Codec<decltype(size)>::template from_binary<isNeedConvert>(istream, size);
+        for (uint32_t i = 0; i < size; ++i) {
+            std::u16string str;
+            Codec<decltype(str)>::template from_binary<isNeedConvert>(istream, str);
+            t.propertyValues.intern(str);
+        }
+        Codec<decltype(t.blockStateValues)>::template from_binary<isNeedConvert>(istream, t.blockStateValues);
+        Codec<decltype(t.blockPropertyDescriptions)>::template from_binary<isNeedConvert>(istream, t.blockPropertyDescriptions);
+    }
+};
 
 #endif//CHELPER_BLOCKID_H
@@ -0,0 +1,66 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/resources/id/IdNodeCache.h>
+
+namespace CHelper {
+
+    Node::NodeWithType IdNodeCache::get(const std::string &key,
+                                        const std::function<Node::NodeWithType(std::vector<Node::NodeWithType> &)> &create) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = cache.find(key);
+        if (it == cache.end()) [[unlikely]] {
+            size_t lastNodeCount = nodes.nodes.size();
+            Node::NodeWithType node = create(nodes.nodes);
+            it = cache.emplace(key, Entry{node, nodes.nodes.size() - lastNodeCount}).first;
+        }
+        requestCount++;
+        requestNodeCount += it->second.nodeCount;
+        return it->second.node;
+    }
+
+    size_t IdNodeCache::getRequestCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return requestCount;
+    }
+
+    size_t IdNodeCache::getEntryCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return cache.size();
+    }
+
+    size_t IdNodeCache::getNodeCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return nodes.nodes.size();
+    }
+
+    size_t IdNodeCache::getRequestNodeCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return requestNodeCount;
+    }
+
+    void IdNodeCache::addMemoryUsage(MemoryUsage::Counter &counter) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        MemoryUsage::addNodes(counter, nodes);
+        counter.bytes += MemoryUsage::getHeapSize(cache);
+        for (const auto &item: cache) {
+            counter.bytes += MemoryUsage::getHeapSize(item.first);
+        }
+    }
+
+}// namespace CHelper
@@ -0,0 +1,86 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_IDNODECACHE_H
+#define CHELPER_IDNODECACHE_H
+
+#include <chelper/node/NodeWithType.h>
+#include <chelper/resources/MemoryUsage.h>
+#include <pch.h>
+
+namespace CHelper {
+
+    /**
+     * ID的节点缓存
+     *
+     * 很多ID生成的节点完全相同，例如方块状态相同的方块、附加值相同的物品，
+     * 所以用生成节点需要的数据作为键，相同的节点只生成一次
+     */
+    class IdNodeCache {
+    private:
+        struct Entry {
+            Node::NodeWithType node;
+            // 生成这个节点时创建的节点数量
+            size_t nodeCount;
+        };
+
+        // 同一个资源包可能被多个线程同时使用
+        mutable std::mutex mutex;
+        Node::FreeableNodeWithTypes nodes;
+        std::unordered_map<std::string, Entry> cache;
+        // 统计数据
+        size_t requestCount = 0;
+        size_t requestNodeCount = 0;
+
+    public:
+        IdNodeCache() = default;
+
+        IdNodeCache(const IdNodeCache &) = delete;
+
+        IdNodeCache &operator=(const IdNodeCache &) = delete;
+
+        /**
+         * 获取缓存的节点，如果没有就生成一个
+         *
+         * @param key 生成节点需要的所有数据
+         * @param create 生成节点，创建的所有节点都要添加到参数中，由缓存负责释放
+         */
+        Node::NodeWithType get(const std::string &key,
+                               const std::function<Node::NodeWithType(std::vector<Node::NodeWithType> &)> &create);
+
+        // 获取节点的次数
+        [[nodiscard]] size_t getRequestCount() const;
+
+        // 实际生成的节点的种类
+        [[nodiscard]] size_t getEntryCount() const;
+
+        // 实际创建的节点数量
+        [[nodiscard]] size_t getNodeCount() const;
+
+        // 如果不使用缓存，需要创建的节点数量
+        [[nodiscard]] size_t getRequestNodeCount() const;
+
+        // 统计缓存的节点和键占用的内存
+        void addMemoryUsage(MemoryUsage::Counter &counter) const;
+    };
+
+}// namespace CHelper
+
+#endif//CHELPER_IDNODECACHE_H
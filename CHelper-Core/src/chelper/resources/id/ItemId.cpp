@@ -21,33 +21,61 @@
 
 namespace CHelper {
 
-    const Node::NodeWithType &ItemId::getNode() {
-        if (node == nullptr) [[unlikely]] {
-            if (max.has_value() && max.value() < 0) [[unlikely]] {
-                throw std::runtime_error("item id max data value should be a positive number");
-            }
-            auto nodeAllData = new Node::NodeInteger("ITEM_DATA", u"物品附加值", -1, max);
-            nodeChildren.nodes.emplace_back(*nodeAllData);
-            if (!descriptions.has_value()) [[unlikely]] {
-                node = std::make_unique<Node::NodeWithType>(*nodeAllData);
-            } else {
-                std::vector<Node::NodeWithType> nodeDataChildren;
-                nodeDataChildren.reserve(descriptions.value().size());
-                size_t i = 0;
-                for (const auto &item: descriptions.value()) {
-                    auto nodeChild = new Node::NodeText(
-                            "ITEM_PER_DATA", item,
-                            NormalId::make(utf8::utf8to16(std::to_string(i++)), item),
-                            [](const Node::NodeWithType &node1, TokenReader &tokenReader) -> ASTNode {
-                                return tokenReader.readIntegerASTNode(node1);
-                            });
-                    nodeDataChildren.emplace_back(*nodeChild);
-                    nodeChildren.nodes.emplace_back(*nodeChild);
+    template<class T>
+    static void appendKey(std::string &key, const T &value) {
+        key.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    static std::mutex nodeMutex;
+
+    const Node::NodeWithType &ItemId::getNode(const std::shared_ptr<IdNodeCache> &cache) {
+        // 节点在第一次使用时生成，同一个资源包可能被多个线程同时使用，生成之后不需要加锁
+        if (!isNodeCreated.load(std::memory_order_acquire)) [[unlikely]] {
+            std::lock_guard<std::mutex> lock(nodeMutex);
+            if (!isNodeCreated.load(std::memory_order_relaxed)) {
+                if (max.has_value() && max.value() < 0) [[unlikely]] {
+                    throw std::runtime_error("item id max data value should be a positive number");
+                }
+                //物品附加值的节点只和最大值、附加值的描述有关，这些数据相同的物品共用节点
+                std::string key;
+                appendKey(key, max.has_value());
+                if (max.has_value()) {
+                    appendKey(key, max.value());
+                }
+                appendKey(key, descriptions.has_value());
+                if (descriptions.has_value()) {
+                    appendKey(key, static_cast<uint32_t>(descriptions.value().size()));
+                    for (const auto &item: descriptions.value()) {
+                        appendKey(key, static_cast<uint32_t>(item.size()));
+                        key.append(reinterpret_cast<const char *>(item.data()), item.size() * sizeof(char16_t));
+                    }
                 }
-                nodeDataChildren.emplace_back(*nodeAllData);
-                auto nodeOr = new Node::NodeOr(std::move(nodeDataChildren), false);
-                nodeChildren.nodes.emplace_back(*nodeOr);
-                node = std::make_unique<Node::NodeWithType>(*nodeOr);
+                nodeCache = cache;
+                node = std::make_unique<Node::NodeWithType>(nodeCache->get(key, [this](std::vector<Node::NodeWithType> &nodeChildren) -> Node::NodeWithType {
+                    auto nodeAllData = new Node::NodeInteger("ITEM_DATA", u"物品附加值", -1, max);
+                    nodeChildren.emplace_back(*nodeAllData);
+                    if (!descriptions.has_value()) [[unlikely]] {
+                        return *nodeAllData;
+                    }
+                    std::vector<Node::NodeWithType> nodeDataChildren;
+                    nodeDataChildren.reserve(descriptions.value().size());
+                    size_t i = 0;
+                    for (const auto &item: descriptions.value()) {
+                        auto nodeChild = new Node::NodeText(
+                                "ITEM_PER_DATA", item,
+                                NormalId::make(utf8::utf8to16(std::to_string(i++)), item),
+                                [](const Node::NodeWithType &node1, TokenReader &tokenReader) -> ASTNode {
+                                    return tokenReader.readIntegerASTNode(node1);
+                                });
+                        nodeDataChildren.emplace_back(*nodeChild);
+                        nodeChildren.emplace_back(*nodeChild);
+                    }
+                    nodeDataChildren.emplace_back(*nodeAllData);
+                    auto nodeOr = new Node::NodeOr(std::move(nodeDataChildren), false);
+                    nodeChildren.emplace_back(*nodeOr);
+                    return *nodeOr;
+                }));
+                isNodeCreated.store(true, std::memory_order_release);
             }
         }
         return *node;
@@ -22,6 +22,7 @@
 #define CHELPER_ITEMID_H
 
 #include <chelper/node/NodeWithType.h>
+#include <chelper/resources/id/IdNodeCache.h>
 #include <chelper/resources/id/NamespaceId.h>
 #include <pch.h>
 
@@ -33,13 +34,16 @@ namespace CHelper {
         std::optional<std::vector<std::u16string>> descriptions;
 
     private:
-        Node::FreeableNodeWithTypes nodeChildren;
+        //节点由缓存持有，附加值相同的物品共用节点
+        std::shared_ptr<IdNodeCache> nodeCache;
         std::unique_ptr<Node::NodeWithType> node;
+        // 第一次使用时创建，可能被多个线程同时访问
+        std::atomic<bool> isNodeCreated = false;
 
     public:
         ItemId() = default;
 
-        const Node::NodeWithType &getNode();
+        const Node::NodeWithType &getNode(const std::shared_ptr<IdNodeCache> &cache);
     };
 
 }// namespace CHelper
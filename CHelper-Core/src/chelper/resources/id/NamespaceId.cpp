@@ -20,15 +20,62 @@
 
 namespace CHelper {
 
-    std::shared_ptr<NormalId> &NamespaceId::getIdWithNamespace() {
-        if (idWithNamespace == nullptr) [[unlikely]] {
-            idWithNamespace = NormalId::make(
-                    idNamespace.value_or(u"minecraft")
-                            .append(u":")
-                            .append(name),
-                    description);
+    NamespaceId::NamespaceId(const NamespaceId &namespaceId)
+        : NormalId(namespaceId),
+          idNamespace(namespaceId.idNamespace),
+          idWithNamespaceHash(namespaceId.idWithNamespaceHash.load(std::memory_order_relaxed)) {}
+
+    NamespaceId &NamespaceId::operator=(const NamespaceId &namespaceId) {
+        if (this == &namespaceId) [[unlikely]] {
+            return *this;
+        }
+        NormalId::operator=(namespaceId);
+        idNamespace = namespaceId.idNamespace;
+        // 名字可能改变，带命名空间的ID重新创建
+        idWithNamespace = nullptr;
+        isIdWithNamespaceCreated.store(false, std::memory_order_relaxed);
+        idWithNamespaceHash.store(namespaceId.idWithNamespaceHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    const std::shared_ptr<NormalId> &NamespaceId::getIdWithNamespace() {
+        if (!isIdWithNamespaceCreated.load(std::memory_order_acquire)) [[unlikely]] {
+            static std::mutex mutex;
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!isIdWithNamespaceCreated.load(std::memory_order_relaxed)) {
+                idWithNamespace = NormalId::make(
+                        idNamespace.value_or(u"minecraft")
+                                .append(u":")
+                                .append(name),
+                        description);
+                isIdWithNamespaceCreated.store(true, std::memory_order_release);
+            }
         }
         return idWithNamespace;
     }
 
+    XXH64_hash_t NamespaceId::getIdWithNamespaceHash() {
+        XXH64_hash_t result = idWithNamespaceHash.load(std::memory_order_relaxed);
+        if (result == 0) [[unlikely]] {
+            static constexpr char16_t separator = u':';
+            const std::u16string &namespaceStr = idNamespace.has_value() ? idNamespace.value() : u"minecraft";
+            XXH3_state_t state{};
+            XXH3_64bits_reset(&state);
+            XXH3_64bits_update(&state, namespaceStr.data(), namespaceStr.size() * sizeof(char16_t));
+            XXH3_64bits_update(&state, &separator, sizeof(char16_t));
+            XXH3_64bits_update(&state, name.data(), name.size() * sizeof(char16_t));
+            result = XXH3_64bits_digest(&state);
+            idWithNamespaceHash.store(result, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    void NamespaceId::setIdWithNamespaceHash(XXH64_hash_t hash) {
+        idWithNamespaceHash.store(hash, std::memory_order_relaxed);
+    }
+
+    bool NamespaceId::fastMatchWithNamespace(XXH64_hash_t strHash) {
+        return getIdWithNamespaceHash() == strHash;
+    }
+
 }// namespace CHelper
\ No newline at end of file
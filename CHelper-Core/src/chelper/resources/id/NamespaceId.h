@@ -31,10 +31,30 @@ namespace CHelper {
         std::optional<std::u16string> idNamespace;
 
     private:
+        // 第一次使用时创建，可能被多个线程同时访问
         std::shared_ptr<NormalId> idWithNamespace;
+        std::atomic<bool> isIdWithNamespaceCreated = false;
+        // 0表示还没有计算
+        std::atomic<XXH64_hash_t> idWithNamespaceHash = 0;
 
     public:
-        std::shared_ptr<NormalId> &getIdWithNamespace();
+        NamespaceId() = default;
+
+        NamespaceId(const NamespaceId &namespaceId);
+
+        NamespaceId &operator=(const NamespaceId &namespaceId);
+
+        ~NamespaceId() override = default;
+
+        const std::shared_ptr<NormalId> &getIdWithNamespace();
+
+        [[nodiscard]] XXH64_hash_t getIdWithNamespaceHash();
+
+        //使用资源包快照中预先计算好的带命名空间的名字哈希值
+        void setIdWithNamespaceHash(XXH64_hash_t hash);
+
+        //和getIdWithNamespace()->fastMatch(strHash)一样，但是不需要创建带命名空间的ID
+        [[nodiscard]] bool fastMatchWithNamespace(XXH64_hash_t strHash);
     };
 
 }// namespace CHelper
@@ -20,26 +20,51 @@
 
 namespace CHelper {
 
-    void NormalId::buildHash() {
-        if (!hashState.has_value()) {
-            hashState = std::make_optional<XXH3_state_t>();
-            XXH3_64bits_reset(&hashState.value());
-            XXH3_64bits_update(&hashState.value(), name.data(), name.size() * sizeof(decltype(name)::value_type));
-            nameHash = XXH3_64bits_digest(&hashState.value());
-            if (description.has_value()) {
-                XXH3_64bits_update(&hashState.value(), description.value().data(), description.value().size() * sizeof(decltype(description)::value_type::value_type));
-            }
+    NormalId::NormalId(const NormalId &normalId)
+        : name(normalId.name),
+          description(normalId.description),
+          nameHash(normalId.nameHash.load(std::memory_order_relaxed)),
+          contentHash(normalId.contentHash.load(std::memory_order_relaxed)) {}
+
+    NormalId &NormalId::operator=(const NormalId &normalId) {
+        name = normalId.name;
+        description = normalId.description;
+        nameHash.store(normalId.nameHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        contentHash.store(normalId.contentHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    [[nodiscard]] XXH64_hash_t NormalId::getNameHash() {
+        // 哈希值只由名字决定，多个线程同时计算得到的结果相同
+        XXH64_hash_t result = nameHash.load(std::memory_order_relaxed);
+        if (result == 0) [[unlikely]] {
+            result = XXH3_64bits(name.data(), name.size() * sizeof(decltype(name)::value_type));
+            nameHash.store(result, std::memory_order_relaxed);
         }
+        return result;
+    }
+
+    void NormalId::setNameHash(XXH64_hash_t hash) {
+        nameHash.store(hash, std::memory_order_relaxed);
     }
 
     [[nodiscard]] bool NormalId::fastMatch(XXH64_hash_t strHash) {
-        buildHash();
-        return nameHash == strHash;
+        return getNameHash() == strHash;
     }
 
-    [[nodiscard]] XXH3_state_t *NormalId::getHashState() {
-        buildHash();
-        return &hashState.value();
+    [[nodiscard]] XXH64_hash_t NormalId::getContentHash() {
+        XXH64_hash_t result = contentHash.load(std::memory_order_relaxed);
+        if (result == 0) [[unlikely]] {
+            XXH3_state_t state{};
+            XXH3_64bits_reset(&state);
+            XXH3_64bits_update(&state, name.data(), name.size() * sizeof(decltype(name)::value_type));
+            if (description.has_value()) {
+                XXH3_64bits_update(&state, description.value().data(), description.value().size() * sizeof(decltype(description)::value_type::value_type));
+            }
+            result = XXH3_64bits_digest(&state);
+            contentHash.store(result, std::memory_order_relaxed);
+        }
+        return result;
     }
 
     std::shared_ptr<NormalId> NormalId::make(const std::u16string &name, const std::optional<std::u16string> &description) {
@@ -21,6 +21,7 @@
 #ifndef CHELPER_NORMALID_H
 #define CHELPER_NORMALID_H
 
+#include <chelper/resources/StringPool.h>
 #include <pch.h>
 
 namespace CHelper {
@@ -31,25 +32,75 @@ namespace CHelper {
         std::optional<std::u16string> description;
 
     private:
-        XXH64_hash_t nameHash = 0;
-        std::optional<XXH3_state_t> hashState;
+        // 哈希值在第一次使用时计算，可能被多个线程同时计算，0表示还没有计算
+        std::atomic<XXH64_hash_t> nameHash = 0;
+        std::atomic<XXH64_hash_t> contentHash = 0;
 
     public:
         NormalId() = default;
 
+        NormalId(const NormalId &normalId);
+
+        NormalId &operator=(const NormalId &normalId);
+
         virtual ~NormalId() = default;
 
-        void buildHash();
+        [[nodiscard]] XXH64_hash_t getNameHash();
+
+        //使用资源包快照中预先计算好的名字哈希值
+        void setNameHash(XXH64_hash_t hash);
 
         [[nodiscard]] bool fastMatch(XXH64_hash_t strHash);
 
-        [[nodiscard]] XXH3_state_t *getHashState();
+        //名字和介绍的哈希值
+        [[nodiscard]] XXH64_hash_t getContentHash();
 
         static std::shared_ptr<NormalId> make(const std::u16string &name, const std::optional<std::u16string> &description);
     };
 
 }// namespace CHelper
 
-CODEC(CHelper::NormalId, name, description)
+CODEC_REGISTER_JSON_KEY(CHelper::NormalId, name, description);
+
+template<>
+struct serialization::Codec<CHelper::NormalId> : BaseCodec<CHelper::NormalId> {
+
+    using Type = CHelper::NormalId;
+
+    constexpr static bool enable = true;
+
+    template<class JsonValueType>
+    static void to_json(typename JsonValueType::AllocatorType &allocator,
+                        JsonValueType &jsonValue,
+                        const Type &t) {
+        jsonValue.SetObject();
+        Codec<decltype(t.name)>::template to_json_member<JsonValueType>(allocator, jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::name_(), t.name);
+        Codec<decltype(t.description)>::template to_json_member<JsonValueType>(allocator, jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::description_(), t.description);
+    }
+
+    template<class JsonValueType>
+    static void from_json(const JsonValueType &jsonValue,
+                          Type &t) {
+        if (!jsonValue.IsObject()) [[unlikely]] {
+            throw exceptions::JsonSerializationTypeException("object", getJsonTypeStr(jsonValue.GetType()));
+        }
+        Codec<decltype(t.name)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::name_(), t.name);
+        Codec<decltype(t.description)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::description_(), t.description);
+    }
+
+    template<bool isNeedConvert>
+    static void to_binary(std::ostream &ostream,
+                          const Type &t) {
+        CHelper::StringPool::writeString<isNeedConvert>(ostream, t.name);
+        CHelper::StringPool::writeString<isNeedConvert>(ostream, t.description);
+    }
+
+    template<bool isNeedConvert>
+    static void from_binary(std::istream &istream,
+                            Type &t) {
+        CHelper::StringPool::readString<isNeedConvert>(istream, t.name);
+        CHelper::StringPool::readString<isNeedConvert>(istream, t.description);
+    }
+};// namespace serialization
 
 #endif//CHELPER_NORMALID_H
@@ -0,0 +1,574 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/serialization/IdJsonReader.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/istreamwrapper.h>
+
+namespace CHelper {
+
+    static std::u16string toU16String(const char *str, rapidjson::SizeType length) {
+        std::u16string result;
+        result.reserve(length);
+        utf8::utf8to16(str, str + length, std::back_inserter(result));
+        return result;
+    }
+
+    static PropertyType::PropertyType getPropertyType(const IdJsonReader::PropertyScalar &value) {
+        switch (value.index()) {
+            case 0:
+                return PropertyType::BOOLEAN;
+            case 1:
+                return PropertyType::INTEGER;
+            case 2:
+                return PropertyType::STRING;
+            default:
+                CHELPER_UNREACHABLE();
+        }
+    }
+
+    static void toPropertyValue(StringPool &propertyValues, const IdJsonReader::PropertyScalar &value, PropertyValue &result) {
+        switch (value.index()) {
+            case 0:
+                result.boolean = std::get<0>(value);
+                break;
+            case 1:
+                result.integer = std::get<1>(value);
+                break;
+            case 2:
+                result.string = propertyValues.intern(std::get<2>(value));
+                break;
+            default:
+                CHELPER_UNREACHABLE();
+        }
+    }
+
+    static std::u16string &&requireString(const std::string &key, IdJsonReader::PropertyScalar &value) {
+        if (value.index() != 2) [[unlikely]] {
+            Profile::push(R"(json type of "{}" should be string)", FORMAT_ARG(key));
+            throw std::runtime_error("error json type");
+        }
+        return std::move(std::get<2>(value));
+    }
+
+    static int32_t requireInteger(const std::string &key, const IdJsonReader::PropertyScalar &value) {
+        if (value.index() != 1) [[unlikely]] {
+            Profile::push(R"(json type of "{}" should be integer)", FORMAT_ARG(key));
+            throw std::runtime_error("error json type");
+        }
+        return std::get<1>(value);
+    }
+
+    [[noreturn]] static void throwMissingMember(const char *key) {
+        Profile::push(R"(fail to find member "{}")", FORMAT_ARG(key));
+        throw std::runtime_error("fail to find member");
+    }
+
+    bool IdJsonReader::Null() {
+        if (skipDepth > 0 || std::exchange(isSkipValue, false)) [[unlikely]] {
+            return true;
+        }
+        switch (frames.back()) {
+            case Frame::ROOT:
+            case Frame::ID:
+            case Frame::BLOCK_IDS:
+            case Frame::BLOCK_PROPERTY:
+            case Frame::PROPERTY_DESCRIPTIONS:
+            case Frame::PROPERTY_DESCRIPTION:
+            case Frame::PROPERTY_DESCRIPTION_VALUE:
+            case Frame::PER_BLOCK:
+                // 可选的值为null时和不存在一样，必须的值在对象结束时检查
+                return true;
+            default:
+                Profile::push("null is not allowed in array");
+                throw std::runtime_error("error json type");
+        }
+    }
+
+    bool IdJsonReader::Bool(bool b) {
+        return onScalar(PropertyScalar(std::in_place_index<0>, b));
+    }
+
+    bool IdJsonReader::Int(int i) {
+        return onScalar(PropertyScalar(std::in_place_index<1>, static_cast<int32_t>(i)));
+    }
+
+    bool IdJsonReader::Uint(unsigned i) {
+        if (i > static_cast<unsigned>(std::numeric_limits<int32_t>::max())) [[unlikely]] {
+            return Uint64(i);
+        }
+        return onScalar(PropertyScalar(std::in_place_index<1>, static_cast<int32_t>(i)));
+    }
+
+    bool IdJsonReader::Int64(int64_t i) {
+        if (skipDepth > 0 || std::exchange(isSkipValue, false)) [[likely]] {
+            return true;
+        }
+        Profile::push(R"(number of "{}" is out of int32 range: {})", FORMAT_ARG(key), i);
+        throw std::runtime_error("number out of range");
+    }
+
+    bool IdJsonReader::Uint64(uint64_t i) {
+        if (skipDepth > 0 || std::exchange(isSkipValue, false)) [[likely]] {
+            return true;
+        }
+        Profile::push(R"(number of "{}" is out of int32 range: {})", FORMAT_ARG(key), i);
+        throw std::runtime_error("number out of range");
+    }
+
+    bool IdJsonReader::Double(double d) {
+        if (skipDepth > 0 || std::exchange(isSkipValue, false)) [[likely]] {
+            return true;
+        }
+        Profile::push(R"(json type of "{}" should not be float: {})", FORMAT_ARG(key), d);
+        throw std::runtime_error("error json type");
+    }
+
+    bool IdJsonReader::String(const char *str, rapidjson::SizeType length, bool copy) {
+        if (skipDepth > 0 || isSkipValue) [[unlikely]] {
+            isSkipValue = false;
+            return true;
+        }
+        if (frames.back() == Frame::ROOT) [[unlikely]] {
+            std::string_view value(str, length);
+            if (key == "id") {
+                id = value;
+                hasId = true;
+                return true;
+            }
+            if (key == "type") {
+                if (value == "normal") [[likely]] {
+                    type = IdType::NORMAL;
+                } else if (value == "namespace") [[likely]] {
+                    type = IdType::NAMESPACE;
+                } else if (value == "block") [[likely]] {
+                    type = IdType::BLOCK;
+                } else if (value == "item") [[likely]] {
+                    type = IdType::ITEM;
+                } else {
+                    Profile::push("unknown id type -> {}", FORMAT_ARG(value));
+                    throw std::runtime_error("unknown id type");
+                }
+                return true;
+            }
+        }
+        return onScalar(PropertyScalar(std::in_place_index<2>, toU16String(str, length)));
+    }
+
+    bool IdJsonReader::StartObject() {
+        return onStart(true);
+    }
+
+    bool IdJsonReader::Key(const char *str, rapidjson::SizeType length, bool copy) {
+        if (skipDepth > 0) [[unlikely]] {
+            return true;
+        }
+        key.assign(str, length);
+        // 和Codec一样，忽略不认识的键
+        switch (frames.back()) {
+            case Frame::ROOT:
+                isSkipValue = key != "id" && key != "type" && key != "content";
+                break;
+            case Frame::ID:
+                isSkipValue = key != "name" && key != "description" &&
+                              (type == IdType::NORMAL || key != "idNamespace") &&
+                              (type != IdType::ITEM || (key != "max" && key != "descriptions")) &&
+                              (type != IdType::BLOCK || key != "properties");
+                break;
+            case Frame::BLOCK_IDS:
+                isSkipValue = key != "blockStateValues" && key != "blockPropertyDescriptions";
+                break;
+            case Frame::BLOCK_PROPERTY:
+                isSkipValue = key != "name" && key != "defaultValue" && key != "valid";
+                break;
+            case Frame::PROPERTY_DESCRIPTIONS:
+                isSkipValue = key != "common" && key != "block";
+                break;
+            case Frame::PROPERTY_DESCRIPTION:
+                isSkipValue = key != "propertyName" && key != "description" && key != "values";
+                break;
+            case Frame::PROPERTY_DESCRIPTION_VALUE:
+                isSkipValue = key != "valueName" && key != "description";
+                break;
+            case Frame::PER_BLOCK:
+                isSkipValue = key != "blocks" && key != "properties";
+                break;
+            default:
+                CHELPER_UNREACHABLE();
+        }
+        return true;
+    }
+
+    bool IdJsonReader::EndObject(rapidjson::SizeType memberCount) {
+        onEnd();
+        return true;
+    }
+
+    bool IdJsonReader::StartArray() {
+        return onStart(false);
+    }
+
+    bool IdJsonReader::EndArray(rapidjson::SizeType elementCount) {
+        onEnd();
+        return true;
+    }
+
+    bool IdJsonReader::read(std::istream &istream) {
+        // 缓冲区放在堆上，安卓和emscripten的线程栈比较小
+        std::vector<char> buffer(65536);
+        rapidjson::IStreamWrapper streamWrapper(istream, buffer.data(), buffer.size());
+        rapidjson::Reader reader;
+        rapidjson::ParseResult result = reader.Parse(streamWrapper, *this);
+        if (isNeedFallback) [[unlikely]] {
+            return false;
+        }
+        if (result.IsError()) [[unlikely]] {
+            Profile::push("fail to parse id json at offset {}: {}",
+                          result.Offset(), FORMAT_ARG(rapidjson::GetParseError_En(result.Code())));
+            throw std::runtime_error("fail to parse id json");
+        }
+        if (type == IdType::UNKNOWN) [[unlikely]] {
+            throwMissingMember("type");
+        }
+        if (!hasContent) [[unlikely]] {
+            throwMissingMember("content");
+        }
+        if (!hasId && (type == IdType::NORMAL || type == IdType::NAMESPACE)) [[unlikely]] {
+            throwMissingMember("id");
+        }
+        return true;
+    }
+
+    bool IdJsonReader::onScalar(PropertyScalar &&value) {
+        if (skipDepth > 0 || std::exchange(isSkipValue, false)) [[unlikely]] {
+            return true;
+        }
+        switch (frames.back()) {
+            case Frame::ID:
+                if (key == "name") {
+                    currentId->name = requireString(key, value);
+                    hasIdName = true;
+                } else if (key == "description") {
+                    currentId->description = requireString(key, value);
+                } else if (key == "idNamespace") {
+                    static_cast<NamespaceId *>(currentId)->idNamespace = requireString(key, value);
+                } else if (key == "max") {
+                    currentItemId->max = requireInteger(key, value);
+                } else {
+                    break;
+                }
+                return true;
+            case Frame::ITEM_DESCRIPTIONS:
+                currentItemId->descriptions->push_back(requireString("descriptions", value));
+                return true;
+            case Frame::BLOCK_PROPERTY:
+                if (key == "name") {
+                    propertyName = requireString(key, value);
+                    hasPropertyName = true;
+                } else if (key == "defaultValue") {
+                    propertyDefaultValue = std::move(value);
+                } else {
+                    break;
+                }
+                return true;
+            case Frame::BLOCK_PROPERTY_VALID:
+                propertyValid->push_back(std::move(value));
+                return true;
+            case Frame::PROPERTY_DESCRIPTION:
+                if (key == "propertyName") {
+                    propertyName = requireString(key, value);
+                    hasPropertyName = true;
+                } else if (key == "description") {
+                    propertyDescription = requireString(key, value);
+                } else {
+                    break;
+                }
+                return true;
+            case Frame::PROPERTY_DESCRIPTION_VALUE:
+                if (key == "valueName") {
+                    valueName = std::move(value);
+                } else if (key == "description") {
+                    valueDescription = requireString(key, value);
+                } else {
+                    break;
+                }
+                return true;
+            case Frame::PER_BLOCK_BLOCKS:
+                currentPerBlock->blocks.push_back(requireString("blocks", value));
+                return true;
+            default:
+                break;
+        }
+        Profile::push(R"(unexpected json value, key: "{}")", FORMAT_ARG(key));
+        throw std::runtime_error("error json type");
+    }
+
+    bool IdJsonReader::onStart(bool isObject) {
+        if (skipDepth > 0) [[unlikely]] {
+            ++skipDepth;
+            return true;
+        }
+        if (std::exchange(isSkipValue, false)) [[unlikely]] {
+            skipDepth = 1;
+            return true;
+        }
+        if (frames.empty()) [[unlikely]] {
+            if (!isObject) [[unlikely]] {
+                Profile::push("id json should be an object");
+                throw std::runtime_error("error json type");
+            }
+            frames.push_back(Frame::ROOT);
+            return true;
+        }
+        Frame next;
+        bool isNextObject;
+        switch (frames.back()) {
+            case Frame::ROOT:
+                if (key != "content") [[unlikely]] {
+                    isNextObject = !isObject;
+                    next = Frame::ROOT;
+                    break;
+                }
+                hasContent = true;
+                switch (type) {
+                    case IdType::UNKNOWN:
+                        isNeedFallback = true;
+                        return false;
+                    case IdType::NORMAL:
+                        normalIds = std::make_shared<std::vector<std::shared_ptr<NormalId>>>();
+                        next = Frame::ID_LIST;
+                        isNextObject = false;
+                        break;
+                    case IdType::NAMESPACE:
+                        namespaceIds = std::make_shared<std::vector<std::shared_ptr<NamespaceId>>>();
+                        next = Frame::ID_LIST;
+                        isNextObject = false;
+                        break;
+                    case IdType::ITEM:
+                        itemIds = std::make_shared<std::vector<std::shared_ptr<ItemId>>>();
+                        next = Frame::ID_LIST;
+                        isNextObject = false;
+                        break;
+                    case IdType::BLOCK:
+                        blockIds = std::make_shared<BlockIds>();
+                        blockIds->blockStateValues = std::make_shared<std::vector<std::shared_ptr<BlockId>>>();
+                        next = Frame::BLOCK_IDS;
+                        isNextObject = true;
+                        break;
+                    default:
+                        CHELPER_UNREACHABLE();
+                }
+                break;
+            case Frame::ID_LIST:
+                switch (type) {
+                    case IdType::NORMAL:
+                        currentId = normalIds->emplace_back(std::make_shared<NormalId>()).get();
+                        break;
+                    case IdType::NAMESPACE:
+                        currentId = namespaceIds->emplace_back(std::make_shared<NamespaceId>()).get();
+                        break;
+                    case IdType::ITEM:
+                        currentItemId = itemIds->emplace_back(std::make_shared<ItemId>()).get();
+                        currentId = currentItemId;
+                        break;
+                    case IdType::BLOCK:
+                        currentBlockId = blockIds->blockStateValues->emplace_back(std::make_shared<BlockId>()).get();
+                        currentId = currentBlockId;
+                        break;
+                    default:
+                        CHELPER_UNREACHABLE();
+                }
+                hasIdName = false;
+                next = Frame::ID;
+                isNextObject = true;
+                break;
+            case Frame::ID:
+                if (key == "descriptions") {
+                    currentItemId->descriptions.emplace();
+                    next = Frame::ITEM_DESCRIPTIONS;
+                } else if (key == "properties") {
+                    currentBlockId->properties.emplace();
+                    next = Frame::BLOCK_PROPERTY_LIST;
+                } else {
+                    next = Frame::ID;
+                    isNextObject = !isObject;
+                    break;
+                }
+                isNextObject = false;
+                break;
+            case Frame::BLOCK_IDS:
+                if (key == "blockStateValues") {
+                    next = Frame::ID_LIST;
+                    isNextObject = false;
+                } else {
+                    next = Frame::PROPERTY_DESCRIPTIONS;
+                    isNextObject = true;
+                }
+                break;
+            case Frame::BLOCK_PROPERTY_LIST:
+                hasPropertyName = false;
+                propertyDefaultValue = std::nullopt;
+                propertyValid = std::nullopt;
+                next = Frame::BLOCK_PROPERTY;
+                isNextObject = true;
+                break;
+            case Frame::BLOCK_PROPERTY:
+                if (key != "valid") [[unlikely]] {
+                    next = Frame::BLOCK_PROPERTY;
+                    isNextObject = !isObject;
+                    break;
+                }
+                propertyValid.emplace();
+                next = Frame::BLOCK_PROPERTY_VALID;
+                isNextObject = false;
+                break;
+            case Frame::PROPERTY_DESCRIPTIONS:
+                if (key == "common") {
+                    currentDescriptionList = &blockIds->blockPropertyDescriptions.common;
+                    next = Frame::PROPERTY_DESCRIPTION_LIST;
+                } else {
+                    next = Frame::PER_BLOCK_LIST;
+                }
+                isNextObject = false;
+                break;
+            case Frame::PROPERTY_DESCRIPTION_LIST:
+                hasPropertyName = false;
+                propertyDescription = std::nullopt;
+                propertyValues.clear();
+                next = Frame::PROPERTY_DESCRIPTION;
+                isNextObject = true;
+                break;
+            case Frame::PROPERTY_DESCRIPTION:
+                if (key != "values") [[unlikely]] {
+                    next = Frame::PROPERTY_DESCRIPTION;
+                    isNextObject = !isObject;
+                    break;
+                }
+                next = Frame::PROPERTY_DESCRIPTION_VALUE_LIST;
+                isNextObject = false;
+                break;
+            case Frame::PROPERTY_DESCRIPTION_VALUE_LIST:
+                valueName = std::nullopt;
+                valueDescription = std::nullopt;
+                next = Frame::PROPERTY_DESCRIPTION_VALUE;
+                isNextObject = true;
+                break;
+            case Frame::PER_BLOCK_LIST:
+                currentPerBlock = &blockIds->blockPropertyDescriptions.block.emplace_back();
+                next = Frame::PER_BLOCK;
+                isNextObject = true;
+                break;
+            case Frame::PER_BLOCK:
+                if (key == "blocks") {
+                    next = Frame::PER_BLOCK_BLOCKS;
+                } else {
+                    currentDescriptionList = &currentPerBlock->properties;
+                    next = Frame::PROPERTY_DESCRIPTION_LIST;
+                }
+                isNextObject = false;
+                break;
+            default:
+                // 字符串数组中出现了对象或数组
+                next = frames.back();
+                isNextObject = !isObject;
+                break;
+        }
+        if (isNextObject != isObject) [[unlikely]] {
+            Profile::push(R"(json type of "{}" should be {})", FORMAT_ARG(key), isNextObject ? "object" : "array");
+            throw std::runtime_error("error json type");
+        }
+        frames.push_back(next);
+        return true;
+    }
+
+    void IdJsonReader::onEnd() {
+        if (skipDepth > 0) [[unlikely]] {
+            --skipDepth;
+            return;
+        }
+        Frame frame = frames.back();
+        frames.pop_back();
+        switch (frame) {
+            case Frame::ID:
+                if (!hasIdName) [[unlikely]] {
+                    throwMissingMember("name");
+                }
+                break;
+            case Frame::BLOCK_PROPERTY: {
+                if (!hasPropertyName) [[unlikely]] {
+                    throwMissingMember("name");
+                }
+                if (!propertyDefaultValue.has_value()) [[unlikely]] {
+                    throwMissingMember("defaultValue");
+                }
+                PropertyType::PropertyType propertyType = getPropertyType(propertyDefaultValue.value());
+                if (propertyValid.has_value()) [[unlikely]] {
+                    for (const auto &item: propertyValid.value()) {
+                        if (getPropertyType(item) != propertyType) [[unlikely]] {
+                            throw std::runtime_error("error block state property type");
+                        }
+                    }
+                }
+                Property &property = currentBlockId->properties->emplace_back();
+                property.name = std::move(propertyName);
+                property.type = propertyType;
+                toPropertyValue(blockIds->propertyValues, propertyDefaultValue.value(), property.defaultValue);
+                if (propertyValid.has_value()) [[unlikely]] {
+                    property.valid = std::make_optional<std::vector<PropertyValue>>(propertyValid.value().size());
+                    for (size_t i = 0; i < propertyValid.value().size(); ++i) {
+                        toPropertyValue(blockIds->propertyValues, propertyValid.value()[i], property.valid.value()[i]);
+                    }
+                }
+                break;
+            }
+            case Frame::PROPERTY_DESCRIPTION: {
+                if (!hasPropertyName) [[unlikely]] {
+                    throwMissingMember("propertyName");
+                }
+                PropertyType::PropertyType propertyType = PropertyType::BOOLEAN;
+                if (!propertyValues.empty()) [[likely]] {
+                    propertyType = getPropertyType(propertyValues[0].first);
+                    for (const auto &item: propertyValues) {
+                        if (getPropertyType(item.first) != propertyType) [[unlikely]] {
+                            throw std::runtime_error("error block state property type");
+                        }
+                    }
+                }
+                BlockPropertyDescription &description = currentDescriptionList->emplace_back();
+                description.propertyName = std::move(propertyName);
+                description.description = std::move(propertyDescription);
+                description.values.resize(propertyValues.size());
+                for (size_t i = 0; i < propertyValues.size(); ++i) {
+                    toPropertyValue(blockIds->propertyValues, propertyValues[i].first, description.values[i].valueName);
+                    description.values[i].description = std::move(propertyValues[i].second);
+                }
+                description.type = propertyType;
+                break;
+            }
+            case Frame::PROPERTY_DESCRIPTION_VALUE:
+                if (!valueName.has_value()) [[unlikely]] {
+                    throwMissingMember("valueName");
+                }
+                propertyValues.emplace_back(std::move(valueName.value()), std::move(valueDescription));
+                break;
+            default:
+                break;
+        }
+    }
+
+}// namespace CHelper
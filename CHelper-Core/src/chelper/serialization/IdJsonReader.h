@@ -0,0 +1,151 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_IDJSONREADER_H
+#define CHELPER_IDJSONREADER_H
+
+#include <chelper/resources/id/BlockId.h>
+#include <chelper/resources/id/ItemId.h>
+#include <chelper/resources/id/NormalId.h>
+#include <pch.h>
+#include <rapidjson/reader.h>
+
+namespace CHelper {
+
+    namespace IdType {
+        enum IdType : uint8_t {
+            UNKNOWN,
+            NORMAL,
+            NAMESPACE,
+            BLOCK,
+            ITEM
+        };
+    }// namespace IdType
+
+    /**
+     * 以SAX的方式读取ID文件，边读取边构建ID数据，不生成完整的json DOM
+     *
+     * ID文件中"type"必须出现在"content"之前，否则无法确定content的结构，
+     * 这时会设置isNeedFallback，调用者需要改用DOM的方式读取
+     */
+    class IdJsonReader : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, IdJsonReader> {
+    public:
+        using PropertyScalar = std::variant<bool, int32_t, std::u16string>;
+
+        std::string id;
+        IdType::IdType type = IdType::UNKNOWN;
+        std::shared_ptr<std::vector<std::shared_ptr<NormalId>>> normalIds;
+        std::shared_ptr<std::vector<std::shared_ptr<NamespaceId>>> namespaceIds;
+        std::shared_ptr<std::vector<std::shared_ptr<ItemId>>> itemIds;
+        std::shared_ptr<BlockIds> blockIds;
+        bool isNeedFallback = false;
+
+    private:
+        enum class Frame : uint8_t {
+            ROOT,
+            ID_LIST,
+            ID,
+            ITEM_DESCRIPTIONS,
+            BLOCK_IDS,
+            BLOCK_PROPERTY_LIST,
+            BLOCK_PROPERTY,
+            BLOCK_PROPERTY_VALID,
+            PROPERTY_DESCRIPTIONS,
+            PROPERTY_DESCRIPTION_LIST,
+            PROPERTY_DESCRIPTION,
+            PROPERTY_DESCRIPTION_VALUE_LIST,
+            PROPERTY_DESCRIPTION_VALUE,
+            PER_BLOCK_LIST,
+            PER_BLOCK,
+            PER_BLOCK_BLOCKS,
+        };
+
+        std::vector<Frame> frames;
+        std::string key;
+        bool hasId = false;
+        bool hasContent = false;
+        // 下一个json值的键不认识，需要跳过
+        bool isSkipValue = false;
+        // 正在跳过的未知json值的嵌套深度
+        size_t skipDepth = 0;
+        // 正在构建的数据
+        NormalId *currentId = nullptr;
+        bool hasIdName = false;
+        ItemId *currentItemId = nullptr;
+        BlockId *currentBlockId = nullptr;
+        std::vector<BlockPropertyDescription> *currentDescriptionList = nullptr;
+        PerBlockPropertyDescription *currentPerBlock = nullptr;
+        // 方块状态的值需要读取完整个对象才能确定类型，先缓存起来
+        std::u16string propertyName;
+        bool hasPropertyName = false;
+        std::optional<PropertyScalar> propertyDefaultValue;
+        std::optional<std::vector<PropertyScalar>> propertyValid;
+        std::optional<std::u16string> propertyDescription;
+        std::vector<std::pair<PropertyScalar, std::optional<std::u16string>>> propertyValues;
+        std::optional<PropertyScalar> valueName;
+        std::optional<std::u16string> valueDescription;
+
+    public:
+        IdJsonReader() = default;
+
+        bool Null();
+
+        bool Bool(bool b);
+
+        bool Int(int i);
+
+        bool Uint(unsigned i);
+
+        bool Int64(int64_t i);
+
+        bool Uint64(uint64_t i);
+
+        bool Double(double d);
+
+        bool String(const char *str, rapidjson::SizeType length, bool copy);
+
+        bool StartObject();
+
+        bool Key(const char *str, rapidjson::SizeType length, bool copy);
+
+        bool EndObject(rapidjson::SizeType memberCount);
+
+        bool StartArray();
+
+        bool EndArray(rapidjson::SizeType elementCount);
+
+        /**
+         * 读取ID文件
+         *
+         * @return 是否读取成功，失败时需要判断isNeedFallback
+         */
+        bool read(std::istream &istream);
+
+    private:
+        bool onScalar(PropertyScalar &&value);
+
+        bool onStart(bool isObject);
+
+        void onEnd();
+    };
+
+}// namespace CHelper
+
+#endif//CHELPER_IDJSONREADER_H
@@ -23,6 +23,7 @@
 
 #include <chelper/node/CommandNode.h>
 #include <chelper/node/NodeType.h>
+#include <chelper/resources/LegacyBinaryFormat.h>
 
 #define CODEC_NODE(CodecType, ...) \
     CODEC_WITH_PARENT(CodecType, CHelper::Node::NodeSerializable, __VA_ARGS__)
@@ -51,7 +52,56 @@
         break;
 
 
-CODEC(CHelper::Node::NodeSerializable, id, brief, description, isMustAfterSpace)
+CODEC_REGISTER_JSON_KEY(CHelper::Node::NodeSerializable, id, brief, description, isMustAfterSpace);
+
+template<>
+struct serialization::Codec<CHelper::Node::NodeSerializable> : BaseCodec<CHelper::Node::NodeSerializable> {
+
+    using Type = CHelper::Node::NodeSerializable;
+
+    constexpr static bool enable = true;
+
+    template<class JsonValueType>
+    static void to_json(typename JsonValueType::AllocatorType &allocator,
+                        JsonValueType &jsonValue,
+                        const Type &t) {
+        jsonValue.SetObject();
+        Codec<decltype(t.id)>::template to_json_member<JsonValueType>(allocator, jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::id_(), t.id);
+        Codec<decltype(t.brief)>::template to_json_member<JsonValueType>(allocator, jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::brief_(), t.brief);
+        Codec<decltype(t.description)>::template to_json_member<JsonValueType>(allocator, jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::description_(), t.description);
+        Codec<decltype(t.isMustAfterSpace)>::template to_json_member<JsonValueType>(allocator, jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::isMustAfterSpace_(), t.isMustAfterSpace);
+    }
+
+    template<class JsonValueType>
+    static void from_json(const JsonValueType &jsonValue,
+                          Type &t) {
+        if (!jsonValue.IsObject()) [[unlikely]] {
+            throw exceptions::JsonSerializationTypeException("object", getJsonTypeStr(jsonValue.GetType()));
+        }
+        Codec<decltype(t.id)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::id_(), t.id);
+        Codec<decltype(t.brief)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::brief_(), t.brief);
+        Codec<decltype(t.description)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::description_(), t.description);
+        Codec<decltype(t.isMustAfterSpace)>::template from_json_member<JsonValueType>(jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::isMustAfterSpace_(), t.isMustAfterSpace);
+    }
+
+    template<bool isNeedConvert>
+    static void to_binary(std::ostream &ostream,
+                          const Type &t) {
+        Codec<decltype(t.id)>::template to_binary<isNeedConvert>(ostream, t.id);
+        CHelper::StringPool::writeString<isNeedConvert>(ostream, t.brief);
+        CHelper::StringPool::writeString<isNeedConvert>(ostream, t.description);
+        Codec<decltype(t.isMustAfterSpace)>::template to_binary<isNeedConvert>(ostream, t.isMustAfterSpace);
+    }
+
+    template<bool isNeedConvert>
+    static void from_binary(std::istream &istream,
+                            Type &t) {
+        Codec<decltype(t.id)>::template from_binary<isNeedConvert>(istream, t.id);
+        CHelper::StringPool::readString<isNeedConvert>(istream, t.brief);
+        CHelper::StringPool::readString<isNeedConvert>(istream, t.description);
+        Codec<decltype(t.isMustAfterSpace)>::template from_binary<isNeedConvert>(istream, t.isMustAfterSpace);
+    }
+};// namespace serialization
 
 template<>
 struct serialization::Codec<CHelper::Node::NodeWithType> : BaseCodec<CHelper::Node::NodeWithType> {
@@ -175,6 +225,7 @@ struct serialization::Codec<CHelper::Node::NodePerCommand> : BaseCodec<CHelper::
     static void to_json(typename JsonValueType::AllocatorType &allocator,
                         JsonValueType &jsonValue,
                         const Type &t) {
+        t.load();
         jsonValue.SetObject();
         //name
         Codec<decltype(t.name)>::template to_json_member<JsonValueType>(allocator, jsonValue, details::JsonKey<Type, typename JsonValueType::Ch>::name_(), t.name);
@@ -345,22 +396,62 @@ struct serialization::Codec<CHelper::Node::NodePerCommand> : BaseCodec<CHelper::
         //name
         Codec<decltype(t.name)>::template to_binary<isNeedConvert>(ostream, t.name);
         //description
-        Codec<decltype(t.description)>::template to_binary<isNeedConvert>(ostream, t.description);
+        CHelper::StringPool::writeString<isNeedConvert>(ostream, t.description);
         //syntax
         Codec<decltype(t.syntax)>::template to_binary<isNeedConvert>(ostream, t.syntax);
-        //node
-        Codec<decltype(t.nodes)>::template to_binary<isNeedConvert>(ostream, t.nodes);
+        //body (size + data), so that the loader can skip it and decode it on first use
+        //the raw data can only be copied when its strings refer to the string pool being written
+        if (!t.isLoaded() && t.lazyData->isNeedConvert == isNeedConvert) [[unlikely]] {
+            std::lock_guard lock(t.lazyData->mutex);
+            if (!t.lazyData->isLoaded.load(std::memory_order_relaxed) && t.lazyData->stringPool.get() == CHelper::StringPool::current) {
+                Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, static_cast<uint32_t>(t.lazyData->data.size()));
+                ostream.write(t.lazyData->data.data(), static_cast<std::streamsize>(t.lazyData->data.size()));
+                return;
+            }
+        }
+        t.load();
+        std::ostringstream body;
+        to_binary_body<isNeedConvert>(body, t);
+        const std::string bodyData = body.str();
+        Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, static_cast<uint32_t>(bodyData.size()));
+        ostream.write(bodyData.data(), static_cast<std::streamsize>(bodyData.size()));
+    }
+
+    template<bool isNeedConvert>
+    static void to_binary_body(std::ostream &ostream,
+                               const Type &t) {
+        //node (shared nodes are written as well, so that each command can still be loaded alone)
+        //definitions are ordered by their first use in wrappedNodes, so the data does not depend on which nodes are shared
+        std::vector<CHelper::Node::NodeWithType> definitions;
+        std::unordered_map<const CHelper::Node::NodeBase *, int32_t> definitionIndices;
+        definitions.reserve(t.nodes.nodes.size() + t.sharedNodes.size());
+        const auto addDefinition = [&definitions, &definitionIndices](const CHelper::Node::NodeWithType &node) {
+            if (definitionIndices.try_emplace(node.data, static_cast<int32_t>(definitions.size())).second) {
+                definitions.push_back(node);
+            }
+        };
+        for (const auto &wrappedNode: t.wrappedNodes) {
+            addDefinition(wrappedNode.innerNode);
+        }
+        for (const auto &node: t.nodes.nodes) {
+            addDefinition(node);
+        }
+        for (const auto &node: t.sharedNodes) {
+            addDefinition(node);
+        }
+        Codec<decltype(definitions)>::template to_binary<isNeedConvert>(ostream, definitions);
+        //content hash of each definition, so that the loader can share identical nodes without serializing them again
+        std::vector<XXH64_hash_t> nodeHashes;
+        nodeHashes.reserve(definitions.size());
+        for (const auto &node: definitions) {
+            nodeHashes.push_back(to_node_hash(node));
+        }
+        Codec<decltype(nodeHashes)>::template to_binary<isNeedConvert>(ostream, nodeHashes);
         //pre-parsed wrappedNodes graph (definition index + nextNodes indices)
         const uint32_t wrappedCount = static_cast<uint32_t>(t.wrappedNodes.size());
         Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, wrappedCount);
         for (const auto &wrappedNode: t.wrappedNodes) {
-            int32_t defIdx = -1;
-            for (size_t i = 0; i < t.nodes.nodes.size(); ++i) {
-                if (t.nodes.nodes[i].data == wrappedNode.innerNode.data) {
-                    defIdx = static_cast<int32_t>(i);
-                    break;
-                }
-            }
+            const int32_t defIdx = definitionIndices.at(wrappedNode.innerNode.data);
             Codec<int32_t>::template to_binary<isNeedConvert>(ostream, defIdx);
             const uint32_t nextCount = static_cast<uint32_t>(wrappedNode.nextNodes.size());
             Codec<uint32_t>::template to_binary<isNeedConvert>(ostream, nextCount);
@@ -395,11 +486,43 @@ struct serialization::Codec<CHelper::Node::NodePerCommand> : BaseCodec<CHelper::
             throw std::runtime_error("command size cannot be zero");
         }
         //description
-        Codec<decltype(t.description)>::template from_binary<isNeedConvert>(istream, t.description);
+        CHelper::StringPool::readString<isNeedConvert>(istream, t.description);
         //syntax (preserved for JSON round-trip)
         Codec<decltype(t.syntax)>::template from_binary<isNeedConvert>(istream, t.syntax);
+        //legacy format has no body size, so the body is decoded now
+        if (CHelper::LegacyBinaryFormat::isReading) [[unlikely]] {
+            std::vector<XXH64_hash_t> nodeHashes;
+            from_binary_body<isNeedConvert>(istream, t, nodeHashes);
+            return;
+        }
+        //body is kept as raw data and decoded by NodePerCommand::load() on first use
+        uint32_t bodySize;
+        Codec<uint32_t>::template from_binary<isNeedConvert>(istream, bodySize);
+        if (bodySize == 0) [[unlikely]] {
+            throw std::runtime_error("command body cannot be empty");
+        }
+        t.lazyData = std::make_unique<CHelper::Node::LazyCommandData>();
+        t.lazyData->data.resize(bodySize);
+        istream.read(t.lazyData->data.data(), static_cast<std::streamsize>(bodySize));
+        if (istream.gcount() != static_cast<std::streamsize>(bodySize)) [[unlikely]] {
+            throw std::runtime_error("unexpected end of command body");
+        }
+        t.lazyData->isNeedConvert = isNeedConvert;
+    }
+
+    template<bool isNeedConvert>
+    static void from_binary_body(std::istream &istream,
+                                 Type &t,
+                                 std::vector<XXH64_hash_t> &nodeHashes) {
         //node definitions
         Codec<decltype(t.nodes)>::template from_binary<isNeedConvert>(istream, t.nodes);
+        //content hash of each definition (the legacy format has no hashes)
+        if (!CHelper::LegacyBinaryFormat::isReading) [[likely]] {
+            Codec<std::vector<XXH64_hash_t>>::template from_binary<isNeedConvert>(istream, nodeHashes);
+            if (nodeHashes.size() != t.nodes.nodes.size()) [[unlikely]] {
+                throw std::runtime_error("node hash count does not match node count");
+            }
+        }
         //pre-parsed wrappedNodes graph
         uint32_t wrappedCount;
         Codec<uint32_t>::template from_binary<isNeedConvert>(istream, wrappedCount);
@@ -460,6 +583,15 @@ struct serialization::Codec<CHelper::Node::NodePerCommand> : BaseCodec<CHelper::
             }
         }
     }
+
+    //hash of the serialized node, strings are written inline so that the hash does not depend on the string pool
+    static XXH64_hash_t to_node_hash(const CHelper::Node::NodeWithType &node) {
+        CHelper::StringPool::Scope stringPoolScope(nullptr);
+        std::ostringstream ostream;
+        Codec<CHelper::Node::NodeWithType>::template to_binary<false>(ostream, node);
+        const std::string content = ostream.str();
+        return XXH3_64bits(content.data(), content.size());
+    }
 };
 
 class NodeTypeHelper {
@@ -486,7 +618,7 @@ public:
                             CHelper::Node::NodeWithType &t);
 };
 
-static CHelper::Node::NodeCreateStage::NodeCreateStage currentCreateStage;
+static thread_local CHelper::Node::NodeCreateStage::NodeCreateStage currentCreateStage;
 
 template<CHelper::Node::NodeTypeId::NodeTypeId nodeTypeId>
 struct NodeCodec {
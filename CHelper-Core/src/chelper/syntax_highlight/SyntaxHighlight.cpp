@@ -17,13 +17,9 @@
  */
 
 #include <chelper/node/NodeType.h>
+#include <chelper/profile/NodeProfile.h>
 #include <chelper/syntax_highlight/SyntaxHighlight.h>
 
-#define CHELPER_COLLECT_SYNTAX(v1)                                                                                              \
-    case Node::NodeTypeId::v1:                                                                                                  \
-        isDirty = SyntaxToken<typename Node::NodeTypeDetail<Node::NodeTypeId::v1>::Type>::collectSyntax(astNode, syntaxResult); \
-        break;
-
 namespace CHelper::SyntaxHighlight {
 
     template<class NodeType>
@@ -202,16 +198,22 @@ namespace CHelper::SyntaxHighlight {
         }
     };
 
+    template<Node::NodeTypeId::NodeTypeId nodeTypeId>
+    struct CollectSyntaxByNodeType {
+        static bool call(const ASTNode &astNode, SyntaxResult &syntaxResult) {
+            return SyntaxToken<typename Node::NodeTypeDetail<nodeTypeId>::Type>::collectSyntax(astNode, syntaxResult);
+        }
+    };
+
+    static constexpr auto collectSyntaxFunctions = Node::createNodeTypeTable<CollectSyntaxByNodeType>();
+
     void collectSyntaxResult(const ASTNode &astNode, SyntaxResult &syntaxResult) {
+        CHELPER_NODE_PROFILE_SCOPE(NodeProfile::Phase::SYNTAX_HIGHLIGHT, astNode.node, astNode.tokens.size());
+        CHELPER_TRACE_SCOPE_ARG("collect syntax result", "nodeType", Node::getNodeTypeName(astNode.node.nodeTypeId));
 #ifdef CHelperTest
         Profile::push("collect syntax result: {} {}", FORMAT_ARG(utf8::utf16to8(astNode.tokens.toString())), FORMAT_ARG(Node::getNodeTypeName(astNode.node.nodeTypeId)));
 #endif
-        bool isDirty;
-        switch (astNode.node.nodeTypeId) {
-            CODEC_PASTE(CHELPER_COLLECT_SYNTAX, CHELPER_NODE_TYPES)
-            default:
-                CHELPER_UNREACHABLE();
-        }
+        bool isDirty = collectSyntaxFunctions[astNode.node.nodeTypeId](astNode, syntaxResult);
 #ifdef CHelperTest
         Profile::pop();
 #endif
@@ -21,10 +21,13 @@
 namespace CHelper::Profile {
 
 #ifndef CHELPER_NO_FILESYSTEM
-    std::vector<std::string> stack;
+    thread_local std::vector<std::string> stack;
 #endif
 
     void pop() {
+#ifdef CHELPER_TRACE
+        Trace::endFrame();
+#endif
 #ifndef CHELPER_NO_FILESYSTEM
         if (stack.empty()) {
             SPDLOG_ERROR("pop stack when stack is empty");
@@ -35,6 +38,9 @@ namespace CHelper::Profile {
     }
 
     void clear() {
+#ifdef CHELPER_TRACE
+        Trace::discardFrames();
+#endif
 #ifndef CHELPER_NO_FILESYSTEM
         stack.clear();
 #endif
@@ -42,8 +48,15 @@ namespace CHelper::Profile {
 
     void printAndClear(const std::exception &e) {
 #ifndef CHELPER_NO_FILESYSTEM
+#ifdef CHELPER_TRACE
+        SPDLOG_ERROR("{}\nstack trace:\n{}\nopen spans:\n{}", e.what(), fmt::join(stack, "\n"), Trace::Span::getOpenSpans());
+#else
         SPDLOG_ERROR("{}\nstack trace:\n{}", e.what(), fmt::join(stack, "\n"));
+#endif
         stack.clear();
+#endif
+#ifdef CHELPER_TRACE
+        Trace::discardFrames();
 #endif
     }
 
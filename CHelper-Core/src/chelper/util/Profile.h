@@ -27,13 +27,18 @@
 namespace CHelper::Profile {
 
 #ifndef CHELPER_NO_FILESYSTEM
-    extern std::vector<std::string> stack;
+    // 每个线程单独记录，后台加载资源包时不会和其它线程混在一起
+    extern thread_local std::vector<std::string> stack;
 #endif
 
     template<typename... T>
     void push(const fmt::format_string<T...> fmt, T &&...args) {
 #ifndef CHELPER_NO_FILESYSTEM
         stack.push_back(fmt::vformat(fmt.str, fmt::vargs<T...>{{args...}}));
+#endif
+#ifdef CHELPER_TRACE
+        // 格式字符串都是字面量，可以直接作为区间的名称
+        Trace::beginFrame(fmt.str.data());
 #endif
     }
 
@@ -44,9 +49,41 @@ namespace CHelper::Profile {
 #ifndef CHELPER_NO_FILESYSTEM
         pop();
         stack.push_back(fmt::vformat(fmt.str, fmt::vargs<T...>{{args...}}));
+#elif defined(CHELPER_TRACE)
+        Trace::endFrame();
+#endif
+#ifdef CHELPER_TRACE
+        Trace::beginFrame(fmt.str.data());
 #endif
     }
 
+    /**
+     * 在作用域内记录一层调用栈，正常离开作用域时弹出
+     *
+     * 抛出异常时保留这一层，由捕获异常的地方打印并清空，这样错误信息中可以看到出错的位置
+     */
+    class Scope {
+    private:
+        int uncaughtExceptions;
+
+    public:
+        template<typename... T>
+        explicit Scope(const fmt::format_string<T...> fmt, T &&...args)
+            : uncaughtExceptions(std::uncaught_exceptions()) {
+            push(fmt, std::forward<T>(args)...);
+        }
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() {
+            if (std::uncaught_exceptions() == uncaughtExceptions) [[likely]] {
+                pop();
+            }
+        }
+    };
+
     void clear();
 
     void printAndClear(const std::exception &e);
@@ -0,0 +1,255 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/util/Trace.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace CHelper::Trace {
+
+    class Frame {
+    public:
+        const char *name;
+        uint64_t start;
+    };
+
+    /**
+     * 一个线程的环形缓冲区，写满以后覆盖最早的事件
+     */
+    class Buffer {
+    public:
+        std::mutex mutex;
+        uint64_t threadId;
+        std::vector<Event> events;
+        // 下一个事件写入的位置
+        size_t head = 0;
+        size_t size = 0;
+
+        Buffer(uint64_t threadId, size_t capacity)
+            : threadId(threadId) {
+            events.resize(std::max<size_t>(capacity, 1));
+        }
+
+        void push(const Event &event) {
+            std::lock_guard<std::mutex> lock(mutex);
+            events[head] = event;
+            head = (head + 1) % events.size();
+            size = std::min(size + 1, events.size());
+        }
+    };
+
+    static std::atomic<bool> enabled = false;
+    static std::atomic<size_t> bufferCapacity = 1 << 14;
+    static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    // 线程结束以后缓冲区仍然保留，这样导出时不会丢失后台线程的事件
+    static std::mutex buffersMutex;
+    static std::vector<std::shared_ptr<Buffer>> buffers;
+    static thread_local Buffer *currentBuffer = nullptr;
+    static thread_local Span *currentSpan = nullptr;
+    static thread_local std::vector<Frame> frames;
+
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count());
+    }
+
+    static Buffer &getBuffer() {
+        if (currentBuffer == nullptr) [[unlikely]] {
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            auto buffer = std::make_shared<Buffer>(buffers.size() + 1, bufferCapacity.load(std::memory_order_relaxed));
+            currentBuffer = buffer.get();
+            buffers.push_back(std::move(buffer));
+        }
+        return *currentBuffer;
+    }
+
+    Span::Span(const char *name)
+        : isRecording(isEnabled()),
+          parent(currentSpan) {
+        event.name = name;
+        currentSpan = this;
+        if (isRecording) {
+            event.start = now();
+        }
+    }
+
+    Span::Span(const char *name, const char *key, int64_t value)
+        : Span(name) {
+        event.argKey = key;
+        event.argType = ArgType::INTEGER;
+        event.integerValue = value;
+    }
+
+    Span::Span(const char *name, const char *key, const char *value)
+        : Span(name) {
+        event.argKey = key;
+        event.argType = ArgType::STATIC_STRING;
+        event.stringValue = value;
+    }
+
+    Span::Span(const char *name, const char *key, std::u16string_view value)
+        : Span(name) {
+        // 只复制固定长度的内容，不会分配内存，格式化留到导出的时候
+        event.argKey = key;
+        event.argType = ArgType::TEXT;
+        event.textLength = static_cast<uint8_t>(std::min(value.size(), Event::MAX_TEXT_LENGTH));
+        std::copy_n(value.data(), event.textLength, event.text.data());
+    }
+
+    Span::~Span() {
+        currentSpan = parent;
+        if (isRecording) {
+            event.duration = now() - event.start;
+            getBuffer().push(event);
+        }
+    }
+
+    static std::string getArgValue(const Event &event) {
+        switch (event.argType) {
+            case ArgType::INTEGER:
+                return std::to_string(event.integerValue);
+            case ArgType::STATIC_STRING:
+                return event.stringValue == nullptr ? std::string() : std::string(event.stringValue);
+            case ArgType::TEXT:
+                return utf8::utf16to8(std::u16string_view(event.text.data(), event.textLength));
+            default:
+                return {};
+        }
+    }
+
+    std::string Span::getOpenSpans() {
+        std::vector<std::string> result;
+        for (const Span *span = currentSpan; span != nullptr; span = span->parent) {
+            if (span->event.argType == ArgType::NONE) {
+                result.emplace_back(span->event.name);
+            } else {
+                result.push_back(fmt::format("{} ({}: {})", span->event.name, span->event.argKey, getArgValue(span->event)));
+            }
+        }
+        return fmt::format("{}", fmt::join(result, "\n"));
+    }
+
+    void setEnabled(bool isEnabled) {
+        enabled.store(isEnabled, std::memory_order_relaxed);
+    }
+
+    bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void setBufferCapacity(size_t capacity) {
+        bufferCapacity.store(capacity, std::memory_order_relaxed);
+    }
+
+    void beginFrame(const char *name) {
+        frames.push_back({name, isEnabled() ? now() : 0});
+    }
+
+    void endFrame() {
+        if (frames.empty()) [[unlikely]] {
+            return;
+        }
+        Frame frame = frames.back();
+        frames.pop_back();
+        // 阶段开始时没有开启记录的不保存
+        if (frame.start != 0 && isEnabled()) {
+            Event event;
+            event.name = frame.name;
+            event.start = frame.start;
+            event.duration = now() - frame.start;
+            getBuffer().push(event);
+        }
+    }
+
+    void discardFrames() {
+        frames.clear();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (const auto &buffer: buffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            buffer->head = 0;
+            buffer->size = 0;
+        }
+    }
+
+    std::string toChromeTraceJson() {
+        rapidjson::StringBuffer stringBuffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+        writer.StartObject();
+        writer.Key("traceEvents");
+        writer.StartArray();
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (const auto &buffer: buffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            size_t capacity = buffer->events.size();
+            size_t begin = (buffer->head + capacity - buffer->size) % capacity;
+            for (size_t i = 0; i < buffer->size; ++i) {
+                const Event &event = buffer->events[(begin + i) % capacity];
+                writer.StartObject();
+                writer.Key("name");
+                writer.String(event.name);
+                writer.Key("cat");
+                writer.String("chelper");
+                writer.Key("ph");
+                writer.String("X");
+                writer.Key("ts");
+                writer.Double(static_cast<double>(event.start) / 1000);
+                writer.Key("dur");
+                writer.Double(static_cast<double>(event.duration) / 1000);
+                writer.Key("pid");
+                writer.Uint(1);
+                writer.Key("tid");
+                writer.Uint64(buffer->threadId);
+                if (event.argType != ArgType::NONE) {
+                    writer.Key("args");
+                    writer.StartObject();
+                    writer.Key(event.argKey);
+                    if (event.argType == ArgType::INTEGER) {
+                        writer.Int64(event.integerValue);
+                    } else {
+                        std::string value = getArgValue(event);
+                        writer.String(value.c_str(), static_cast<rapidjson::SizeType>(value.size()));
+                    }
+                    writer.EndObject();
+                }
+                writer.EndObject();
+            }
+        }
+        writer.EndArray();
+        writer.Key("displayTimeUnit");
+        writer.String("ms");
+        writer.EndObject();
+        return {stringBuffer.GetString(), stringBuffer.GetSize()};
+    }
+
+#ifndef CHELPER_NO_FILESYSTEM
+    void writeChromeTraceJson(const std::filesystem::path &path) {
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path());
+        }
+        std::ofstream ostream(path, std::ios::binary);
+        if (!ostream.is_open()) [[unlikely]] {
+            Profile::push("fail to open file: {}", path.string());
+            throw std::runtime_error("fail to open file");
+        }
+        ostream << toChromeTraceJson();
+    }
+#endif
+
+}// namespace CHelper::Trace
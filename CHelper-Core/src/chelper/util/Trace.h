@@ -0,0 +1,130 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifndef CHELPER_TRACE_H
+#define CHELPER_TRACE_H
+
+// 开启CHELPER_TRACE后记录带时间的调用区间，关闭时不会生成任何代码
+#ifdef CHELPER_TRACE
+#define CHELPER_TRACE_SCOPE(name) ::CHelper::Trace::Span chelperTraceSpan(name)
+#define CHELPER_TRACE_SCOPE_ARG(name, key, value) ::CHelper::Trace::Span chelperTraceSpan(name, key, value)
+#else
+#define CHELPER_TRACE_SCOPE(name) ;
+#define CHELPER_TRACE_SCOPE_ARG(name, key, value) ;
+#endif
+
+/**
+ * 记录代码运行的时间线，可以导出为Chrome的trace event格式，在chrome://tracing或Perfetto中查看
+ *
+ * 区间的名称必须是字符串字面量，参数在导出时才格式化，每个线程的记录保存在各自的环形缓冲区中
+ */
+namespace CHelper::Trace {
+
+    namespace ArgType {
+        enum ArgType : uint8_t {
+            NONE,
+            INTEGER,
+            STATIC_STRING,
+            TEXT
+        };
+    }// namespace ArgType
+
+    class Event {
+    public:
+        // 文本参数最多保存的字符数量，超出的部分会被截断
+        static constexpr size_t MAX_TEXT_LENGTH = 48;
+
+        const char *name = nullptr;
+        // 相对于程序启动的时间，单位为纳秒
+        uint64_t start = 0;
+        uint64_t duration = 0;
+        const char *argKey = nullptr;
+        ArgType::ArgType argType = ArgType::NONE;
+        uint8_t textLength = 0;
+        int64_t integerValue = 0;
+        const char *stringValue = nullptr;
+        std::array<char16_t, MAX_TEXT_LENGTH> text;
+    };
+
+    class Span {
+    private:
+        Event event;
+        bool isRecording;
+        Span *parent;
+
+    public:
+        explicit Span(const char *name);
+
+        Span(const char *name, const char *key, int64_t value);
+
+        Span(const char *name, const char *key, const char *value);
+
+        Span(const char *name, const char *key, std::u16string_view value);
+
+        Span(const Span &) = delete;
+
+        Span &operator=(const Span &) = delete;
+
+        ~Span();
+
+        /**
+         * 当前线程还没有结束的区间，用于在出错时输出调用位置
+         */
+        static std::string getOpenSpans();
+    };
+
+    /**
+     * 运行时开关，默认关闭
+     */
+    void setEnabled(bool isEnabled);
+
+    bool isEnabled();
+
+    /**
+     * 设置之后新创建的线程缓冲区能保存的事件数量
+     */
+    void setBufferCapacity(size_t capacity);
+
+    /**
+     * 开始一个阶段，同一个线程的阶段按栈的方式嵌套，Profile::push会调用这个函数
+     */
+    void beginFrame(const char *name);
+
+    void endFrame();
+
+    /**
+     * 丢弃当前线程没有结束的阶段，比如出错以后
+     */
+    void discardFrames();
+
+    /**
+     * 清空所有线程已经记录的事件
+     */
+    void clear();
+
+    std::string toChromeTraceJson();
+
+#ifndef CHELPER_NO_FILESYSTEM
+    void writeChromeTraceJson(const std::filesystem::path &path);
+#endif
+
+}// namespace CHelper::Trace
+
+#endif//CHELPER_TRACE_H
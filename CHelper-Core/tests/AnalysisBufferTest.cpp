@@ -0,0 +1,113 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/analysis/AnalysisBuffer.h>
+#include <gtest/gtest.h>
+
+namespace CHelper::Test {
+
+    static uint32_t readUint32(const Analysis::AnalysisBuffer &buffer, size_t offset) {
+        uint32_t result;
+        std::memcpy(&result, buffer.data() + offset, sizeof(uint32_t));
+        return result;
+    }
+
+    static std::u16string readString(const Analysis::AnalysisBuffer &buffer, size_t offset, size_t length) {
+        std::u16string result(length, u'\0');
+        std::memcpy(result.data(), buffer.data() + offset, length * sizeof(char16_t));
+        return result;
+    }
+
+    TEST(AnalysisBufferTest, Write) {
+        std::filesystem::path resourceDir(RESOURCE_DIR);
+        std::unique_ptr<CHelperCore> core(CHelperCore::createByDirectory(resourceDir / "resources" / "beta" / "vanilla"));
+        ASSERT_NE(core, nullptr);
+        Analysis::AnalysisBuffer buffer;
+        for (const auto &command: {u"give @s app", u"execute if block ~~~ stone[", u""}) {
+            core->onTextChanged(command, std::char_traits<char16_t>::length(command));
+            buffer.write(*core, Analysis::AnalysisFlag::ALL);
+            ASSERT_EQ(reinterpret_cast<size_t>(buffer.data()) % 4, 0);
+            EXPECT_EQ(readUint32(buffer, 0), Analysis::AnalysisBuffer::VERSION);
+            EXPECT_EQ(readUint32(buffer, 4), Analysis::AnalysisFlag::ALL);
+            EXPECT_EQ(readUint32(buffer, 8), buffer.size());
+            EXPECT_EQ(readUint32(buffer, 12), Analysis::AnalysisSection::COUNT);
+            auto sectionOffset = [&buffer](Analysis::AnalysisSection::AnalysisSection section) {
+                return readUint32(buffer, 16 + 8 * section);
+            };
+            // structure
+            size_t offset = sectionOffset(Analysis::AnalysisSection::STRUCTURE);
+            EXPECT_EQ(readString(buffer, offset + 4, readUint32(buffer, offset)), core->getStructure());
+            // paramHint
+            offset = sectionOffset(Analysis::AnalysisSection::PARAM_HINT);
+            EXPECT_EQ(readString(buffer, offset + 4, readUint32(buffer, offset)), core->getParamHint());
+            // errorReasons
+            offset = sectionOffset(Analysis::AnalysisSection::ERROR_REASONS);
+            auto errorReasons = core->getErrorReasons();
+            ASSERT_EQ(readUint32(buffer, offset), errorReasons.size());
+            for (size_t i = 0; i < errorReasons.size(); ++i) {
+                size_t record = offset + 4 + i * Analysis::AnalysisBuffer::ERROR_REASON_WORD_COUNT * 4;
+                EXPECT_EQ(readUint32(buffer, record), errorReasons[i]->start);
+                EXPECT_EQ(readUint32(buffer, record + 4), errorReasons[i]->end);
+                EXPECT_EQ(readString(buffer, readUint32(buffer, record + 8), readUint32(buffer, record + 12)), errorReasons[i]->errorReason);
+            }
+            // suggestions
+            offset = sectionOffset(Analysis::AnalysisSection::SUGGESTIONS);
+            auto suggestions = core->getSuggestions();
+            ASSERT_EQ(readUint32(buffer, offset), suggestions->size());
+            for (size_t i = 0; i < suggestions->size(); ++i) {
+                size_t record = offset + 4 + i * Analysis::AnalysisBuffer::SUGGESTION_WORD_COUNT * 4;
+                const auto &content = (*suggestions)[i].content;
+                EXPECT_EQ(readString(buffer, readUint32(buffer, record), readUint32(buffer, record + 4)), content->name);
+                EXPECT_EQ(readString(buffer, readUint32(buffer, record + 8), readUint32(buffer, record + 12)), content->description.value_or(u""));
+            }
+            // syntaxTokens
+            offset = sectionOffset(Analysis::AnalysisSection::SYNTAX_TOKENS);
+            auto syntaxResult = core->getSyntaxResult();
+            ASSERT_EQ(readUint32(buffer, offset), syntaxResult.tokenTypes.size());
+            EXPECT_EQ(std::memcmp(buffer.data() + offset + 4, syntaxResult.tokenTypes.data(), syntaxResult.tokenTypes.size()), 0);
+        }
+        // 没有请求的部分偏移量为0
+        buffer.write(*core, Analysis::AnalysisFlag::PARAM_HINT);
+        EXPECT_EQ(readUint32(buffer, 16 + 8 * Analysis::AnalysisSection::STRUCTURE), 0);
+        EXPECT_NE(readUint32(buffer, 16 + 8 * Analysis::AnalysisSection::PARAM_HINT), 0);
+        EXPECT_EQ(readUint32(buffer, 16 + 8 * Analysis::AnalysisSection::SUGGESTIONS), 0);
+        EXPECT_EQ(buffer.size(), Analysis::AnalysisBuffer::HEADER_WORD_COUNT * 4 + 4 + ((core->getParamHint().size() + 1) / 2) * 4);
+    }
+
+    TEST(AnalysisBufferTest, OwnedByCore) {
+        std::filesystem::path resourceDir(RESOURCE_DIR);
+        std::unique_ptr<CHelperCore> core1(CHelperCore::createByDirectory(resourceDir / "resources" / "beta" / "vanilla"));
+        std::unique_ptr<CHelperCore> core2(CHelperCore::createByDirectory(resourceDir / "resources" / "beta" / "vanilla"));
+        ASSERT_NE(core1, nullptr);
+        ASSERT_NE(core2, nullptr);
+        core1->onTextChanged(u"give @s app", 11);
+        core2->onTextChanged(u"execute if block ~~~ stone[", 27);
+        const auto &buffer1 = core1->analyze(Analysis::AnalysisFlag::ALL);
+        std::vector<uint8_t> content1(buffer1.data(), buffer1.data() + buffer1.size());
+        // 另一个内核的分析结果不会覆盖这个内核的缓冲区
+        const auto &buffer2 = core2->analyze(Analysis::AnalysisFlag::ALL);
+        EXPECT_NE(&buffer1, &buffer2);
+        ASSERT_EQ(buffer1.size(), content1.size());
+        EXPECT_EQ(std::memcmp(buffer1.data(), content1.data(), content1.size()), 0);
+        Analysis::AnalysisBuffer expected;
+        expected.write(*core2, Analysis::AnalysisFlag::ALL);
+        ASSERT_EQ(buffer2.size(), expected.size());
+        EXPECT_EQ(std::memcmp(buffer2.data(), expected.data(), expected.size()), 0);
+    }
+
+}// namespace CHelper::Test
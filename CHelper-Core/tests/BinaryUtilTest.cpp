@@ -18,7 +18,9 @@
 
 #include <chelper/node/CommandNode.h>
 #include <chelper/node/NodeInitialization.h>
+#include <chelper/parser/Parser.h>
 #include <chelper/resources/CPack.h>
+#include <chelper/serialization/IdJsonReader.h>
 #include <chelper/serialization/Serialization.h>
 #include <gtest/gtest.h>
 
@@ -77,7 +79,7 @@ namespace CHelper {
                 }
                 break;
             case PropertyType::STRING:
-                if (*t1.defaultValue.string != *t2.defaultValue.string) {
+                if (t1.defaultValue.string != t2.defaultValue.string) {
                     return false;
                 }
                 break;
@@ -104,7 +106,7 @@ namespace CHelper {
                         }
                         break;
                     case PropertyType::STRING:
-                        if (*t1.valid.value()[i].string != *t2.valid.value()[i].string) {
+                        if (t1.valid.value()[i].string != t2.valid.value()[i].string) {
                             return false;
                         }
                         break;
@@ -143,7 +145,7 @@ namespace CHelper {
                     }
                     break;
                 case PropertyType::STRING:
-                    if (*t1.values[i].valueName.string != *t2.values[i].valueName.string) {
+                    if (t1.values[i].valueName.string != t2.values[i].valueName.string) {
                         return false;
                     }
                     break;
@@ -170,8 +172,20 @@ namespace CHelper {
         return t1.common == t2.common && t1.block == t2.block;
     }
 
+    bool operator==(const StringPool &t1, const StringPool &t2) {
+        if (t1.size() != t2.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < t1.size(); ++i) {
+            if (t1.get(static_cast<uint32_t>(i)) != t2.get(static_cast<uint32_t>(i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     bool operator==(const BlockIds &t1, const BlockIds &t2) {
-        return t1.blockStateValues == t2.blockStateValues && t1.blockPropertyDescriptions == t2.blockPropertyDescriptions;
+        return t1.propertyValues == t2.propertyValues && t1.blockStateValues == t2.blockStateValues && t1.blockPropertyDescriptions == t2.blockPropertyDescriptions;
     }
 
     namespace Node {
@@ -320,6 +334,47 @@ TEST(BinaryUtilTest, NormalId) {
     test<std::shared_ptr<CHelper::NormalId>>({getInstance1, getInstance2, getInstance3});
 }
 
+TEST(BinaryUtilTest, StringPool) {
+    CHelper::StringPool stringPool;
+    EXPECT_EQ(stringPool.intern(u"name"), 0u);
+    EXPECT_EQ(stringPool.intern(u"description"), 1u);
+    EXPECT_EQ(stringPool.intern(u"name"), 0u);
+    EXPECT_EQ(stringPool.size(), 2u);
+    EXPECT_EQ(stringPool.getReferenceCount(), 3u);
+    // 使用字符串池时，ID中的字符串只写入下标
+    std::ostringstream oss;
+    std::optional<CHelper::StringPool::Scope> stringPoolScope(std::in_place, &stringPool);
+    auto t1 = CHelper::NormalId::make(u"name", u"description");
+    auto t2 = CHelper::NormalId::make(u"other", std::nullopt);
+    serialization::Codec<std::shared_ptr<CHelper::NormalId>>::to_binary<false>(oss, t1);
+    serialization::Codec<std::shared_ptr<CHelper::NormalId>>::to_binary<false>(oss, t2);
+    EXPECT_EQ(stringPool.size(), 3u);
+    std::istringstream iss(oss.str());
+    std::shared_ptr<CHelper::NormalId> t3, t4;
+    serialization::Codec<std::shared_ptr<CHelper::NormalId>>::from_binary<false>(iss, t3);
+    serialization::Codec<std::shared_ptr<CHelper::NormalId>>::from_binary<false>(iss, t4);
+    stringPoolScope.reset();
+    EXPECT_EQ(CHelper::StringPool::current, nullptr);
+    EXPECT_EQ(*t1, *t3);
+    EXPECT_EQ(*t2, *t4);
+}
+
+TEST(BinaryUtilTest, StringPoolScope) {
+    CHelper::StringPool stringPool1, stringPool2;
+    {
+        CHelper::StringPool::Scope scope1(&stringPool1);
+        // 抛出异常时也要恢复之前的字符串池
+        auto useStringPool2 = [&stringPool2]() {
+            CHelper::StringPool::Scope scope2(&stringPool2);
+            EXPECT_EQ(CHelper::StringPool::current, &stringPool2);
+            throw std::runtime_error("test");
+        };
+        EXPECT_THROW(useStringPool2(), std::runtime_error);
+        EXPECT_EQ(CHelper::StringPool::current, &stringPool1);
+    }
+    EXPECT_EQ(CHelper::StringPool::current, nullptr);
+}
+
 TEST(BinaryUtilTest, NamespaceId) {
     std::filesystem::path resourceDir(RESOURCE_DIR);
     rapidjson::GenericDocument<rapidjson::UTF8<>> j = serialization::get_json_from_file(
@@ -374,11 +429,11 @@ TEST(BinaryUtilTest, Property) {
         CHelper::Property aProperty;
         aProperty.name = u"name3";
         aProperty.type = CHelper::PropertyType::STRING;
-        aProperty.defaultValue.string = new std::u16string(u"aaa");
+        aProperty.defaultValue.string = 0;
         aProperty.valid = std::vector<CHelper::PropertyValue>(3);
-        aProperty.valid->at(0).string = new std::u16string(u"a1");
-        aProperty.valid->at(1).string = new std::u16string(u"a2");
-        aProperty.valid->at(2).string = new std::u16string(u"a3");
+        aProperty.valid->at(0).string = 1;
+        aProperty.valid->at(1).string = 2;
+        aProperty.valid->at(2).string = 3;
         return aProperty;
     };
     test<CHelper::Property>({getInstance1, getInstance2, getInstance3});
@@ -391,6 +446,59 @@ TEST(BinaryUtilTest, BlockId) {
     CHelper::BlockIds blockIds;
     serialization::Codec<CHelper::BlockIds>::from_json(serialization::find_member_or_throw(j, "content"), blockIds);
     test<CHelper::BlockIds>([&blockIds]() { return blockIds; });
+    // 字符串类型的值通过字符串池读写json
+    rapidjson::GenericDocument<rapidjson::UTF8<>> j1;
+    serialization::Codec<CHelper::BlockIds>::to_json(j1.GetAllocator(), j1, blockIds);
+    CHelper::BlockIds blockIds1;
+    serialization::Codec<CHelper::BlockIds>::from_json(j1, blockIds1);
+    EXPECT_EQ(blockIds, blockIds1);
+    EXPECT_EQ(CHelper::BlockIds::currentPropertyValues, nullptr);
+    // 读取失败时也要恢复字符串池
+    rapidjson::GenericDocument<rapidjson::UTF8<>> j2;
+    j2.Parse(R"({"blockStateValues": 1, "blockPropertyDescriptions": {"common": [], "block": []}})");
+    CHelper::BlockIds blockIds2;
+    EXPECT_ANY_THROW(serialization::Codec<CHelper::BlockIds>::from_json(j2, blockIds2));
+    EXPECT_EQ(CHelper::BlockIds::currentPropertyValues, nullptr);
+    CHelper::Profile::clear();
+}
+
+TEST(BinaryUtilTest, IdJsonReader) {
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    for (const auto &file: std::filesystem::directory_iterator(resourceDir / "resources" / "beta" / "vanilla" / "id")) {
+        std::ifstream istream(file.path(), std::ios::binary);
+        CHelper::IdJsonReader reader;
+        ASSERT_TRUE(reader.read(istream));
+        rapidjson::GenericDocument<rapidjson::UTF8<>> j = serialization::get_json_from_file(file.path());
+        const auto &content = serialization::find_member_or_throw(j, "content");
+        switch (reader.type) {
+            case CHelper::IdType::NORMAL: {
+                std::shared_ptr<std::vector<std::shared_ptr<CHelper::NormalId>>> ids;
+                serialization::Codec<decltype(ids)>::from_json(content, ids);
+                EXPECT_EQ(ids, reader.normalIds);
+                break;
+            }
+            case CHelper::IdType::NAMESPACE: {
+                std::shared_ptr<std::vector<std::shared_ptr<CHelper::NamespaceId>>> ids;
+                serialization::Codec<decltype(ids)>::from_json(content, ids);
+                EXPECT_EQ(ids, reader.namespaceIds);
+                break;
+            }
+            case CHelper::IdType::ITEM: {
+                std::shared_ptr<std::vector<std::shared_ptr<CHelper::ItemId>>> ids;
+                serialization::Codec<decltype(ids)>::from_json(content, ids);
+                EXPECT_EQ(ids, reader.itemIds);
+                break;
+            }
+            case CHelper::IdType::BLOCK: {
+                std::shared_ptr<CHelper::BlockIds> ids;
+                serialization::Codec<decltype(ids)>::from_json(content, ids);
+                EXPECT_EQ(ids, reader.blockIds);
+                break;
+            }
+            default:
+                FAIL();
+        }
+    }
 }
 
 TEST(BinaryUtilTest, PerCPackNormalIds) {
@@ -574,3 +682,362 @@ TEST(BinaryUtilTest, NodeJsonNull) {
     testNode<CHelper::Node::NodeJsonNull>(
             *cpack, []() { return CHelper::Node::NodeJsonNull{"ID", u"description"}; });
 }
+
+TEST(BinaryUtilTest, LazyCommand) {
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "chelper-test";
+    std::unique_ptr<CHelper::CPack> cpack1, cpack2;
+    try {
+        cpack1 = CHelper::CPack::createByDirectory(resourceDir / "resources" / "beta" / "vanilla");
+        cpack1->writeBinToFile(tempDir / "lazy1.cpack");
+        std::ifstream istream(tempDir / "lazy1.cpack", std::ios::binary);
+        cpack2 = CHelper::CPack::createByBinary(istream);
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        FAIL();
+    }
+    for (const auto &item: *cpack2->commands) {
+        EXPECT_FALSE(item.isLoaded());
+        // 还没有解析的命令共用加载时读取的字符串池
+        ASSERT_NE(item.lazyData, nullptr);
+        EXPECT_EQ(item.lazyData->stringPool, cpack2->commands->front().lazyData->stringPool);
+        EXPECT_NE(item.lazyData->stringPool, nullptr);
+    }
+    CHelper::Parser::parse(u"give @s apple", *cpack2);
+    for (const auto &item: *cpack2->commands) {
+        EXPECT_EQ(item.isLoaded(), item.name[0] == u"give");
+    }
+    // 部分命令已经解析的资源包再次写入时，内容应该保持一致
+    cpack2->writeBinToFile(tempDir / "lazy2.cpack");
+    std::ifstream istream1(tempDir / "lazy1.cpack", std::ios::binary);
+    std::ifstream istream2(tempDir / "lazy2.cpack", std::ios::binary);
+    std::string data1((std::istreambuf_iterator<char>(istream1)), std::istreambuf_iterator<char>());
+    std::string data2((std::istreambuf_iterator<char>(istream2)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(data1, data2);
+}
+
+TEST(BinaryUtilTest, LazyCommandThreads) {
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "chelper-test";
+    std::unique_ptr<CHelper::CPack> cpack1, cpack2;
+    try {
+        cpack1 = CHelper::CPack::createByDirectory(resourceDir / "resources" / "beta" / "vanilla");
+        cpack1->writeBinToFile(tempDir / "threads.cpack");
+        std::ifstream istream(tempDir / "threads.cpack", std::ios::binary);
+        cpack2 = CHelper::CPack::createByBinary(istream);
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        FAIL();
+    }
+    std::vector<std::u16string> contents;
+    for (const auto &item: *cpack1->commands) {
+        contents.push_back(item.name[0] + u" ");
+    }
+    // 多个线程同时第一次使用同一条命令
+    std::vector<std::vector<bool>> results(4);
+    std::vector<std::thread> threads;
+    for (auto &result: results) {
+        threads.emplace_back([&cpack2, &contents, &result]() {
+            for (const auto &content: contents) {
+                result.push_back(CHelper::Parser::parse(content, *cpack2).isError());
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    std::vector<bool> expected;
+    for (const auto &content: contents) {
+        expected.push_back(CHelper::Parser::parse(content, *cpack1).isError());
+    }
+    for (const auto &result: results) {
+        EXPECT_EQ(result, expected);
+    }
+    for (const auto &item: *cpack2->commands) {
+        EXPECT_TRUE(item.isLoaded());
+        EXPECT_EQ(item.wrappedNodes.size(), (*cpack1->commands)[&item - cpack2->commands->data()].wrappedNodes.size());
+        // 所有命令解析完成后不再持有字符串池
+        ASSERT_NE(item.lazyData, nullptr);
+        EXPECT_EQ(item.lazyData->stringPool, nullptr);
+    }
+}
+
+TEST(BinaryUtilTest, ParseErrorContext) {
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "chelper-test";
+    std::unique_ptr<CHelper::CPack> cpack;
+    try {
+        CHelper::CPack::createByDirectory(resourceDir / "resources" / "beta" / "vanilla")->writeBinToFile(tempDir / "error.cpack");
+        std::ifstream istream(tempDir / "error.cpack", std::ios::binary);
+        cpack = CHelper::CPack::createByBinary(istream);
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        FAIL();
+    }
+    // 命令第一次使用时找不到引用的json数据，解析命令时抛出异常
+    for (auto &item: cpack->jsonNodes) {
+        item.id = item.id.value() + "_missing";
+    }
+    CHelper::Profile::clear();
+    EXPECT_THROW(CHelper::Parser::parse(u"tellraw @a {\"rawtext\":[]}", *cpack), std::runtime_error);
+    // 捕获异常的地方打印的错误信息中有出错的命令和正在加载的命令
+    const auto &stack = CHelper::Profile::stack;
+    EXPECT_NE(std::ranges::find(stack, R"(start parsing: tellraw @a {"rawtext":[]})"), stack.end());
+    EXPECT_NE(std::ranges::find(stack, R"(loading command: "tellraw")"), stack.end());
+    CHelper::Profile::clear();
+}
+
+TEST(BinaryUtilTest, FormatVersion) {
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "chelper-test";
+    CHelper::CPack::createByDirectory(resourceDir / "resources" / "beta" / "vanilla")->writeBinToFile(tempDir / "version.cpack");
+    std::ifstream istream(tempDir / "version.cpack", std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(istream)), std::istreambuf_iterator<char>());
+    ASSERT_GT(data.size(), 8u);
+    // 连文件头都没有的数据
+    std::istringstream emptyStream(data.substr(0, 2));
+    EXPECT_THROW(CHelper::CPack::createByBinary(emptyStream), std::runtime_error);
+    CHelper::Profile::clear();
+    // 格式版本号不同的资源包
+    std::string otherVersion = data;
+    otherVersion[4] = static_cast<char>(otherVersion[4] + 1);
+    std::istringstream otherVersionStream(otherVersion);
+    EXPECT_THROW(CHelper::CPack::createByBinary(otherVersionStream), std::runtime_error);
+    CHelper::Profile::clear();
+    std::istringstream currentVersion(data);
+    EXPECT_NO_THROW(CHelper::CPack::createByBinary(currentVersion));
+}
+
+TEST(BinaryUtilTest, LegacyFormat) {
+    // 网页版自带的资源包是没有文件头的旧格式
+    std::filesystem::path cpackPath = std::filesystem::path(RESOURCE_DIR) / ".." / "CHelper-Web" / "src" / "assets" / "release-vanilla-1.21.132.1.cpack";
+    if (!std::filesystem::exists(cpackPath)) {
+        GTEST_SKIP() << "legacy cpack not found: " << cpackPath.string();
+    }
+    std::unique_ptr<CHelper::CPack> cpack;
+    try {
+        std::ifstream istream(cpackPath, std::ios::binary);
+        cpack = CHelper::CPack::createByBinary(istream);
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        FAIL();
+    }
+    EXPECT_EQ(CHelper::LegacyBinaryFormat::isReading, false);
+    EXPECT_EQ(CHelper::StringPool::current, nullptr);
+    ASSERT_FALSE(cpack->commands->empty());
+    // 旧格式的命令在加载时已经解析
+    for (const auto &item: *cpack->commands) {
+        EXPECT_TRUE(item.isLoaded());
+    }
+    EXPECT_FALSE(CHelper::Parser::parse(u"give @s apple", *cpack).isError());
+    EXPECT_FALSE(CHelper::Parser::parse(u"setblock ~ ~ ~ stone", *cpack).isError());
+}
+
+TEST(BinaryUtilTest, PrecomputedIdHashes) {
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "chelper-test";
+    std::unique_ptr<CHelper::CPack> cpack;
+    try {
+        CHelper::CPack::createByDirectory(resourceDir / "resources" / "beta" / "vanilla")->writeBinToFile(tempDir / "id-hashes.cpack");
+        std::ifstream istream(tempDir / "id-hashes.cpack", std::ios::binary);
+        cpack = CHelper::CPack::createByBinary(istream);
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        FAIL();
+    }
+    // 从资源包读取的哈希值应该和重新计算的一致
+    auto checkNamespaceIds = [](const auto &ids) {
+        for (const auto &item: ids) {
+            EXPECT_TRUE(item->fastMatch(XXH3_64bits(item->name.data(), item->name.size() * sizeof(char16_t))));
+            const std::u16string &idWithNamespace = item->getIdWithNamespace()->name;
+            EXPECT_TRUE(item->fastMatchWithNamespace(XXH3_64bits(idWithNamespace.data(), idWithNamespace.size() * sizeof(char16_t))));
+        }
+    };
+    for (const auto &item: cpack->normalIds) {
+        for (const auto &item2: *item.second) {
+            EXPECT_TRUE(item2->fastMatch(XXH3_64bits(item2->name.data(), item2->name.size() * sizeof(char16_t))));
+        }
+    }
+    for (const auto &item: cpack->namespaceIds) {
+        checkNamespaceIds(*item.second);
+    }
+    checkNamespaceIds(*cpack->itemIds);
+    checkNamespaceIds(*cpack->blockIds->blockStateValues);
+}
+
+TEST(BinaryUtilTest, OverlayCPack) {
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    std::unique_ptr<CHelper::CPack> base, overlay;
+    rapidjson::GenericDocument<rapidjson::UTF8<>> j;
+    j.Parse(R"({
+        "manifest": {
+            "name": "overlay",
+            "author": "Yancey",
+            "updateDate": "2026-02-13",
+            "packId": "OverlayPack",
+            "versionCode": 1
+        },
+        "id": [
+            {
+                "type": "item",
+                "content": [
+                    {"name": "apple", "description": "changed"},
+                    {"name": "overlay_item", "description": "added"}
+                ]
+            }
+        ]
+    })");
+    ASSERT_FALSE(j.HasParseError());
+    try {
+        base = CHelper::CPack::createByDirectory(resourceDir / "resources" / "beta" / "vanilla");
+        overlay = CHelper::CPack::createByOverlay(*base, j);
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        FAIL();
+    }
+    // 没有修改的ID列表直接共享
+    for (const auto &item: base->normalIds) {
+        EXPECT_EQ(item.second.get(), overlay->normalIds.at(item.first).get());
+    }
+    EXPECT_EQ(base->blockIds.get(), overlay->blockIds.get());
+    // 修改过的ID列表只替换修改的ID
+    EXPECT_EQ(overlay->itemIds->size(), base->itemIds->size() + 1);
+    for (size_t i = 0; i < base->itemIds->size(); ++i) {
+        const auto &item = (*base->itemIds)[i];
+        if (item->name == u"apple") {
+            EXPECT_EQ((*overlay->itemIds)[i]->description.value_or(u""), u"changed");
+            EXPECT_NE(item->description.value_or(u""), u"changed");
+        } else {
+            EXPECT_EQ(item.get(), (*overlay->itemIds)[i].get());
+        }
+    }
+    EXPECT_EQ(overlay->itemIds->back()->name, u"overlay_item");
+    // 命令从基础资源包复制
+    EXPECT_EQ(overlay->commands->size(), base->commands->size());
+    EXPECT_FALSE(CHelper::Parser::parse(u"give @s overlay_item", *overlay).isError());
+    // 共享的ID在两个资源包中同时第一次生成节点和哈希值
+    std::vector<std::u16string> contents;
+    for (const auto &item: *base->itemIds) {
+        contents.push_back(u"give @s " + item->name + u" 1 0");
+    }
+    for (const auto &item: *base->blockIds->blockStateValues) {
+        contents.push_back(u"setblock ~ ~ ~ " + item->name + u" []");
+    }
+    std::vector<bool> results1, results2;
+    std::thread thread1([&base, &contents, &results1]() {
+        for (const auto &content: contents) {
+            results1.push_back(CHelper::Parser::parse(content, *base).isError());
+        }
+    });
+    std::thread thread2([&overlay, &contents, &results2]() {
+        for (const auto &content: contents) {
+            results2.push_back(CHelper::Parser::parse(content, *overlay).isError());
+        }
+    });
+    thread1.join();
+    thread2.join();
+    EXPECT_EQ(results1, results2);
+}
+
+TEST(BinaryUtilTest, IdNodeCache) {
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    std::unique_ptr<CHelper::CPack> cpack;
+    try {
+        cpack = CHelper::CPack::createByDirectory(resourceDir / "resources" / "beta" / "vanilla");
+        for (const auto &item: *cpack->blockIds->blockStateValues) {
+            item->getNode(*cpack->blockIds);
+        }
+        for (const auto &item: *cpack->itemIds) {
+            item->getNode(cpack->itemNodeCache);
+        }
+    } catch (const std::exception &e) {
+        CHelper::Profile::printAndClear(e);
+        FAIL();
+    }
+    for (const auto &cache: {cpack->blockIds->nodeCache, cpack->itemNodeCache}) {
+        SPDLOG_INFO("{} ids -> {} node trees, {} nodes -> {} nodes",
+                    FORMAT_ARG(cache->getRequestCount()),
+                    FORMAT_ARG(cache->getEntryCount()),
+                    FORMAT_ARG(cache->getRequestNodeCount()),
+                    FORMAT_ARG(cache->getNodeCount()));
+        EXPECT_LT(cache->getEntryCount(), cache->getRequestCount());
+        EXPECT_LT(cache->getNodeCount(), cache->getRequestNodeCount());
+    }
+    // 方块状态相同的方块共用节点
+    std::shared_ptr<CHelper::BlockId> block1, block2;
+    for (const auto &item: *cpack->blockIds->blockStateValues) {
+        if (item->name == u"acacia_stairs") {
+            block1 = item;
+        } else if (item->name == u"andesite_stairs") {
+            block2 = item;
+        }
+    }
+    ASSERT_NE(block1, nullptr);
+    ASSERT_NE(block2, nullptr);
+    EXPECT_EQ(block1->getNode(*cpack->blockIds).data, block2->getNode(*cpack->blockIds).data);
+}
+
+TEST(BinaryUtilTest, BlockPropertyDescriptionsIndex) {
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    rapidjson::GenericDocument<rapidjson::UTF8<>> j = serialization::get_json_from_file(
+            resourceDir / "resources" / "beta" / "vanilla" / "id" / "block.json");
+    CHelper::BlockIds blockIds;
+    serialization::Codec<CHelper::BlockIds>::from_json(serialization::find_member_or_throw(j, "content"), blockIds);
+    const CHelper::BlockPropertyDescriptions &descriptions = blockIds.blockPropertyDescriptions;
+    blockIds.blockPropertyDescriptions.buildIndex();
+    // 和线性查找的结果比较
+    auto find = [&descriptions](const std::u16string &blockIdWithNamespace,
+                                const std::u16string &blockId,
+                                const std::u16string &propertyName) -> const CHelper::BlockPropertyDescription * {
+        for (const auto &item: descriptions.block) {
+            if (std::ranges::find(item.blocks, blockId) != item.blocks.end() ||
+                std::ranges::find(item.blocks, blockIdWithNamespace) != item.blocks.end()) {
+                for (const auto &item1: item.properties) {
+                    if (item1.propertyName == propertyName) {
+                        return &item1;
+                    }
+                }
+            }
+        }
+        for (const auto &item: descriptions.common) {
+            if (item.propertyName == propertyName) {
+                return &item;
+            }
+        }
+        return nullptr;
+    };
+    for (const auto &item: *blockIds.blockStateValues) {
+        if (!item->properties.has_value()) {
+            continue;
+        }
+        for (const auto &item1: item->properties.value()) {
+            const CHelper::BlockPropertyDescription *expected = find(item->getIdWithNamespace()->name, item->name, item1.name);
+            ASSERT_NE(expected, nullptr);
+            EXPECT_EQ(&descriptions.getPropertyDescription(item->getIdWithNamespace()->name, item->name, item1.name), expected);
+        }
+    }
+    // 复制后不需要手动构建索引，索引指向复制出来的数据
+    CHelper::BlockPropertyDescriptions copied = descriptions;
+    ASSERT_FALSE(copied.common.empty());
+    const CHelper::BlockPropertyDescription &common = copied.common.front();
+    EXPECT_EQ(&copied.getPropertyDescription(u"minecraft:unknown", u"unknown", common.propertyName), &common);
+    CHelper::BlockPropertyDescriptions assigned;
+    assigned = copied;
+    EXPECT_EQ(&assigned.getPropertyDescription(u"minecraft:unknown", u"unknown", common.propertyName), &assigned.common.front());
+    // 移动后索引仍然有效
+    CHelper::BlockPropertyDescriptions moved = std::move(copied);
+    EXPECT_EQ(&moved.getPropertyDescription(u"minecraft:unknown", u"unknown", common.propertyName), &common);
+    assigned = std::move(moved);
+    EXPECT_EQ(&assigned.getPropertyDescription(u"minecraft:unknown", u"unknown", common.propertyName), &common);
+    // 复制整个方块ID列表
+    CHelper::BlockIds copiedBlockIds = blockIds;
+    for (const auto &item: *copiedBlockIds.blockStateValues) {
+        if (!item->properties.has_value()) {
+            continue;
+        }
+        for (const auto &item1: item->properties.value()) {
+            const CHelper::BlockPropertyDescription &result = copiedBlockIds.blockPropertyDescriptions.getPropertyDescription(item->getIdWithNamespace()->name, item->name, item1.name);
+            EXPECT_EQ(result.propertyName, find(item->getIdWithNamespace()->name, item->name, item1.name)->propertyName);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/resources/CPack.h>
+#include <gtest/gtest.h>
+
+namespace CHelper::Test {
+
+    static void expectNoSameSibling(const std::string &name, const std::vector<Node::NodeWrapped *> &nodes) {
+        std::unordered_set<void *> datas;
+        for (const auto *item: nodes) {
+            if (item != Node::NodeLF::getInstance()) {
+                EXPECT_TRUE(datas.insert(item->innerNode.data).second) << name;
+            }
+        }
+    }
+
+    /**
+     * 加载命令时按照语法构建前缀树，同一个节点的后续节点中没有相同的参数，公共前缀只会解析一次
+     */
+    TEST(CommandTrieTest, LoadedCommandsShareOverloadPrefixes) {
+        std::filesystem::path resourceDir(RESOURCE_DIR);
+        for (const auto &versionType: {"release", "beta", "netease"}) {
+            for (const auto &branchDir: std::filesystem::directory_iterator(resourceDir / "resources" / versionType)) {
+                std::unique_ptr<CPack> cpack = CPack::createByDirectory(branchDir.path());
+                for (const auto &command: *cpack->commands) {
+                    std::string name = branchDir.path().filename().string() + " " + utf8::utf16to8(command.name[0]);
+                    expectNoSameSibling(name, command.startNodes);
+                    for (const auto &wrappedNode: command.wrappedNodes) {
+                        expectNoSameSibling(name, wrappedNode.nextNodes);
+                    }
+                }
+            }
+        }
+    }
+
+}// namespace CHelper::Test
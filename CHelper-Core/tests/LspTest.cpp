@@ -0,0 +1,307 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/lsp/LspServer.h>
+#include <future>
+#include <gtest/gtest.h>
+
+namespace CHelper::Test {
+
+    static std::shared_ptr<const CPack> getCPack() {
+        static std::shared_ptr<const CPack> cpack = CPack::createByDirectory(std::filesystem::path(RESOURCE_DIR) / "resources" / "beta" / "vanilla");
+        return cpack;
+    }
+
+    static std::string didOpen(const std::string &text, const std::string &uri = "file:///test.mcfunction") {
+        return R"({"jsonrpc":"2.0","method":"textDocument/didOpen","params":{"textDocument":{"uri":")" + uri +
+               R"(","languageId":"mcfunction","version":1,"text":")" + text + R"("}}})";
+    }
+
+    static std::string request(int id, const std::string &method, const std::string &params) {
+        return R"({"jsonrpc":"2.0","id":)" + std::to_string(id) + R"(,"method":")" + method + R"(","params":)" + params + "}";
+    }
+
+    static std::string cancelRequest(int id) {
+        return R"({"jsonrpc":"2.0","method":"$/cancelRequest","params":{"id":)" + std::to_string(id) + "}}";
+    }
+
+    static std::string documentParams(const std::string &uri = "file:///test.mcfunction") {
+        return R"({"textDocument":{"uri":")" + uri + R"("}})";
+    }
+
+    static std::string positionParams(size_t line, size_t character, const std::string &uri = "file:///test.mcfunction") {
+        return R"({"textDocument":{"uri":")" + uri + R"("},"position":{"line":)" + std::to_string(line) +
+               R"(,"character":)" + std::to_string(character) + "}}";
+    }
+
+    /**
+     * 模拟LSP客户端，在后台线程中收到的消息按请求id保存
+     */
+    class LspClient {
+    public:
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::unordered_map<int, std::string> responses;
+        std::vector<std::string> notifications;
+        // 在后台线程中收到消息时调用，需要在发送第一个消息之前设置
+        std::function<void()> beforeMessage;
+        Lsp::LspServer server;
+
+        explicit LspClient(std::shared_ptr<const CPack> cpack = getCPack(), size_t threadCount = 0)
+            : server(std::move(cpack), [this](const std::string &message) {
+                  onMessage(message);
+              }, threadCount) {}
+
+        void onMessage(const std::string &message) {
+            if (beforeMessage != nullptr) {
+                beforeMessage();
+            }
+            rapidjson::Document document;
+            document.Parse(message.data(), message.size());
+            std::lock_guard<std::mutex> lock(mutex);
+            if (document.HasMember("id")) {
+                responses[document["id"].GetInt()] = message;
+            } else {
+                notifications.push_back(message);
+            }
+            condition.notify_all();
+        }
+
+        rapidjson::Document waitResponse(int id) {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this, id]() {
+                return responses.find(id) != responses.end();
+            });
+            rapidjson::Document document;
+            document.Parse(responses[id].data(), responses[id].size());
+            responses.erase(id);
+            return document;
+        }
+
+        rapidjson::Document lastNotification() {
+            std::lock_guard<std::mutex> lock(mutex);
+            rapidjson::Document document;
+            if (!notifications.empty()) {
+                document.Parse(notifications.back().data(), notifications.back().size());
+            }
+            return document;
+        }
+
+        rapidjson::Document lastDiagnostics(const std::string &uri) {
+            std::lock_guard<std::mutex> lock(mutex);
+            rapidjson::Document document;
+            for (auto it = notifications.rbegin(); it != notifications.rend(); ++it) {
+                document.Parse(it->data(), it->size());
+                if (std::string_view(document["params"]["uri"].GetString()) == uri) {
+                    return document;
+                }
+            }
+            document.SetNull();
+            return document;
+        }
+    };
+
+    TEST(LspTest, Stdio) {
+        std::string input;
+        for (const auto &message: {
+                     request(1, "initialize", "{}"),
+                     std::string(R"({"jsonrpc":"2.0","method":"initialized","params":{}})"),
+                     didOpen(R"(give @s app\n# comment\r\nexecute run\n)"),
+                     request(2, "textDocument/completion", positionParams(0, 11)),
+                     request(3, "shutdown", "null"),
+                     std::string(R"({"jsonrpc":"2.0","method":"exit"})"),
+             }) {
+            std::ostringstream oss;
+            Lsp::LspServer::writeMessage(oss, message);
+            input.append(oss.str());
+        }
+        std::istringstream iss(input);
+        std::ostringstream oss;
+        EXPECT_EQ(Lsp::LspServer::run(getCPack(), iss, oss, 2), 0);
+        std::istringstream output(oss.str());
+        bool hasCompletion = false, hasDiagnostics = false;
+        while (std::optional<std::string> message = Lsp::LspServer::readMessage(output)) {
+            rapidjson::Document document;
+            document.Parse(message->data(), message->size());
+            ASSERT_FALSE(document.HasParseError());
+            if (document.HasMember("id") && document["id"].GetInt() == 2) {
+                hasCompletion = true;
+                bool hasApple = false;
+                for (const auto &item: document["result"]["items"].GetArray()) {
+                    hasApple = hasApple || std::string_view(item["label"].GetString()) == "apple";
+                    EXPECT_EQ(item["textEdit"]["range"]["start"]["line"].GetInt(), 0);
+                }
+                EXPECT_TRUE(hasApple);
+            } else if (document.HasMember("method") && std::string_view(document["method"].GetString()) == "textDocument/publishDiagnostics") {
+                hasDiagnostics = true;
+                const auto &diagnostics = document["params"]["diagnostics"];
+                EXPECT_GT(diagnostics.Size(), 0);
+                for (const auto &diagnostic: diagnostics.GetArray()) {
+                    // 注释和空行不会有错误
+                    EXPECT_NE(diagnostic["range"]["start"]["line"].GetInt(), 1);
+                    EXPECT_NE(diagnostic["range"]["start"]["line"].GetInt(), 3);
+                }
+            }
+        }
+        EXPECT_TRUE(hasCompletion);
+        EXPECT_TRUE(hasDiagnostics);
+        // 没有收到exit通知就结束输入
+        std::istringstream emptyInput;
+        EXPECT_EQ(Lsp::LspServer::run(getCPack(), emptyInput, oss, 1), 1);
+    }
+
+    TEST(LspTest, IncrementalChange) {
+        LspClient client;
+        client.server.handleMessage(didOpen("give @s app"));
+        client.server.handleMessage(R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///test.mcfunction","version":2},"contentChanges":[{"range":{"start":{"line":0,"character":8},"end":{"line":0,"character":11}},"text":"apple 1\nsay hi"}]}})");
+        client.server.waitIdle();
+        rapidjson::Document diagnostics = client.lastNotification();
+        ASSERT_TRUE(diagnostics.IsObject());
+        EXPECT_EQ(diagnostics["params"]["version"].GetInt(), 2);
+        EXPECT_EQ(diagnostics["params"]["diagnostics"].Size(), 0);
+        client.server.handleMessage(request(1, "textDocument/hover", positionParams(1, 2)));
+        rapidjson::Document hover = client.waitResponse(1);
+        EXPECT_TRUE(hover["result"]["contents"]["value"].IsString());
+        client.server.handleMessage(request(2, "textDocument/semanticTokens/full", R"({"textDocument":{"uri":"file:///test.mcfunction"}})"));
+        rapidjson::Document semanticTokens = client.waitResponse(2);
+        const auto &data = semanticTokens["result"]["data"];
+        EXPECT_GT(data.Size(), 0);
+        EXPECT_EQ(data.Size() % 5, 0);
+        // 第一个区间是第一行的命令名称
+        EXPECT_EQ(data[0u].GetUint(), 0);
+        EXPECT_EQ(data[1u].GetUint(), 0);
+        client.server.handleMessage(request(3, "textDocument/unknown", "{}"));
+        EXPECT_EQ(client.waitResponse(3)["error"]["code"].GetInt(), -32601);
+    }
+
+    TEST(LspTest, MultipleDocuments) {
+        // 多个文档在不同的后台线程中同时第一次使用二进制资源包中的命令、方块和物品
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "chelper-test" / "lsp.cpack";
+        std::shared_ptr<const CPack> binaryCPack;
+        try {
+            getCPack()->writeBinToFile(path);
+            std::ifstream istream(path, std::ios::binary);
+            binaryCPack = CPack::createByBinary(istream);
+        } catch (const std::exception &e) {
+            Profile::printAndClear(e);
+            FAIL();
+        }
+        std::vector<std::string> commands = {
+                "give @s apple 1",
+                "give @s wool 1 3",
+                R"(setblock ~ ~ ~ stone[\"stone_type\"=\"granite\"])",
+                "execute as @a at @s if block ~ ~-1 ~ grass run tp @s ~ ~1 ~",
+                "# comment",
+                "scoreboard players add @s score 1",
+                "effect @a speed 10 1",
+                "fill ~ ~ ~ ~1 ~1 ~1 air replace water",
+                "summon zombie ~ ~ ~",
+        };
+        size_t documentCount = 8;
+        std::vector<std::string> uris;
+        std::vector<std::string> texts;
+        for (size_t i = 0; i < documentCount; ++i) {
+            uris.push_back("file:///test" + std::to_string(i) + ".mcfunction");
+            // 每个文档中命令的顺序不同，让不同的线程先使用不同的命令
+            std::string text;
+            for (size_t j = 0; j < commands.size(); ++j) {
+                text.append(commands[(i + j) % commands.size()]).append("\\n");
+            }
+            texts.push_back(std::move(text));
+        }
+        LspClient binaryClient(binaryCPack, 4);
+        LspClient directoryClient(getCPack(), 1);
+        for (LspClient *client: {&binaryClient, &directoryClient}) {
+            for (size_t i = 0; i < documentCount; ++i) {
+                client->server.handleMessage(didOpen(texts[i], uris[i]));
+            }
+            for (size_t i = 0; i < documentCount; ++i) {
+                int id = static_cast<int>(i * 2);
+                size_t line = i % commands.size();
+                client->server.handleMessage(request(id, "textDocument/semanticTokens/full", documentParams(uris[i])));
+                client->server.handleMessage(request(id + 1, "textDocument/completion", positionParams(line, commands[(i + line) % commands.size()].size(), uris[i])));
+            }
+            client->server.waitIdle();
+        }
+        // 二进制资源包和文件夹资源包的结果相同
+        for (size_t i = 0; i < documentCount; ++i) {
+            for (int id: {static_cast<int>(i * 2), static_cast<int>(i * 2 + 1)}) {
+                rapidjson::Document response1 = binaryClient.waitResponse(id);
+                rapidjson::Document response2 = directoryClient.waitResponse(id);
+                ASSERT_TRUE(response1.HasMember("result"));
+                ASSERT_TRUE(response2.HasMember("result"));
+                EXPECT_TRUE(response1["result"] == response2["result"]) << uris[i];
+            }
+            rapidjson::Document diagnostics1 = binaryClient.lastDiagnostics(uris[i]);
+            rapidjson::Document diagnostics2 = directoryClient.lastDiagnostics(uris[i]);
+            ASSERT_TRUE(diagnostics1.IsObject());
+            ASSERT_TRUE(diagnostics2.IsObject());
+            EXPECT_TRUE(diagnostics1["params"]["diagnostics"] == diagnostics2["params"]["diagnostics"]) << uris[i];
+        }
+    }
+
+    TEST(LspTest, CancelRequest) {
+        // 只有一个后台线程，发送打开文档后的诊断时阻塞这个线程，保证请求在取消之后才开始执行
+        LspClient client(getCPack(), 1);
+        std::promise<void> blocked;
+        std::promise<void> release;
+        std::future<void> blockedFuture = blocked.get_future();
+        std::shared_future<void> releaseFuture = release.get_future().share();
+        bool isFirstMessage = true;
+        client.beforeMessage = [&isFirstMessage, &blocked, releaseFuture]() {
+            if (isFirstMessage) {
+                isFirstMessage = false;
+                blocked.set_value();
+                releaseFuture.wait();
+            }
+        };
+        client.server.handleMessage(didOpen("give @s apple"));
+        blockedFuture.wait();
+        client.server.handleMessage(request(1, "textDocument/semanticTokens/full", documentParams()));
+        client.server.handleMessage(request(2, "textDocument/completion", positionParams(0, 13)));
+        client.server.handleMessage(cancelRequest(1));
+        release.set_value();
+        EXPECT_EQ(client.waitResponse(1)["error"]["code"].GetInt(), -32800);
+        // 没有被取消的请求正常回复
+        EXPECT_TRUE(client.waitResponse(2).HasMember("result"));
+        // 已经回复的请求不能再取消
+        client.server.handleMessage(cancelRequest(2));
+        client.server.handleMessage(request(3, "textDocument/semanticTokens/full", documentParams()));
+        EXPECT_TRUE(client.waitResponse(3).HasMember("result"));
+    }
+
+    TEST(LspTest, InternalError) {
+        LspClient client(getCPack(), 1);
+        client.server.handleMessage(didOpen("give @s apple"));
+        client.server.waitIdle();
+        // 发送补全结果时抛出异常，请求要回复内部错误
+        bool isThrown = false;
+        client.beforeMessage = [&isThrown]() {
+            if (!isThrown) {
+                isThrown = true;
+                throw std::runtime_error("output failed");
+            }
+        };
+        client.server.handleMessage(request(1, "textDocument/completion", positionParams(0, 13)));
+        EXPECT_EQ(client.waitResponse(1)["error"]["code"].GetInt(), -32603);
+        // 出错的请求已经结束，后面的请求正常回复
+        client.server.handleMessage(request(2, "textDocument/completion", positionParams(0, 13)));
+        EXPECT_TRUE(client.waitResponse(2).HasMember("result"));
+    }
+
+}// namespace CHelper::Test
@@ -19,6 +19,7 @@
 #include <chelper/CHelperCore.h>
 #include <chelper/parser/Parser.h>
 #include <gtest/gtest.h>
+#include <thread>
 
 namespace CHelper::Test {
 
@@ -230,3 +231,25 @@ TEST(MainTest, ParseCommand) {
                     uR"(/list)"
             });
 }
+
+TEST(MainTest, ReloadCPack) {
+    std::filesystem::path resourceDir(RESOURCE_DIR);
+    std::unique_ptr<CHelper::CHelperCore> core(CHelper::CHelperCore::createByDirectory(resourceDir / "resources" / "beta" / "vanilla"));
+    ASSERT_NE(core, nullptr);
+    core->onTextChanged(u"give @s apple", 13);
+    // 在后台线程中加载新的资源包
+    bool isSuccess = false;
+    std::thread thread([&core, &resourceDir, &isSuccess]() {
+        isSuccess = core->reload([&resourceDir]() {
+            return CHelper::CPack::createByDirectory(resourceDir / "resources" / "beta" / "experiment");
+        });
+    });
+    thread.join();
+    ASSERT_TRUE(isSuccess);
+    // 输入变化之前继续使用旧的资源包
+    EXPECT_EQ(core->getCPack().manifest.branch.value_or(u""), u"vanilla");
+    EXPECT_TRUE(core->getErrorReasons().empty());
+    core->onTextChanged(u"give @s apple", 13);
+    EXPECT_EQ(core->getCPack().manifest.branch.value_or(u""), u"experiment");
+    EXPECT_TRUE(core->getErrorReasons().empty());
+}
@@ -0,0 +1,69 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/CHelperCore.h>
+#include <gtest/gtest.h>
+
+namespace CHelper::Test {
+
+    TEST(MemoryUsageTest, Report) {
+        std::filesystem::path resourceDir(RESOURCE_DIR);
+        std::unique_ptr<CHelperCore> core(CHelperCore::createByDirectory(resourceDir / "resources" / "beta" / "vanilla"));
+        ASSERT_NE(core, nullptr);
+        const CPack &cpack = core->getCPack();
+        MemoryUsage::Report report = core->getMemoryUsage();
+        SPDLOG_INFO("\n{}", report.toString());
+        // 节点的内容是估算的，报告中要说明
+        EXPECT_NE(report.toString().find("estimated"), std::string::npos);
+        // 字符串按容量统计，短字符串保存在对象内部
+        std::u16string str = u"minecraft:stone_block_slab";
+        str.reserve(100);
+        EXPECT_EQ(MemoryUsage::getHeapSize(str), 101 * sizeof(char16_t));
+        EXPECT_EQ(MemoryUsage::getHeapSize(std::u16string(u"a")), 0U);
+        EXPECT_EQ(report.categories[MemoryUsage::Category::ITEM_IDS].objectCount, cpack.itemIds->size());
+        EXPECT_EQ(report.categories[MemoryUsage::Category::BLOCK_IDS].objectCount, cpack.blockIds->blockStateValues->size());
+        EXPECT_GE(report.categories[MemoryUsage::Category::JSON_NODES].objectCount, cpack.jsonNodes.size());
+        EXPECT_GT(report.categories[MemoryUsage::Category::COMMANDS].objectCount, cpack.commands->size());
+        for (auto category: {MemoryUsage::Category::NORMAL_IDS,
+                             MemoryUsage::Category::NAMESPACE_IDS,
+                             MemoryUsage::Category::BLOCK_IDS,
+                             MemoryUsage::Category::ITEM_IDS,
+                             MemoryUsage::Category::JSON_NODES,
+                             MemoryUsage::Category::COMMANDS}) {
+            EXPECT_GT(report.categories[category].bytes, 0) << MemoryUsage::getCategoryName(category);
+        }
+        MemoryUsage::Counter total = report.getTotal();
+        size_t bytes = 0;
+        for (const auto &item: report.categories) {
+            bytes += item.bytes;
+        }
+        EXPECT_EQ(total.bytes, bytes);
+        // 使用时才创建的节点
+        for (const auto &blockId: *cpack.blockIds->blockStateValues) {
+            blockId->getNode(*cpack.blockIds);
+        }
+        for (const auto &itemId: *cpack.itemIds) {
+            itemId->getNode(cpack.itemNodeCache);
+        }
+        MemoryUsage::Report newReport = core->getMemoryUsage();
+        EXPECT_GT(newReport.categories[MemoryUsage::Category::BLOCK_NODE_CACHE].objectCount, report.categories[MemoryUsage::Category::BLOCK_NODE_CACHE].objectCount);
+        EXPECT_GT(newReport.categories[MemoryUsage::Category::ITEM_NODE_CACHE].bytes, report.categories[MemoryUsage::Category::ITEM_NODE_CACHE].bytes);
+        EXPECT_EQ(newReport.categories[MemoryUsage::Category::COMMANDS].bytes, report.categories[MemoryUsage::Category::COMMANDS].bytes);
+    }
+
+}// namespace CHelper::Test
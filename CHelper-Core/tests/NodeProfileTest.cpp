@@ -0,0 +1,57 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/CHelperCore.h>
+#include <gtest/gtest.h>
+
+namespace CHelper::Test {
+
+    TEST(NodeProfileTest, Report) {
+        std::filesystem::path resourceDir(RESOURCE_DIR);
+        std::unique_ptr<CHelperCore> core(CHelperCore::createByDirectory(resourceDir / "resources" / "beta" / "vanilla"));
+        ASSERT_NE(core, nullptr);
+        core->clearProfileReport();
+        for (const auto &command: {u"give @s apple 1", u"execute as @a run tp @s ~ ~1 ~", u"setblock ~~~ stone["}) {
+            core->onTextChanged(command, std::char_traits<char16_t>::length(command));
+            core->getSuggestions();
+            core->getErrorReasons();
+            core->getSyntaxResult();
+        }
+        NodeProfile::Report report = core->getProfileReport();
+#ifdef CHELPER_NODE_PROFILE
+        SPDLOG_INFO("\n{}", report.toString());
+        std::array<bool, NodeProfile::Phase::COUNT> hasPhase{};
+        for (const auto &item: report.nodeTypes) {
+            hasPhase[item.phase] = true;
+            EXPECT_GT(item.counter.callCount, 0);
+            EXPECT_LE(item.counter.exclusiveTime, item.counter.inclusiveTime);
+        }
+        for (bool item: hasPhase) {
+            EXPECT_TRUE(item);
+        }
+        EXPECT_FALSE(report.nodeIds.empty());
+        core->clearProfileReport();
+        EXPECT_TRUE(core->getProfileReport().nodeTypes.empty());
+#else
+        // 没有开启时不统计
+        EXPECT_TRUE(report.nodeTypes.empty());
+        EXPECT_TRUE(report.nodeIds.empty());
+#endif
+    }
+
+}// namespace CHelper::Test
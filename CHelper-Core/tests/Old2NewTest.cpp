@@ -19,43 +19,208 @@
 #include <gtest/gtest.h>
 
 #include <chelper/old2new/Old2New.h>
+#include <chelper/old2new/Old2NewBatch.h>
 
 namespace CHelper::Test {
 
+    // 旧命令和转换后的新命令
+    static std::vector<std::pair<std::u16string, std::u16string>> getOld2NewCases() {
+        return {
+                {uR"(execute @e[x=~5] ~~~ detect ~~-1~ stone 0 setblock ~~1~ command_block 0)",
+                 uR"(execute as @e[x=~5] at @s if block ~~-1~ stone["stone_type"="stone"] run setblock ~~1~ command_block["conditional_bit"=false,"facing_direction"=0])"},
+                {uR"(execute @e[type=zombie] ~ ~ ~ summon lightning_bolt)",
+                 uR"(execute as @e[type=zombie] at @s run summon lightning_bolt)"},
+                {uR"(execute @e[type=zombie] ~ ~ ~ detect ~ ~-1 ~ minecraft:sand -1 summon lightning_bolt)",
+                 uR"(execute as @e[type=zombie] at @s if block ~ ~-1 ~ minecraft:sand run summon lightning_bolt)"},
+                {uR"(execute @e[c=10] ~ ~ ~ execute @p ~ ~ ~ summon creeper ~ ~ ~)",
+                 uR"(execute as @e[c=10] at @s as @p at @s run summon creeper ~ ~ ~ 0 0)"},
+                {uR"(execute Yancey ~ ~ ~ summon ender_dragon)",
+                 uR"(execute as Yancey at @s run summon ender_dragon)"},
+                {uR"(execute @e[x=~5] ~~~ detect ~~-1~ stone 1 setblock ~~1~ stone 2)",
+                 uR"(execute as @e[x=~5] at @s if block ~~-1~ stone["stone_type"="granite"] run setblock ~~1~ stone["stone_type"="granite_smooth"])"},
+                {uR"(setblock ~~~ stone)",
+                 uR"(setblock ~~~ stone)"},
+                {uR"(setblock ~~~ minecraft:command_block 1)",
+                 uR"(setblock ~~~ minecraft:command_block["conditional_bit"=false,"facing_direction"=1])"},
+                {uR"(setblock ~~~ stone 3)",
+                 uR"(setblock ~~~ stone["stone_type"="diorite"])"},
+                {uR"(setblock ~~~ stone 3 replace)",
+                 uR"(setblock ~~~ stone["stone_type"="diorite"] replace)"},
+                {uR"(fill ~~~~~~ stone)",
+                 uR"(fill ~~~~~~ stone)"},
+                {uR"(fill ~~~~~~ stone 4)",
+                 uR"(fill ~~~~~~ stone["stone_type"="diorite_smooth"])"},
+                {uR"(fill ~~~~~~ stone 4 hollow)",
+                 uR"(fill ~~~~~~ stone["stone_type"="diorite_smooth"] hollow)"},
+                {uR"(fill ~~~~~~ stone 4 replace stone)",
+                 uR"(fill ~~~~~~ stone["stone_type"="diorite_smooth"] replace stone)"},
+                {uR"(fill ~~~~~~ stone 4 replace stone 5)",
+                 uR"(fill ~~~~~~ stone["stone_type"="diorite_smooth"] replace stone["stone_type"="andesite"])"},
+                {uR"(testforblock ~~~ stone)",
+                 uR"(testforblock ~~~ stone)"},
+                {uR"(testforblock ~~~ stone 3)",
+                 uR"(testforblock ~~~ stone["stone_type"="diorite"])"},
+                {uR"(testforblock ~~~ stone 3 replace)",
+                 uR"(testforblock ~~~ stone["stone_type"="diorite"] replace)"},
+                {uR"(/execute @e[name="Yancey NB"] ~~2.5 ~ detect ~~-1~ stone 1 /setblock ~ ~-1 ~ command_block 0)",
+                 uR"(/execute as @e[name="Yancey NB"] at @s positioned ~~2.5 ~ if block ~~-1~ stone["stone_type"="granite"] run /setblock ~ ~-1 ~ command_block["conditional_bit"=false,"facing_direction"=0])"},
+                {uR"(execute @a[tag=!OP] ~~~ detect ~~0.05~0.3 air 0 execute @s ~~~ detect ~-0.3~-0.05~ air 0 execute @s ~~~ detect ~~-0.05~0.3 air 0 execute @s ~~~ detect ~0.3~-0.05~0.3 air 0 execute @s ~~~ detect ~-0.3~-0.05~-0.3 air 0 execute @s ~~~ detect ~0.3~-0.05~-0.3 air 0 execute @s ~~~ detect ~-0.3~-0.05~0.3 air 0 scoreboard players add @s fly 1)",
+                 uR"(execute as @a[tag=!OP] at @s if block ~~0.05~0.3 air if block ~-0.3~-0.05~ air if block ~~-0.05~0.3 air if block ~0.3~-0.05~0.3 air if block ~-0.3~-0.05~-0.3 air if block ~0.3~-0.05~-0.3 air if block ~-0.3~-0.05~0.3 air run scoreboard players add @s fly 1)"},
+                {uR"(summon creeper ~ ~ ~ minecraft:become_charged "充能苦力怕")",
+                 uR"(summon creeper ~ ~ ~ 0 0 minecraft:become_charged "充能苦力怕")"},
+                {uR"(structure load aaa 0 0 0 0_degrees none true true 0.5 aaa)",
+                 uR"(structure load aaa 0 0 0 0_degrees none true true true 0.5 aaa)"},
+                {uR"(setblock ~~~ acacia_door["direction":1])",
+                 uR"(setblock ~~~ acacia_door["direction"=1])"},
+        };
+    }
+
     TEST(Old2NewTest, Old2New) {
         std::filesystem::path resourceDir(RESOURCE_DIR);
         Old2New::BlockFixData blockFixData =
                 Old2New::blockFixDataFromJson(serialization::get_json_from_file(
                         resourceDir / "resources" / "old2new" / "blockFixData.json"));
-        std::vector<std::u16string> oldCommands = {
-                uR"(execute @e[x=~5] ~~~ detect ~~-1~ stone 0 setblock ~~1~ command_block 0)",
-                uR"(execute @e[type=zombie] ~ ~ ~ summon lightning_bolt)",
-                uR"(execute @e[type=zombie] ~ ~ ~ detect ~ ~-1 ~ minecraft:sand -1 summon lightning_bolt)",
-                uR"(execute @e[c=10] ~ ~ ~ execute @p ~ ~ ~ summon creeper ~ ~ ~)",
-                uR"(execute Yancey ~ ~ ~ summon ender_dragon)",
-                uR"(execute @e[x=~5] ~~~ detect ~~-1~ stone 1 setblock ~~1~ stone 2)",
-                uR"(setblock ~~~ stone)",
-                uR"(setblock ~~~ minecraft:command_block 1)",
-                uR"(setblock ~~~ stone 3)",
-                uR"(setblock ~~~ stone 3 replace)",
-                uR"(fill ~~~~~~ stone)",
-                uR"(fill ~~~~~~ stone 4)",
-                uR"(fill ~~~~~~ stone 4 hollow)",
-                uR"(fill ~~~~~~ stone 4 replace stone)",
-                uR"(fill ~~~~~~ stone 4 replace stone 5)",
-                uR"(testforblock ~~~ stone)",
-                uR"(testforblock ~~~ stone 3)",
-                uR"(testforblock ~~~ stone 3 replace)",
-                uR"(/execute @e[name="Yancey NB"] ~~2.5 ~ detect ~~-1~ stone 1 /setblock ~ ~-1 ~ command_block 0)",
-                uR"(execute @a[tag=!OP] ~~~ detect ~~0.05~0.3 air 0 execute @s ~~~ detect ~-0.3~-0.05~ air 0 execute @s ~~~ detect ~~-0.05~0.3 air 0 execute @s ~~~ detect ~0.3~-0.05~0.3 air 0 execute @s ~~~ detect ~-0.3~-0.05~-0.3 air 0 execute @s ~~~ detect ~0.3~-0.05~-0.3 air 0 execute @s ~~~ detect ~-0.3~-0.05~0.3 air 0 scoreboard players add @s fly 1)",
-                uR"(summon creeper ~ ~ ~ minecraft:become_charged "充能苦力怕")",
-                uR"(structure load aaa 0 0 0 0_degrees none true true 0.5 aaa)",
-                uR"(setblock ~~~ acacia_door["direction":1])",
+        for (const auto &[oldCommand, newCommand]: getOld2NewCases()) {
+            EXPECT_EQ(utf8::utf16to8(Old2New::old2new(blockFixData, oldCommand)), utf8::utf16to8(newCommand));
+        }
+    }
+
+    TEST(Old2NewTest, BlockFixData) {
+        std::filesystem::path resourceDir(RESOURCE_DIR);
+        auto j = serialization::get_json_from_file(resourceDir / "resources" / "old2new" / "blockFixData.json");
+        Old2New::BlockFixData blockFixData = Old2New::blockFixDataFromJson(j);
+        std::ostringstream oss;
+        serialization::Codec<Old2New::BlockFixData>::to_binary<false>(oss, blockFixData);
+        std::istringstream iss(oss.str());
+        Old2New::BlockFixData blockFixData1;
+        serialization::Codec<Old2New::BlockFixData>::from_binary<false>(iss, blockFixData1);
+        EXPECT_EQ(blockFixData1.size(), blockFixData.size());
+        std::unordered_set<std::u16string> keys;
+        for (const auto &item: j.GetArray()) {
+            std::u16string name = utf8::utf8to16(item["name"].GetString());
+            auto data = static_cast<uint32_t>(item["data"].GetUint());
+            std::u16string key = name + u"#" + utf8::utf8to16(std::to_string(data));
+            if (!keys.insert(key).second) {
+                continue;
+            }
+            for (const auto *item1: {&blockFixData, &blockFixData1}) {
+                auto result = item1->find(name, data);
+                ASSERT_TRUE(result.has_value());
+                if (item.HasMember("blockState")) {
+                    EXPECT_TRUE(result->blockState == utf8::utf8to16(item["blockState"].GetString()));
+                } else {
+                    EXPECT_FALSE(result->blockState.has_value());
+                }
+                EXPECT_EQ(result->newBlockId.has_value(), item.HasMember("newBlockId"));
+            }
+        }
+        EXPECT_EQ(blockFixData.size(), keys.size());
+        EXPECT_FALSE(blockFixData.find(u"unknown_block", 0).has_value());
+        EXPECT_FALSE(blockFixData.find(u"stone", 100000).has_value());
+        EXPECT_FALSE(Old2New::BlockFixData().find(u"stone", 0).has_value());
+    }
+
+    TEST(Old2NewTest, BlockFixDataFormatVersion) {
+        std::vector<Old2New::BlockFixData::Item> items = {{u"stone", 1, u"stone", u"[\"stone_type\"=\"granite\"]"}};
+        Old2New::BlockFixData blockFixData(items);
+        std::ostringstream oss;
+        serialization::Codec<Old2New::BlockFixData>::to_binary<false>(oss, blockFixData);
+        const std::string binary = oss.str();
+        // 旧版本写入的文件没有开头的标识
+        std::istringstream withoutHeader(binary.substr(2 * sizeof(uint32_t)));
+        Old2New::BlockFixData blockFixData1;
+        EXPECT_THROW((serialization::Codec<Old2New::BlockFixData>::from_binary<false>(withoutHeader, blockFixData1)), std::runtime_error);
+        // 格式版本不同
+        std::string otherVersion = binary;
+        otherVersion[sizeof(uint32_t)]++;
+        std::istringstream withOtherVersion(otherVersion);
+        EXPECT_THROW((serialization::Codec<Old2New::BlockFixData>::from_binary<false>(withOtherVersion, blockFixData1)), std::runtime_error);
+        CHelper::Profile::clear();
+    }
+
+    TEST(Old2NewTest, Old2NewStream) {
+        std::filesystem::path resourceDir(RESOURCE_DIR);
+        Old2New::BlockFixData blockFixData =
+                Old2New::blockFixDataFromJson(serialization::get_json_from_file(
+                        resourceDir / "resources" / "old2new" / "blockFixData.json"));
+        // 旧命令和转换后的命令，不需要转换的行保持不变
+        std::vector<std::pair<std::string, std::string>> commands = {
+                {"# comment setblock ~~~ stone 3", "# comment setblock ~~~ stone 3"},
+                {"", ""},
+                {"setblock ~~~ stone 3", R"(setblock ~~~ stone["stone_type"="diorite"])"},
+                {"setblock ~~~ stone\r", "setblock ~~~ stone\r"},
+                {"fill ~~~~~~ stone 4 replace stone 5\r", "fill ~~~~~~ stone[\"stone_type\"=\"diorite_smooth\"] replace stone[\"stone_type\"=\"andesite\"]\r"},
+                {"execute @e[type=zombie] ~ ~ ~ summon lightning_bolt", "execute as @e[type=zombie] at @s run summon lightning_bolt"},
+                {"say hello", "say hello"},
+                {"testforblock ~~~ stone 3", R"(testforblock ~~~ stone["stone_type"="diorite"])"},
         };
-        for (const auto &item: oldCommands) {
-            SPDLOG_INFO("{}", styled(utf8::utf16to8(item), fg(fmt::color::red)));
-            SPDLOG_INFO("{}", styled(utf8::utf16to8(Old2New::old2new(blockFixData, item)), fg(fmt::color::lime_green)));
+        std::string input;
+        std::string expected;
+        size_t expectedChangedLineCount = 0;
+        for (size_t i = 0; i < 100; ++i) {
+            for (const auto &[oldCommand, newCommand]: commands) {
+                if (oldCommand != newCommand) {
+                    ++expectedChangedLineCount;
+                }
+                input.append(oldCommand).push_back('\n');
+                expected.append(newCommand).push_back('\n');
+            }
+        }
+        EXPECT_EQ(expectedChangedLineCount, 400U);
+        // 最后一行没有换行符
+        input.pop_back();
+        expected.pop_back();
+        for (size_t threadCount = 1; threadCount <= 4; ++threadCount) {
+            std::istringstream iss(input);
+            std::ostringstream oss;
+            Old2New::BatchResult result = Old2New::old2newStream(blockFixData, iss, oss, threadCount, 37);
+            EXPECT_EQ(oss.str(), expected);
+            EXPECT_EQ(result.lineCount, 100 * commands.size());
+            EXPECT_EQ(result.changedLineCount, expectedChangedLineCount);
+            EXPECT_EQ(result.byteCount, input.size());
+        }
+        std::string line = "setblock ~~~ stone 3";
+        EXPECT_TRUE(Old2New::old2newLine(blockFixData, line));
+        EXPECT_EQ(line, R"(setblock ~~~ stone["stone_type"="diorite"])");
+        // 无法转换的行不能清空调用者记录的调用栈
+        CHelper::Profile::clear();
+        CHelper::Profile::push("converting lines");
+        std::string invalidLine = "setblock ~~~ stone 3 \xff";
+        EXPECT_FALSE(Old2New::old2newLine(blockFixData, invalidLine));
+        EXPECT_EQ(invalidLine, "setblock ~~~ stone 3 \xff");
+        ASSERT_EQ(CHelper::Profile::stack.size(), 1U);
+        EXPECT_EQ(CHelper::Profile::stack.back(), "converting lines");
+        CHelper::Profile::pop();
+    }
+
+    TEST(Old2NewTest, Old2NewDirectory) {
+        std::filesystem::path resourceDir(RESOURCE_DIR);
+        Old2New::BlockFixData blockFixData =
+                Old2New::blockFixDataFromJson(serialization::get_json_from_file(
+                        resourceDir / "resources" / "old2new" / "blockFixData.json"));
+        std::filesystem::path input = std::filesystem::temp_directory_path() / "chelper-old2new-directory-test";
+        std::filesystem::remove_all(input);
+        std::filesystem::create_directories(input / "functions");
+        std::ofstream(input / "functions" / "a.mcfunction", std::ios::binary) << "setblock ~~~ stone 3\nsay hello";
+        std::ofstream(input / "manifest.json", std::ios::binary) << "{}";
+        // 输出文件夹在输入文件夹中，第二次转换时不会读取第一次输出的文件
+        std::filesystem::path output = input / "converted";
+        for (size_t i = 0; i < 2; ++i) {
+            Old2New::BatchResult result = Old2New::old2newDirectory(blockFixData, input, output, 2);
+            EXPECT_EQ(result.fileCount, 1U);
+            EXPECT_EQ(result.changedLineCount, 1U);
+        }
+        EXPECT_FALSE(std::filesystem::exists(output / "converted"));
+        EXPECT_TRUE(std::filesystem::exists(output / "manifest.json"));
+        std::ifstream istream(output / "functions" / "a.mcfunction", std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(istream)), std::istreambuf_iterator<char>());
+        istream.close();
+        EXPECT_EQ(content, utf8::utf16to8(Old2New::old2new(blockFixData, u"setblock ~~~ stone 3")) + "\nsay hello");
+        // 临时文件都已经删除
+        for (const auto &file: std::filesystem::recursive_directory_iterator(input)) {
+            EXPECT_NE(file.path().extension(), ".tmp") << file.path().string();
         }
+        std::filesystem::remove_all(input);
     }
 
 }// namespace CHelper::Test
\ No newline at end of file
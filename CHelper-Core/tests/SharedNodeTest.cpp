@@ -0,0 +1,66 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/parser/Parser.h>
+#include <gtest/gtest.h>
+
+namespace CHelper::Test {
+
+    TEST(SharedNodeTest, ShareIdenticalNodes) {
+        std::filesystem::path resourceDir(RESOURCE_DIR);
+        std::unique_ptr<CPack> cpack = CPack::createByDirectory(resourceDir / "resources" / "beta" / "vanilla");
+        size_t sharedNodeCount = 0;
+        for (const auto &command: *cpack->commands) {
+            sharedNodeCount += command.sharedNodes.size();
+            // 命令中的每个节点要么属于这条命令，要么是共用的节点
+            for (const auto &wrappedNode: command.wrappedNodes) {
+                auto isSameNode = [&wrappedNode](const Node::NodeWithType &node) {
+                    return node.data == wrappedNode.innerNode.data;
+                };
+                EXPECT_TRUE(std::ranges::any_of(command.nodes.nodes, isSameNode) || std::ranges::any_of(command.sharedNodes, isSameNode))
+                        << utf8::utf16to8(command.name[0]);
+            }
+        }
+        EXPECT_GT(sharedNodeCount, 0);
+        // 写入二进制资源包时共用的节点也要写入，每条命令可以单独加载
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "chelper-shared-node-test.cpack";
+        cpack->writeBinToFile(path);
+        std::ifstream istream(path, std::ios::binary);
+        std::unique_ptr<CPack> binaryCPack = CPack::createByBinary(istream);
+        istream.close();
+        std::filesystem::remove(path);
+        ASSERT_EQ(binaryCPack->commands->size(), cpack->commands->size());
+        // 延迟加载的命令解析时和已经加载的命令去重，全部加载后共用的节点数量和直接加载时相同
+        size_t binarySharedNodeCount = 0;
+        for (size_t i = 0; i < cpack->commands->size(); ++i) {
+            const auto &command = (*cpack->commands)[i];
+            const auto &binaryCommand = (*binaryCPack->commands)[i];
+            EXPECT_FALSE(binaryCommand.isLoaded()) << utf8::utf16to8(command.name[0]);
+            binaryCommand.load();
+            binarySharedNodeCount += binaryCommand.sharedNodes.size();
+            EXPECT_EQ(binaryCommand.nodes.nodes.size() + binaryCommand.sharedNodes.size(), command.nodes.nodes.size() + command.sharedNodes.size())
+                    << utf8::utf16to8(command.name[0]);
+            EXPECT_EQ(binaryCommand.wrappedNodes.size(), command.wrappedNodes.size()) << utf8::utf16to8(command.name[0]);
+        }
+        EXPECT_EQ(binarySharedNodeCount, sharedNodeCount);
+        for (const auto &content: {u"execute as @a at @s run tp @s ~ ~1 ~", u"give @s apple 1", u"setblock ~~~ stone"}) {
+            EXPECT_EQ(Parser::parse(content, *cpack).isError(), Parser::parse(content, *binaryCPack).isError());
+        }
+    }
+
+}// namespace CHelper::Test
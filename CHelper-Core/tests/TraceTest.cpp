@@ -0,0 +1,106 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chelper/CHelperCore.h>
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+namespace CHelper::Test {
+
+    static std::unordered_map<std::string, size_t> getEventCounts(const rapidjson::Document &document) {
+        std::unordered_map<std::string, size_t> result;
+        for (const auto &event: document["traceEvents"].GetArray()) {
+            EXPECT_STREQ(event["ph"].GetString(), "X");
+            EXPECT_GE(event["dur"].GetDouble(), 0);
+            result[event["name"].GetString()]++;
+        }
+        return result;
+    }
+
+    TEST(TraceTest, RingBuffer) {
+        Trace::setEnabled(true);
+        Trace::clear();
+        Trace::setBufferCapacity(4);
+        // 新线程使用新的缓冲区，线程结束以后事件仍然保留
+        std::thread([] {
+            for (int64_t i = 0; i < 10; ++i) {
+                Trace::Span span("ring buffer", "index", i);
+            }
+            Trace::Span span("open span", "content", std::u16string_view(u"give @s apple"));
+            EXPECT_EQ(Trace::Span::getOpenSpans(), "open span (content: give @s apple)");
+        }).join();
+        Trace::setBufferCapacity(1 << 14);
+        rapidjson::Document document;
+        document.Parse(Trace::toChromeTraceJson().c_str());
+        ASSERT_FALSE(document.HasParseError());
+        std::vector<int64_t> indexes;
+        for (const auto &event: document["traceEvents"].GetArray()) {
+            if (std::string_view(event["name"].GetString()) == "ring buffer") {
+                indexes.push_back(event["args"]["index"].GetInt64());
+            }
+        }
+        // 写满以后只保留最新的事件
+        EXPECT_EQ(indexes, (std::vector<int64_t>{7, 8, 9}));
+        EXPECT_EQ(getEventCounts(document)["open span"], 1);
+        Trace::clear();
+        document.Parse(Trace::toChromeTraceJson().c_str());
+        EXPECT_TRUE(document["traceEvents"].GetArray().Empty());
+        Trace::setEnabled(false);
+    }
+
+    TEST(TraceTest, ChromeTrace) {
+        Trace::setEnabled(true);
+        Trace::clear();
+        std::filesystem::path resourceDir(RESOURCE_DIR);
+        std::unique_ptr<CHelperCore> core(CHelperCore::createByDirectory(resourceDir / "resources" / "beta" / "vanilla"));
+        ASSERT_NE(core, nullptr);
+        for (const auto &command: {u"g", u"gi", u"give", u"give @s apple"}) {
+            core->onTextChanged(command, std::char_traits<char16_t>::length(command));
+            core->getSuggestions();
+            core->getErrorReasons();
+            core->getSyntaxResult();
+        }
+        Trace::setEnabled(false);
+        rapidjson::Document document;
+        document.Parse(Trace::toChromeTraceJson().c_str());
+        ASSERT_FALSE(document.HasParseError());
+        auto eventCounts = getEventCounts(document);
+#ifdef CHELPER_TRACE
+        // 资源包加载的各个阶段
+        EXPECT_EQ(eventCounts["start load CPack by DIRECTORY: {}"], 1);
+        EXPECT_GE(eventCounts["loading manifest"], 1);
+        EXPECT_GE(eventCounts["loading commands"], 1);
+        EXPECT_GE(eventCounts["init cpack"], 1);
+        // 每次输入的各个阶段
+        EXPECT_EQ(eventCounts["CHelperCore::onTextChanged"], 4);
+        EXPECT_EQ(eventCounts["CHelperCore::getSuggestions"], 4);
+        EXPECT_EQ(eventCounts["CHelperCore::getErrorReasons"], 4);
+        EXPECT_EQ(eventCounts["CHelperCore::getSyntaxResult"], 4);
+        EXPECT_GE(eventCounts["lex"], 4);
+        EXPECT_GT(eventCounts["parse"], 0);
+        EXPECT_GT(eventCounts["lint"], 0);
+        EXPECT_GT(eventCounts["collect suggestions"], 0);
+        EXPECT_GT(eventCounts["collect syntax result"], 0);
+#else
+        // 没有开启时不记录
+        EXPECT_TRUE(eventCounts.empty());
+#endif
+        Trace::clear();
+    }
+
+}// namespace CHelper::Test
@@ -0,0 +1,179 @@
+/**
+ * It is part of CHelper. CHelper is a command helper for Minecraft Bedrock Edition.
+ * Copyright (C) 2026  Yancey
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * C接口的测试程序，只使用C语言编写，保证头文件可以被C编译器使用
+ *
+ * 可以通过CHELPER_ENABLE_ASAN在AddressSanitizer下运行
+ */
+
+#include "chelper.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int failCount = 0;
+
+#define CHECK(condition)                                                      \
+    do {                                                                      \
+        if (!(condition)) {                                                   \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, \
+                    #condition);                                              \
+            failCount++;                                                      \
+        }                                                                     \
+    } while (0)
+
+/**
+ * 把ASCII字符串转为UTF-16，返回的内存需要调用者释放
+ */
+static uint16_t *toUtf16(const char *str, size_t *length) {
+    size_t size = strlen(str);
+    uint16_t *result = malloc((size + 1) * sizeof(uint16_t));
+    for (size_t i = 0; i <= size; i++) {
+        result[i] = (uint16_t) (unsigned char) str[i];
+    }
+    *length = size;
+    return result;
+}
+
+static int equalsAscii(const uint16_t *str, size_t length, const char *expected) {
+    if (strlen(expected) != length) {
+        return 0;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (str[i] != (uint16_t) (unsigned char) expected[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int startsWithAscii(const uint16_t *str, size_t length, const char *expected) {
+    size_t size = strlen(expected);
+    return size <= length && equalsAscii(str, size, expected);
+}
+
+static void setText(chelper_session *session, const char *text) {
+    size_t length;
+    uint16_t *str = toUtf16(text, &length);
+    CHECK(chelper_session_set_text(session, str, length, length));
+    free(str);
+}
+
+static void testInvalidArguments(void) {
+    uint8_t garbage[] = {1, 2, 3, 4};
+    CHECK(chelper_cpack_load_binary(garbage, sizeof(garbage)) == NULL);
+    CHECK(chelper_cpack_load_binary(NULL, 4) == NULL);
+    CHECK(chelper_cpack_load_file(NULL) == NULL);
+    CHECK(chelper_cpack_load_file(RESOURCE_DIR "/not_exist.cpack") == NULL);
+    CHECK(chelper_session_create(NULL) == NULL);
+    CHECK(chelper_session_get_structure(NULL, NULL, 0) == CHELPER_NPOS);
+    CHECK(chelper_session_get_suggestion_count(NULL) == CHELPER_NPOS);
+    CHECK(!chelper_session_set_text(NULL, NULL, 0, 0));
+    CHECK(!chelper_session_click_suggestion(NULL, 0));
+    chelper_cpack_release(NULL);
+    chelper_session_release(NULL);
+}
+
+static void testSession(chelper_session *session) {
+    setText(session, "give @s app");
+    // 先获取长度，再获取内容
+    size_t length = chelper_session_get_structure(session, NULL, 0);
+    CHECK(length != CHELPER_NPOS && length > 0);
+    uint16_t *structure = malloc((length + 1) * sizeof(uint16_t));
+    structure[length] = 0xFFFF;
+    CHECK(chelper_session_get_structure(session, structure, length) == length);
+    CHECK(startsWithAscii(structure, length, "give"));
+    CHECK(structure[length] == 0xFFFF);
+    // 缓冲区不够大时只写入前capacity个
+    uint16_t small[2] = {0xFFFF, 0xFFFF};
+    CHECK(chelper_session_get_structure(session, small, 1) == length);
+    CHECK(small[0] == structure[0] && small[1] == 0xFFFF);
+    free(structure);
+
+    CHECK(chelper_session_get_param_hint(session, NULL, 0) != CHELPER_NPOS);
+    CHECK(chelper_session_get_syntax_tokens(session, NULL, 0) == strlen("give @s app"));
+
+    // 补全提示
+    size_t suggestionCount = chelper_session_get_suggestion_count(session);
+    CHECK(suggestionCount != CHELPER_NPOS && suggestionCount > 0);
+    CHECK(chelper_session_get_suggestion_name(session, suggestionCount, NULL, 0) == CHELPER_NPOS);
+    size_t apple = CHELPER_NPOS;
+    uint16_t name[64];
+    for (size_t i = 0; i < suggestionCount; i++) {
+        size_t nameLength = chelper_session_get_suggestion_name(session, i, name, 64);
+        CHECK(nameLength != CHELPER_NPOS);
+        CHECK(chelper_session_get_suggestion_description(session, i, NULL, 0) != CHELPER_NPOS);
+        if (nameLength <= 64 && equalsAscii(name, nameLength, "apple")) {
+            apple = i;
+        }
+    }
+    CHECK(apple != CHELPER_NPOS);
+    if (apple == CHELPER_NPOS) {
+        return;
+    }
+
+    // 使用补全提示后文本改变
+    CHECK(chelper_session_click_suggestion(session, apple));
+    uint16_t text[64];
+    size_t textLength = chelper_session_get_text(session, text, 64);
+    CHECK(textLength <= 64 && startsWithAscii(text, textLength, "give @s apple"));
+    CHECK(chelper_session_get_cursor(session) == textLength);
+    CHECK(chelper_session_get_error_count(session) == 0);
+
+    // 错误
+    setText(session, "give @s apple a");
+    size_t errorCount = chelper_session_get_error_count(session);
+    CHECK(errorCount != CHELPER_NPOS && errorCount > 0);
+    size_t start = CHELPER_NPOS;
+    size_t end = CHELPER_NPOS;
+    CHECK(chelper_session_get_error(session, 0, &start, &end, NULL, 0) > 0);
+    CHECK(start <= end && end <= strlen("give @s apple a"));
+    CHECK(chelper_session_get_error(session, errorCount, NULL, NULL, NULL, 0) == CHELPER_NPOS);
+
+    CHECK(chelper_session_set_cursor(session, 0));
+    CHECK(chelper_session_get_cursor(session) == 0);
+}
+
+int main(void) {
+    CHECK(chelper_api_version() == CHELPER_API_VERSION);
+    testInvalidArguments();
+    chelper_cpack *cpack = chelper_cpack_load_file(RESOURCE_DIR "/resources/beta/vanilla");
+    CHECK(cpack != NULL);
+    if (cpack == NULL) {
+        return 1;
+    }
+    // 多个会话共享同一个资源包，释放资源包后会话仍然可以使用
+    chelper_session *session1 = chelper_session_create(cpack);
+    chelper_session *session2 = chelper_session_create(cpack);
+    chelper_cpack_release(cpack);
+    CHECK(session1 != NULL && session2 != NULL);
+    if (session1 != NULL && session2 != NULL) {
+        testSession(session1);
+        testSession(session2);
+    }
+    chelper_session_release(session1);
+    chelper_session_release(session2);
+    if (failCount != 0) {
+        fprintf(stderr, "%d checks failed\n", failCount);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
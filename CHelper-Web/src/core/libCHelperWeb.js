@@ -2,6 +2,108 @@ import wasmUrl from '@/assets/libCHelperWeb.wasm?url'
 
 var Module=typeof Module!="undefined"?Module:{};var ENVIRONMENT_IS_WEB=true;var ENVIRONMENT_IS_WORKER=false;var programArgs=[];var thisProgram="./this.program";var _scriptName=globalThis.document?.currentScript?.src;var scriptDirectory="";function locateFile(path){if(Module["locateFile"]){return Module["locateFile"](path,scriptDirectory)}return scriptDirectory+path}var readAsync,readBinary;if(ENVIRONMENT_IS_WEB||ENVIRONMENT_IS_WORKER){try{scriptDirectory=new URL(".",_scriptName).href}catch{}{readAsync=async url=>{var response=await fetch(url,{credentials:"same-origin"});if(response.ok){return response.arrayBuffer()}throw new Error(response.status+" : "+response.url)}}}else{}var out=console.log.bind(console);var err=console.error.bind(console);var wasmBinary;var ABORT=false;class EmscriptenEH{}class EmscriptenSjLj extends EmscriptenEH{}var runtimeInitialized=false;function getMemoryBuffer(){return wasmMemory.buffer}function updateMemoryViews(){if(HEAP8?.buffer?.resizable)return;var b=getMemoryBuffer();HEAP8=new Int8Array(b);HEAP16=new Int16Array(b);HEAPU8=new Uint8Array(b);HEAPU16=new Uint16Array(b);HEAP32=new Int32Array(b);HEAPU32=new Uint32Array(b);HEAPF32=new Float32Array(b);HEAPF64=new Float64Array(b);HEAP64=new BigInt64Array(b);HEAPU64=new BigUint64Array(b)}function preRun(){var preRun=Module["preRun"];if(preRun){if(typeof preRun=="function")preRun=[preRun];onPreRuns.push(...preRun)}callRuntimeCallbacks(onPreRuns)}function initRuntime(){runtimeInitialized=true;wasmExports["g"]()}function postRun(){var postRun=Module["postRun"];if(postRun){if(typeof postRun=="function")postRun=[postRun];onPostRuns.push(...postRun)}callRuntimeCallbacks(onPostRuns)}function abort(what){Module["onAbort"]?.(what);what=`Aborted(${what})`;err(what);ABORT=true;what+=". Build with -sASSERTIONS for more info.";var e=new WebAssembly.RuntimeError(what);throw e}var wasmBinaryFile;function findWasmBinary(){return wasmUrl;}function getBinarySync(file){if(readBinary){return readBinary(file)}throw"both async and sync fetching of the wasm failed"}async function getWasmBinary(binaryFile){if(!wasmBinary){try{var response=await readAsync(binaryFile);return new Uint8Array(response)}catch{}}return getBinarySync(binaryFile)}async function instantiateArrayBuffer(binaryFile,imports){try{var binary=await getWasmBinary(binaryFile);var instance=await WebAssembly.instantiate(binary,imports);return instance}catch(reason){err(`failed to asynchronously prepare wasm: ${reason}`);abort(reason)}}async function instantiateAsync(binary,binaryFile,imports){if(!binary){try{var response=fetch(binaryFile,{credentials:"same-origin"});var instantiationResult=await WebAssembly.instantiateStreaming(response,imports);return instantiationResult}catch(reason){err(`wasm streaming compile failed: ${reason}`);err("falling back to ArrayBuffer instantiation")}}return instantiateArrayBuffer(binaryFile,imports)}function getWasmImports(){var imports={a:wasmImports};return imports}async function createWasm(){function receiveInstance(instance){wasmExports=instance.exports;assignWasmExports(wasmExports);updateMemoryViews();return wasmExports}function receiveInstantiationResult(result){return receiveInstance(result["instance"])}var info=getWasmImports();var instantiateWasm=Module["instantiateWasm"];if(instantiateWasm){return new Promise(resolve=>{instantiateWasm(info,inst=>resolve(receiveInstance(inst)))})}wasmBinaryFile??=findWasmBinary();var result=await instantiateAsync(wasmBinary,wasmBinaryFile,info);var exports=receiveInstantiationResult(result);return exports}class ExitStatus{name="ExitStatus";constructor(status){this.message=`Program terminated with exit(${status})`;this.status=status}}var HEAP16;var HEAP32;var HEAP64;var HEAP8;var HEAPF32;var HEAPF64;var HEAPU16;var HEAPU32;var HEAPU64;var HEAPU8;var callRuntimeCallbacks=callbacks=>{while(callbacks.length>0){callbacks.shift()(Module)}};var onPostRuns=[];var onPreRuns=[];var noExitRuntime=true;class ExceptionInfo{constructor(excPtr){this.excPtr=excPtr;this.ptr=excPtr-24}set_type(type){HEAPU32[this.ptr+4>>2]=type}get_type(){return HEAPU32[this.ptr+4>>2]}set_destructor(destructor){HEAPU32[this.ptr+8>>2]=destructor}get_destructor(){return HEAPU32[this.ptr+8>>2]}set_caught(caught){caught=caught?1:0;HEAP8[this.ptr+12]=caught}get_caught(){return HEAP8[this.ptr+12]!=0}set_rethrown(rethrown){rethrown=rethrown?1:0;HEAP8[this.ptr+13]=rethrown}get_rethrown(){return HEAP8[this.ptr+13]!=0}init(type,destructor){this.set_adjusted_ptr(0);this.set_type(type);this.set_destructor(destructor)}set_adjusted_ptr(adjustedPtr){HEAPU32[this.ptr+16>>2]=adjustedPtr}get_adjusted_ptr(){return HEAPU32[this.ptr+16>>2]}}var uncaughtExceptionCount=0;var ___cxa_throw=(ptr,type,destructor)=>{var info=new ExceptionInfo(ptr);info.init(type,destructor);uncaughtExceptionCount++;abort()};var __abort_js=()=>abort("");var stringToUTF8Array=(str,heap,outIdx,maxBytesToWrite)=>{if(!(maxBytesToWrite>0))return 0;var startIdx=outIdx;var endIdx=outIdx+maxBytesToWrite-1;for(var i=0;i<str.length;++i){var u=str.codePointAt(i);if(u<=127){if(outIdx>=endIdx)break;heap[outIdx++]=u}else if(u<=2047){if(outIdx+1>=endIdx)break;heap[outIdx++]=192|u>>6;heap[outIdx++]=128|u&63}else if(u<=65535){if(outIdx+2>=endIdx)break;heap[outIdx++]=224|u>>12;heap[outIdx++]=128|u>>6&63;heap[outIdx++]=128|u&63}else{if(outIdx+3>=endIdx)break;heap[outIdx++]=240|u>>18;heap[outIdx++]=128|u>>12&63;heap[outIdx++]=128|u>>6&63;heap[outIdx++]=128|u&63;i++}}heap[outIdx]=0;return outIdx-startIdx};var stringToUTF8=(str,outPtr,maxBytesToWrite)=>stringToUTF8Array(str,HEAPU8,outPtr,maxBytesToWrite);var getHeapMax=()=>2147483648;var alignMemory=(size,alignment)=>Math.ceil(size/alignment)*alignment;var growMemory=size=>{var oldHeapSize=wasmMemory.buffer.byteLength;var pages=(size-oldHeapSize+65535)/65536|0;try{wasmMemory.grow(pages);updateMemoryViews();return 1}catch(e){}};var _emscripten_resize_heap=requestedSize=>{var oldSize=HEAPU8.length;requestedSize>>>=0;var maxHeapSize=getHeapMax();if(requestedSize>maxHeapSize){return false}for(var cutDown=1;cutDown<=4;cutDown*=2){var overGrownHeapSize=oldSize*(1+.2/cutDown);overGrownHeapSize=Math.min(overGrownHeapSize,requestedSize+100663296);var newSize=Math.min(maxHeapSize,alignMemory(Math.max(requestedSize,overGrownHeapSize),65536));var replacement=growMemory(newSize);if(replacement){return true}}return false};var ENV={};var getExecutableName=()=>thisProgram;var getEnvStrings=()=>{if(!getEnvStrings.strings){var lang=(globalThis.navigator?.language??"C").replace("-","_")+".UTF-8";var env={USER:"web_user",LOGNAME:"web_user",PATH:"/",PWD:"/",HOME:"/home/web_user",LANG:lang,_:getExecutableName()};for(var x in ENV){if(ENV[x]===undefined)delete env[x];else env[x]=ENV[x]}var strings=[];for(var x in env){strings.push(`${x}=${env[x]}`)}getEnvStrings.strings=strings}return getEnvStrings.strings};var _environ_get=(__environ,environ_buf)=>{var bufSize=0;var envp=0;for(var string of getEnvStrings()){var ptr=environ_buf+bufSize;HEAPU32[__environ+envp>>2]=ptr;bufSize+=stringToUTF8(string,ptr,Infinity)+1;envp+=4}return 0};var lengthBytesUTF8=str=>{var len=0;for(var i=0;i<str.length;++i){var c=str.charCodeAt(i);if(c<=127){len++}else if(c<=2047){len+=2}else if(c>=55296&&c<=57343){len+=4;++i}else{len+=3}}return len};var _environ_sizes_get=(penviron_count,penviron_buf_size)=>{var strings=getEnvStrings();HEAPU32[penviron_count>>2]=strings.length;var bufSize=0;for(var string of strings){bufSize+=lengthBytesUTF8(string)+1}HEAPU32[penviron_buf_size>>2]=bufSize;return 0};{if(Module["noExitRuntime"])noExitRuntime=Module["noExitRuntime"];if(Module["print"])out=Module["print"];if(Module["printErr"])err=Module["printErr"];if(Module["arguments"])programArgs=Module["arguments"];if(Module["thisProgram"])thisProgram=Module["thisProgram"];var preInit=Module["preInit"];if(preInit){if(typeof preInit=="function")Module["preInit"]=preInit=[preInit];while(preInit.length>0){preInit.shift()()}}}var _init,_release,_onTextChanged,_onSelectionChanged,_getStructure,_getParamHint,_getErrorReasons,_getSuggestionSize,_getSuggestion,_getAllSuggestions,_onSuggestionClick,_getSyntaxTokens,_malloc,_free,memory,__indirect_function_table,wasmMemory;function assignWasmExports(wasmExports){_init=Module["_init"]=wasmExports["h"];_release=Module["_release"]=wasmExports["i"];_onTextChanged=Module["_onTextChanged"]=wasmExports["j"];_onSelectionChanged=Module["_onSelectionChanged"]=wasmExports["k"];_getStructure=Module["_getStructure"]=wasmExports["l"];_getParamHint=Module["_getParamHint"]=wasmExports["m"];_getErrorReasons=Module["_getErrorReasons"]=wasmExports["n"];_getSuggestionSize=Module["_getSuggestionSize"]=wasmExports["o"];_getSuggestion=Module["_getSuggestion"]=wasmExports["p"];_getAllSuggestions=Module["_getAllSuggestions"]=wasmExports["q"];_onSuggestionClick=Module["_onSuggestionClick"]=wasmExports["r"];_getSyntaxTokens=Module["_getSyntaxTokens"]=wasmExports["s"];_malloc=Module["_malloc"]=wasmExports["t"];_free=Module["_free"]=wasmExports["u"];memory=wasmMemory=wasmExports["f"];__indirect_function_table=wasmExports["__indirect_function_table"]}var wasmImports={a:___cxa_throw,e:__abort_js,d:_emscripten_resize_heap,b:_environ_get,c:_environ_sizes_get};async function run(){preRun();var setStatus=Module["setStatus"];if(setStatus){setStatus("Running...");await new Promise(resolve=>setTimeout(resolve,1));setTimeout(setStatus,1,"")}if(ABORT)return;initRuntime();Module["onRuntimeInitialized"]?.();postRun()}var wasmExports;export var createWasmFuture = createWasm().then(()=>run());
 
+// 和c++中的AnalysisFlag一致
+export const AnalysisFlag = {
+  STRUCTURE: 1 << 0,
+  PARAM_HINT: 1 << 1,
+  ERROR_REASONS: 1 << 2,
+  SUGGESTIONS: 1 << 3,
+  SYNTAX_TOKENS: 1 << 4,
+  ALL: (1 << 5) - 1,
+}
+
+const ANALYSIS_VERSION = 1
+const ERROR_REASON_WORD_COUNT = 4
+const SUGGESTION_WORD_COUNT = 4
+const utf16Decoder = new TextDecoder('utf-16le')
+
+function allocString(content) {
+  const ptr = _malloc((content.length + 1) * 2)
+  const start = ptr / 2
+  const end = start + content.length
+  let i = start
+  while (i < end) {
+    HEAPU16[i] = content.charCodeAt(i - start)
+    ++i
+  }
+  HEAPU16[i] = 0
+  return ptr
+}
+
+/**
+ * 补全建议列表，使用get获取某一个补全建议时才读取内容
+ *
+ * 列表只能在这个内核下一次分析之前使用
+ */
+export class SuggestionList {
+  static EMPTY = new SuggestionList(0, null)
+
+  constructor(length, getSuggestion) {
+    this.length = length
+    this._getSuggestion = getSuggestion
+  }
+
+  get(which) {
+    return this._getSuggestion(which)
+  }
+}
+
+/**
+ * 读取AnalysisBuffer，格式见c++中的AnalysisBuffer
+ *
+ * 补全建议只记录位置，显示时才读取，其它结果都会复制出来
+ */
+function decodeAnalysis(ptr) {
+  // 每次都重新获取视图，内存增长之后旧的视图会失效
+  const words = HEAPU32.subarray(ptr >> 2, (ptr + HEAPU32[(ptr >> 2) + 2]) >> 2)
+  if (words[0] !== ANALYSIS_VERSION) {
+    throw `unsupported analysis buffer version: ${words[0]}`
+  }
+  const readString = (offset, length) =>
+    utf16Decoder.decode(HEAPU16.subarray((ptr + offset) >> 1, ((ptr + offset) >> 1) + length))
+  const sectionOffset = (section) => words[4 + 2 * section] >> 2
+  const isRequested = (section) => (words[1] & (1 << section)) !== 0
+  const result = {}
+  if (isRequested(0)) {
+    const index = sectionOffset(0)
+    result.structure = readString((index + 1) << 2, words[index])
+  }
+  if (isRequested(1)) {
+    const index = sectionOffset(1)
+    result.paramHint = readString((index + 1) << 2, words[index])
+  }
+  if (isRequested(2)) {
+    let index = sectionOffset(2)
+    const count = words[index++]
+    result.errorReasons = new Array(count)
+    for (let i = 0; i < count; i++, index += ERROR_REASON_WORD_COUNT) {
+      result.errorReasons[i] = {
+        start: words[index],
+        end: words[index + 1],
+        errorReason: readString(words[index + 2], words[index + 3]),
+      }
+    }
+  }
+  if (isRequested(3)) {
+    const index = (ptr >> 2) + sectionOffset(3)
+    result.suggestions = new SuggestionList(words[sectionOffset(3)], (which) => {
+      // 读取时重新获取视图，内存可能已经增长
+      const start = index + 1 + which * SUGGESTION_WORD_COUNT
+      return {
+        id: which,
+        title: readString(HEAPU32[start], HEAPU32[start + 1]),
+        description: readString(HEAPU32[start + 2], HEAPU32[start + 3]),
+      }
+    })
+  }
+  if (isRequested(4)) {
+    const index = sectionOffset(4)
+    const start = ptr + ((index + 1) << 2)
+    result.syntaxTokens = Array.from(HEAPU8.subarray(start, start + words[index]))
+  }
+  return result
+}
+
 export class CHelperCore {
   constructor(cpack) {
     const cpackPtr = _malloc(cpack.byteLength)
@@ -19,15 +121,7 @@ export class CHelperCore {
   }
 
   onTextChanged(content, index) {
-    const ptr = _malloc((content.length + 1) * 2)
-    const start = ptr / 2
-    const end = start + content.length
-    let i = start
-    while (i < end) {
-      HEAPU16[i] = content.charCodeAt(i - start)
-      ++i
-    }
-    HEAPU16[i] = 0
+    const ptr = allocString(content)
     _onTextChanged(this._corePtr, ptr, index)
     _free(ptr)
   }
@@ -200,4 +294,45 @@ export class CHelperCore {
     }
     return syntaxTokens
   }
+
+  /**
+   * 更新输入并一次性获取flags中请求的所有结果
+   */
+  analyze(content, index, flags = AnalysisFlag.ALL) {
+    if (Module['_analyze'] === undefined) {
+      // 旧版本的wasm没有导出analyze，逐个获取结果
+      return this._analyzeByFields(content, index, flags)
+    }
+    const contentPtr = allocString(content)
+    const ptr = Module['_analyze'](this._corePtr, contentPtr, index, flags)
+    _free(contentPtr)
+    if (ptr === 0) {
+      return null
+    }
+    return decodeAnalysis(ptr)
+  }
+
+  _analyzeByFields(content, index, flags) {
+    this.onTextChanged(content, index)
+    const result = {}
+    if (flags & AnalysisFlag.STRUCTURE) {
+      result.structure = this.getStructure()
+    }
+    if (flags & AnalysisFlag.PARAM_HINT) {
+      result.paramHint = this.getParamHint()
+    }
+    if (flags & AnalysisFlag.ERROR_REASONS) {
+      result.errorReasons = this.getErrorReasons()
+    }
+    if (flags & AnalysisFlag.SUGGESTIONS) {
+      // 补全建议很多，显示时才逐个获取
+      result.suggestions = new SuggestionList(this.getSuggestionSize(), (which) =>
+        this.getSuggestion(which),
+      )
+    }
+    if (flags & AnalysisFlag.SYNTAX_TOKENS) {
+      result.syntaxTokens = this.getSyntaxTokens()
+    }
+    return result
+  }
 }
@@ -64,7 +64,7 @@ def build_web_core(toolchain_dir: str):
             "-s",
             'ENVIRONMENT=["web"]',
             "-s",
-            "EXPORTED_FUNCTIONS=['_init','_release','_onTextChanged','_onSelectionChanged','_getParamHint','_getErrorReasons','_getSuggestionSize','_getSuggestion','_getAllSuggestions','_onSuggestionClick','_getSyntaxTokens','_malloc','_free']",
+            "EXPORTED_FUNCTIONS=['_init','_release','_analyze','_onTextChanged','_onSelectionChanged','_getStructure','_getParamHint','_getErrorReasons','_getSuggestionSize','_getSuggestion','_getAllSuggestions','_onSuggestionClick','_getSyntaxTokens','_malloc','_free']",
             "-s",
             "WASM=1",
             "-s",
@@ -89,6 +89,108 @@ def build_web_core(toolchain_dir: str):
             "var wasmExports;export var createWasmFuture = createWasm()",
         )
         content += """
+// 和c++中的AnalysisFlag一致
+export const AnalysisFlag = {
+  STRUCTURE: 1 << 0,
+  PARAM_HINT: 1 << 1,
+  ERROR_REASONS: 1 << 2,
+  SUGGESTIONS: 1 << 3,
+  SYNTAX_TOKENS: 1 << 4,
+  ALL: (1 << 5) - 1,
+}
+
+const ANALYSIS_VERSION = 1
+const ERROR_REASON_WORD_COUNT = 4
+const SUGGESTION_WORD_COUNT = 4
+const utf16Decoder = new TextDecoder('utf-16le')
+
+function allocString(content) {
+  const ptr = _malloc((content.length + 1) * 2)
+  const start = ptr / 2
+  const end = start + content.length
+  let i = start
+  while (i < end) {
+    HEAPU16[i] = content.charCodeAt(i - start)
+    ++i
+  }
+  HEAPU16[i] = 0
+  return ptr
+}
+
+/**
+ * 补全建议列表，使用get获取某一个补全建议时才读取内容
+ *
+ * 列表只能在这个内核下一次分析之前使用
+ */
+export class SuggestionList {
+  static EMPTY = new SuggestionList(0, null)
+
+  constructor(length, getSuggestion) {
+    this.length = length
+    this._getSuggestion = getSuggestion
+  }
+
+  get(which) {
+    return this._getSuggestion(which)
+  }
+}
+
+/**
+ * 读取AnalysisBuffer，格式见c++中的AnalysisBuffer
+ *
+ * 补全建议只记录位置，显示时才读取，其它结果都会复制出来
+ */
+function decodeAnalysis(ptr) {
+  // 每次都重新获取视图，内存增长之后旧的视图会失效
+  const words = HEAPU32.subarray(ptr >> 2, (ptr + HEAPU32[(ptr >> 2) + 2]) >> 2)
+  if (words[0] !== ANALYSIS_VERSION) {
+    throw `unsupported analysis buffer version: ${words[0]}`
+  }
+  const readString = (offset, length) =>
+    utf16Decoder.decode(HEAPU16.subarray((ptr + offset) >> 1, ((ptr + offset) >> 1) + length))
+  const sectionOffset = (section) => words[4 + 2 * section] >> 2
+  const isRequested = (section) => (words[1] & (1 << section)) !== 0
+  const result = {}
+  if (isRequested(0)) {
+    const index = sectionOffset(0)
+    result.structure = readString((index + 1) << 2, words[index])
+  }
+  if (isRequested(1)) {
+    const index = sectionOffset(1)
+    result.paramHint = readString((index + 1) << 2, words[index])
+  }
+  if (isRequested(2)) {
+    let index = sectionOffset(2)
+    const count = words[index++]
+    result.errorReasons = new Array(count)
+    for (let i = 0; i < count; i++, index += ERROR_REASON_WORD_COUNT) {
+      result.errorReasons[i] = {
+        start: words[index],
+        end: words[index + 1],
+        errorReason: readString(words[index + 2], words[index + 3]),
+      }
+    }
+  }
+  if (isRequested(3)) {
+    const index = (ptr >> 2) + sectionOffset(3)
+    result.suggestions = new SuggestionList(words[sectionOffset(3)], (which) => {
+      // 读取时重新获取视图，内存可能已经增长
+      const start = index + 1 + which * SUGGESTION_WORD_COUNT
+      return {
+        id: which,
+        title: readString(HEAPU32[start], HEAPU32[start + 1]),
+        description: readString(HEAPU32[start + 2], HEAPU32[start + 3]),
+      }
+    })
+  }
+  if (isRequested(4)) {
+    const index = sectionOffset(4)
+    const start = ptr + ((index + 1) << 2)
+    result.syntaxTokens = Array.from(HEAPU8.subarray(start, start + words[index]))
+  }
+  return result
+}
+
 export class CHelperCore {
   constructor(cpack) {
     const cpackPtr = _malloc(cpack.byteLength)
@@ -106,15 +208,7 @@ export class CHelperCore {
   }
 
   onTextChanged(content, index) {
-    const ptr = _malloc((content.length + 1) * 2)
-    const start = ptr / 2
-    const end = start + content.length
-    let i = start
-    while (i < end) {
-      HEAPU16[i] = content.charCodeAt(i - start)
-      ++i
-    }
-    HEAPU16[i] = 0
+    const ptr = allocString(content)
     _onTextChanged(this._corePtr, ptr, index)
     _free(ptr)
   }
@@ -287,6 +381,47 @@ export class CHelperCore {
     }
     return syntaxTokens
   }
+
+  /**
+   * 更新输入并一次性获取flags中请求的所有结果
+   */
+  analyze(content, index, flags = AnalysisFlag.ALL) {
+    if (Module['_analyze'] === undefined) {
+      // 旧版本的wasm没有导出analyze，逐个获取结果
+      return this._analyzeByFields(content, index, flags)
+    }
+    const contentPtr = allocString(content)
+    const ptr = Module['_analyze'](this._corePtr, contentPtr, index, flags)
+    _free(contentPtr)
+    if (ptr === 0) {
+      return null
+    }
+    return decodeAnalysis(ptr)
+  }
+
+  _analyzeByFields(content, index, flags) {
+    this.onTextChanged(content, index)
+    const result = {}
+    if (flags & AnalysisFlag.STRUCTURE) {
+      result.structure = this.getStructure()
+    }
+    if (flags & AnalysisFlag.PARAM_HINT) {
+      result.paramHint = this.getParamHint()
+    }
+    if (flags & AnalysisFlag.ERROR_REASONS) {
+      result.errorReasons = this.getErrorReasons()
+    }
+    if (flags & AnalysisFlag.SUGGESTIONS) {
+      // 补全建议很多，显示时才逐个获取
+      result.suggestions = new SuggestionList(this.getSuggestionSize(), (which) =>
+        this.getSuggestion(which),
+      )
+    }
+    if (flags & AnalysisFlag.SYNTAX_TOKENS) {
+      result.syntaxTokens = this.getSyntaxTokens()
+    }
+    return result
+  }
 }
 """
     with open(